@@ -0,0 +1,536 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/IO.h>
+#include <djvAV/Image.h>
+#include <djvAV/ImageConvert.h>
+#include <djvAV/OCIOCPU.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Memory.h>
+#include <djvCore/ResourceSystem.h>
+#include <djvCore/StringFormat.h>
+#include <djvCore/TextSystem.h>
+#include <djvCore/ThreadPool.h>
+#include <djvCore/Timer.h>
+
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace djv;
+
+namespace djv
+{
+    //! This namespace provides functionality for djv_convert.
+    //!
+    //! The conversion is split into three stages that run in parallel:
+    //! - The reader decodes frames into its video queue.
+    //! - The conversion thread pops the decoded frames, converts them on the
+    //!   CPU with jobs on the I/O thread pool, and adds them in order to the
+    //!   writer video queue. Color spaces are converted with the OpenColorIO
+    //!   CPU processor, so no OpenGL context is required.
+    //! - The writer encodes the frames from its video queue.
+    //!
+    //! The stages are connected by the bounded reader and writer video
+    //! queues, so a slow stage applies backpressure to the stages before it.
+    namespace Convert
+    {
+        namespace
+        {
+            const size_t queueSizeDefault = 4;
+
+        } // namespace
+
+        class Application : public CmdLine::Application
+        {
+            DJV_NON_COPYABLE(Application);
+
+        protected:
+            void _init(std::list<std::string>&);
+
+            Application();
+
+        public:
+            ~Application() override;
+
+            static std::shared_ptr<Application> create(std::list<std::string>&);
+
+            void run() override;
+            void tick(const std::chrono::steady_clock::time_point&, const Core::Time::Duration&) override;
+
+        protected:
+            void _parseCmdLine(std::list<std::string>&) override;
+            void _printUsage() override;
+
+        private:
+            void _convert();
+            void _printStats();
+
+            Core::FileSystem::FileInfo _input;
+            Core::FileSystem::FileInfo _output;
+            std::unique_ptr<AV::Image::Size> _resize;
+            std::unique_ptr<AV::Image::Type> _type;
+            std::unique_ptr<AV::OCIO::Convert> _colorSpace;
+            size_t _queueSize = queueSizeDefault;
+            std::unique_ptr<size_t> _threadCount;
+
+            std::shared_ptr<AV::IO::IRead> _read;
+            std::shared_ptr<AV::IO::IWrite> _write;
+            AV::Image::Info _info;
+            size_t _frameCount = 0;
+            std::shared_ptr<AV::Image::Convert> _imageConvert;
+            std::shared_ptr<AV::OCIO::CPUProcessor> _colorProcessor;
+            std::thread _thread;
+            std::atomic<bool> _running;
+            std::atomic<size_t> _frames;
+            std::atomic<size_t> _readByteCount;
+            std::atomic<size_t> _writeByteCount;
+            std::chrono::steady_clock::time_point _startTime;
+            std::shared_ptr<Core::Time::Timer> _statsTimer;
+        };
+
+        void Application::_init(std::list<std::string>& args)
+        {
+            // Only create the I/O systems so that no display is required.
+            CmdLine::Application::_init(args, false);
+
+            _parseCmdLine(args);
+        }
+
+        Application::Application()
+        {
+            _running = false;
+            _frames = 0;
+            _readByteCount = 0;
+            _writeByteCount = 0;
+        }
+
+        Application::~Application()
+        {
+            _running = false;
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+        std::shared_ptr<Application> Application::create(std::list<std::string>& args)
+        {
+            auto out = std::shared_ptr<Application>(new Application);
+            out->_init(args);
+            return out;
+        }
+
+        void Application::run()
+        {
+            auto io = getSystemT<AV::IO::System>();
+            AV::IO::ReadOptions readOptions;
+            readOptions.videoQueueSize = _queueSize;
+            _read = io->read(_input, readOptions);
+            const auto info = _read->getInfo().get();
+            if (!info.video.size())
+            {
+                auto textSystem = getSystemT<Core::TextSystem>();
+                throw std::runtime_error(Core::String::Format("{0}: {1}").
+                    arg(_input.getFileName()).
+                    arg(textSystem->getText(DJV_TEXT("djv_convert_input_video_error"))));
+            }
+            const auto& video = info.video[0];
+            _frameCount = video.sequence.getSize();
+            _info = video.info;
+            _info.layout = AV::Image::Layout();
+            if (_resize)
+            {
+                _info.size = *_resize;
+            }
+            if (_type)
+            {
+                _info.type = *_type;
+            }
+
+            AV::IO::WriteOptions writeOptions;
+            writeOptions.videoQueueSize = _queueSize;
+            AV::IO::Info writeInfo;
+            writeInfo.video.push_back(AV::IO::VideoInfo(_info, video.speed, video.sequence));
+            _write = io->write(_output, writeInfo, writeOptions);
+
+            const size_t threadCount = _threadCount ?
+                std::max(*_threadCount, static_cast<size_t>(1)) :
+                io->getThreadPool()->getThreadCount();
+            _read->setThreadCount(threadCount * 2);
+            _write->setThreadCount(threadCount);
+            _read->setPlayback(true);
+
+            _imageConvert = AV::Image::Convert::create(
+                getSystemT<Core::ResourceSystem>(),
+                AV::Image::ConvertBackend::CPU);
+            if (_colorSpace)
+            {
+                // The frames are already converted in parallel so the
+                // processor does not use the thread pool.
+                _colorProcessor = AV::OCIO::CPUProcessor::create(*_colorSpace);
+            }
+
+            _statsTimer = Core::Time::Timer::create(shared_from_this());
+            _statsTimer->setRepeating(true);
+            _statsTimer->start(
+                Core::Time::getTime(Core::Time::TimerValue::Slow),
+                [this](const std::chrono::steady_clock::time_point&, const Core::Time::Duration&)
+                {
+                    if (_frameCount > 0)
+                    {
+                        std::cout << static_cast<size_t>(_frames / static_cast<float>(_frameCount) * 100.F) << "%" << std::endl;
+                    }
+                });
+
+            _startTime = std::chrono::steady_clock::now();
+            _running = true;
+            _thread = std::thread(
+                [this]
+                {
+                    _convert();
+                });
+
+            CmdLine::Application::run();
+
+            _running = false;
+            _thread.join();
+            _write.reset();
+            _read.reset();
+
+            _printStats();
+        }
+
+        void Application::tick(const std::chrono::steady_clock::time_point& t, const Core::Time::Duration& dt)
+        {
+            CmdLine::Application::tick(t, dt);
+            if (!_running && !_write->isRunning())
+            {
+                exit(_frames < _frameCount ? 1 : 0);
+            }
+        }
+
+        void Application::_parseCmdLine(std::list<std::string>& args)
+        {
+            CmdLine::Application::_parseCmdLine(args);
+            if (0 == getExitCode())
+            {
+                auto textSystem = getSystemT<Core::TextSystem>();
+                auto i = args.begin();
+                while (i != args.end())
+                {
+                    if ("-resize" == *i)
+                    {
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                                arg("-resize").
+                                arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                        }
+                        AV::Image::Size value;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _resize.reset(new AV::Image::Size(value));
+                    }
+                    else if ("-type" == *i)
+                    {
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                                arg("-type").
+                                arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                        }
+                        AV::Image::Type value = AV::Image::Type::None;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _type.reset(new AV::Image::Type(value));
+                    }
+                    else if ("-color_space" == *i)
+                    {
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                                arg("-color_space").
+                                arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                        }
+                        const std::string input = *i;
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                                arg("-color_space").
+                                arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                        }
+                        const std::string output = *i;
+                        i = args.erase(i);
+                        _colorSpace.reset(new AV::OCIO::Convert(input, output));
+                    }
+                    else if ("-queue_size" == *i)
+                    {
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                                arg("-queue_size").
+                                arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                        }
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _queueSize = static_cast<size_t>(std::max(value, 1));
+                    }
+                    else if ("-threads" == *i)
+                    {
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::runtime_error(Core::String::Format("{0}: {1}").
+                                arg("-threads").
+                                arg(textSystem->getText(DJV_TEXT("error_cannot_parse_argument"))));
+                        }
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _threadCount.reset(new size_t(std::max(value, 1)));
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                if (2 == args.size())
+                {
+                    auto io = getSystemT<AV::IO::System>();
+                    _input = Core::FileSystem::FileInfo(args.front());
+                    if (io->canSequence(_input))
+                    {
+                        _input = Core::FileSystem::FileInfo::getFileSequence(_input.getPath(), io->getSequenceExtensions());
+                    }
+                    args.pop_front();
+                    _output = args.front();
+                    _output.evalSequence();
+                    args.pop_front();
+                }
+                else if (!args.size())
+                {
+                    _printUsage();
+                    exit(1);
+                }
+                else
+                {
+                    throw std::runtime_error(textSystem->getText(DJV_TEXT("djv_convert_input_output_error")));
+                }
+            }
+        }
+
+        void Application::_printUsage()
+        {
+            auto textSystem = getSystemT<Core::TextSystem>();
+            std::cout << std::endl;
+            std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_description")) << std::endl;
+            std::cout << std::endl;
+            std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_usage")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_usage_format")) << std::endl;
+            std::cout << std::endl;
+            std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_options")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_resize")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_description_resize")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_type")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_description_type")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_color_space")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_description_color_space")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_queue_size")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_description_queue_size")) << queueSizeDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_option_threads")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_description_threads")) << std::endl;
+            std::cout << std::endl;
+            std::cout << " " << textSystem->getText(DJV_TEXT("djv_convert_cli_examples")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_1")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_1_description")) << std::endl;
+            std::cout << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_2")) << std::endl;
+            std::cout << "   " << textSystem->getText(DJV_TEXT("djv_convert_cli_example_2_description")) << std::endl;
+            std::cout << std::endl;
+
+            CmdLine::Application::_printUsage();
+        }
+
+        void Application::_convert()
+        {
+            auto threadPool = getSystemT<AV::IO::System>()->getThreadPool();
+            const size_t jobsMax = std::max(threadPool->getThreadCount(), static_cast<size_t>(1));
+            auto& readQueue = _read->getVideoQueue();
+            auto& writeQueue = _write->getVideoQueue();
+
+            // The conversion jobs are kept in the order the frames were read
+            // so that they are added to the writer in order.
+            std::deque<std::future<AV::IO::VideoFrame> > jobs;
+            const auto timeout = Core::Time::getValue(Core::Time::TimerValue::VeryFast);
+            while (_running && _write->isRunning())
+            {
+                bool idle = true;
+
+                // Start converting the decoded frames.
+                while (jobs.size() < jobsMax && !readQueue.isEmpty())
+                {
+                    auto frame = readQueue.popFrame();
+                    if (!frame.image)
+                    {
+                        continue;
+                    }
+                    _readByteCount += frame.image->getDataByteCount();
+                    const AV::Image::Info& info = frame.image->getInfo();
+                    if (_colorProcessor)
+                    {
+                        const auto imageInfo = _info;
+                        auto imageConvert = _imageConvert;
+                        auto colorProcessor = _colorProcessor;
+                        jobs.push_back(threadPool->push(
+                            [frame, imageInfo, imageConvert, colorProcessor]
+                            {
+                                // The color processor requires images of the
+                                // same size with the native endian.
+                                std::shared_ptr<AV::Image::Data> data = frame.image;
+                                const AV::Image::Info& frameInfo = frame.image->getInfo();
+                                if (frameInfo.size != imageInfo.size || frameInfo.layout.endian != imageInfo.layout.endian)
+                                {
+                                    const AV::Image::Info resizeInfo(imageInfo.size, frameInfo.type, imageInfo.layout);
+                                    data = AV::Image::Data::create(resizeInfo);
+                                    imageConvert->process(*frame.image, resizeInfo, *data);
+                                }
+                                auto image = AV::Image::Image::create(imageInfo);
+                                image->setTags(frame.image->getTags());
+                                colorProcessor->apply(*data, *image);
+                                return AV::IO::VideoFrame(frame.frame, image);
+                            }));
+                    }
+                    else if (info.size != _info.size || info.type != _info.type)
+                    {
+                        const auto imageInfo = _info;
+                        auto imageConvert = _imageConvert;
+                        jobs.push_back(threadPool->push(
+                            [frame, imageInfo, imageConvert]
+                            {
+                                auto image = AV::Image::Image::create(imageInfo);
+                                image->setTags(frame.image->getTags());
+                                imageConvert->process(*frame.image, imageInfo, *image);
+                                return AV::IO::VideoFrame(frame.frame, image);
+                            }));
+                    }
+                    else
+                    {
+                        std::promise<AV::IO::VideoFrame> promise;
+                        promise.set_value(frame);
+                        jobs.push_back(promise.get_future());
+                    }
+                    idle = false;
+                }
+
+                // Add the converted frames to the writer.
+                while (jobs.size() &&
+                    jobs.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+                    writeQueue.getCount() < writeQueue.getMax())
+                {
+                    const auto frame = jobs.front().get();
+                    jobs.pop_front();
+                    writeQueue.addFrame(frame);
+                    _writeByteCount += frame.image->getDataByteCount();
+                    ++_frames;
+                    idle = false;
+                }
+
+                // The finished state is checked before the queue so that no
+                // frames are missed.
+                const bool readFinished = readQueue.isFinished() || !_read->isRunning();
+                if (readFinished && readQueue.isEmpty() && jobs.empty())
+                {
+                    break;
+                }
+
+                if (idle)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+                }
+            }
+            for (auto& i : jobs)
+            {
+                i.wait();
+            }
+            {
+                std::lock_guard<std::mutex> lock(_write->getMutex());
+                writeQueue.setFinished(true);
+            }
+            _running = false;
+        }
+
+        void Application::_printStats()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> delta = now - _startTime;
+            const double seconds = std::max(delta.count(), .001);
+            auto textSystem = getSystemT<Core::TextSystem>();
+            auto toString = [](double value)
+            {
+                std::stringstream ss;
+                ss.precision(2);
+                ss << std::fixed << value;
+                return ss.str();
+            };
+            const double megabytes = static_cast<double>(Core::Memory::megabyte);
+            std::cout << std::string(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_stats_frames"))).
+                arg(static_cast<size_t>(_frames)).
+                arg(_frameCount)) << std::endl;
+            std::cout << std::string(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_stats_time"))).
+                arg(toString(seconds))) << std::endl;
+            std::cout << std::string(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_stats_speed"))).
+                arg(toString(_frames / seconds))) << std::endl;
+            std::cout << std::string(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_stats_read"))).
+                arg(toString(_readByteCount / megabytes / seconds))) << std::endl;
+            std::cout << std::string(Core::String::Format(textSystem->getText(DJV_TEXT("djv_convert_stats_write"))).
+                arg(toString(_writeByteCount / megabytes / seconds))) << std::endl;
+        }
+
+    } // namespace Convert
+} // namespace djv
+
+int main(int argc, char** argv)
+{
+    int r = 1;
+    try
+    {
+        auto args = Convert::Application::args(argc, argv);
+        auto app = Convert::Application::create(args);
+        if (0 == app->getExitCode())
+        {
+            app->run();
+        }
+        r = app->getExitCode();
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
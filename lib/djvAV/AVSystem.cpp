@@ -8,6 +8,7 @@
 #include <djvAV/FontSystem.h>
 #include <djvAV/GLFWSystem.h>
 #include <djvAV/IO.h>
+#include <djvAV/OCIOLUT.h>
 #include <djvAV/OCIOSystem.h>
 #include <djvAV/Render2D.h>
 #include <djvAV/Render3D.h>
@@ -35,6 +36,8 @@ namespace djv
             std::shared_ptr<ValueSubject<Time::FPS> > defaultSpeed;
             std::shared_ptr<ValueSubject<Render2D::ImageFilterOptions> > imageFilterOptions;
             std::shared_ptr<ValueSubject<bool> > lcdText;
+            std::shared_ptr<ValueSubject<size_t> > textureCacheSize;
+            std::shared_ptr<ValueSubject<size_t> > lutSize;
             std::shared_ptr<ThumbnailSystem> thumbnailSystem;
             std::shared_ptr<Render2D::Render> render2D;
         };
@@ -49,6 +52,8 @@ namespace djv
             p.defaultSpeed = ValueSubject<Time::FPS>::create(Time::getDefaultSpeed());
             p.imageFilterOptions = ValueSubject<Render2D::ImageFilterOptions>::create();
             p.lcdText = ValueSubject<bool>::create(true);
+            p.textureCacheSize = ValueSubject<size_t>::create(Render2D::textureCacheSizeDefault);
+            p.lutSize = ValueSubject<size_t>::create(OCIO::lutSizeDefault);
 
             auto glfwSystem = GLFW::System::create(context);
             auto ocioSystem = OCIO::System::create(context);
@@ -148,6 +153,34 @@ namespace djv
             }
         }
 
+        std::shared_ptr<IValueSubject<size_t> > AVSystem::observeTextureCacheSize() const
+        {
+            return _p->textureCacheSize;
+        }
+
+        void AVSystem::setTextureCacheSize(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.textureCacheSize->setIfChanged(value))
+            {
+                p.render2D->setTextureCacheSize(value);
+            }
+        }
+
+        std::shared_ptr<IValueSubject<size_t> > AVSystem::observeLUTSize() const
+        {
+            return _p->lutSize;
+        }
+
+        void AVSystem::setLUTSize(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.lutSize->setIfChanged(value))
+            {
+                p.render2D->setLUTSize(value);
+            }
+        }
+
     } // namespace AV
 } // namespace djv
 
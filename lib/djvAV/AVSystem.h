@@ -50,6 +50,12 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<bool> > observeLCDText() const;
             void setLCDText(bool);
 
+            std::shared_ptr<Core::IValueSubject<size_t> > observeTextureCacheSize() const;
+            void setTextureCacheSize(size_t);
+
+            std::shared_ptr<Core::IValueSubject<size_t> > observeLUTSize() const;
+            void setLUTSize(size_t);
+
         private:
             DJV_PRIVATE();
         };
@@ -4,6 +4,8 @@
 
 #include <djvAV/AudioData.h>
 
+#include <algorithm>
+
 #include <string.h>
 
 #define _CONVERT(a, b) \
@@ -239,6 +241,82 @@ namespace djv
                 }
             }
 
+            void RingBuffer::_init(const Info& info)
+            {
+                _info = info;
+                _sampleByteCount = info.channelCount * Audio::getByteCount(info.type);
+                _data.resize(info.getByteCount());
+            }
+
+            std::shared_ptr<RingBuffer> RingBuffer::create(const Info& info)
+            {
+                auto out = std::shared_ptr<RingBuffer>(new RingBuffer);
+                out->_init(info);
+                return out;
+            }
+
+            size_t RingBuffer::write(const uint8_t* data, size_t sampleCount)
+            {
+                const size_t capacity = _info.sampleCount;
+                if (!capacity)
+                {
+                    return 0;
+                }
+                const size_t writePos = _writePos.load(std::memory_order_relaxed);
+                const size_t readPos = _readPos.load(std::memory_order_acquire);
+                const size_t size = std::min(sampleCount, capacity - (writePos - readPos));
+                const size_t index = writePos % capacity;
+                const size_t size0 = std::min(size, capacity - index);
+                memcpy(_data.data() + index * _sampleByteCount, data, size0 * _sampleByteCount);
+                memcpy(_data.data(), data + size0 * _sampleByteCount, (size - size0) * _sampleByteCount);
+                _writePos.store(writePos + size, std::memory_order_release);
+                return size;
+            }
+
+            size_t RingBuffer::read(uint8_t* data, size_t sampleCount, float volume)
+            {
+                const size_t capacity = _info.sampleCount;
+                if (!capacity)
+                {
+                    return 0;
+                }
+                const size_t readPos = _readPos.load(std::memory_order_relaxed);
+                const size_t writePos = _writePos.load(std::memory_order_acquire);
+                const size_t size = std::min(sampleCount, writePos - readPos);
+                const size_t index = readPos % capacity;
+                const size_t size0 = std::min(size, capacity - index);
+                if (1.F == volume)
+                {
+                    memcpy(data, _data.data() + index * _sampleByteCount, size0 * _sampleByteCount);
+                    memcpy(data + size0 * _sampleByteCount, _data.data(), (size - size0) * _sampleByteCount);
+                }
+                else
+                {
+                    Data::volume(
+                        _data.data() + index * _sampleByteCount,
+                        data,
+                        volume,
+                        size0,
+                        _info.channelCount,
+                        _info.type);
+                    Data::volume(
+                        _data.data(),
+                        data + size0 * _sampleByteCount,
+                        volume,
+                        size - size0,
+                        _info.channelCount,
+                        _info.type);
+                }
+                _readPos.store(readPos + size, std::memory_order_release);
+                return size;
+            }
+
+            void RingBuffer::reset()
+            {
+                _readPos.store(0);
+                _writePos.store(0);
+            }
+
             bool Data::operator == (const Data & other) const
             {
                 return
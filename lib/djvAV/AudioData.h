@@ -6,7 +6,9 @@
 
 #include <djvAV/Audio.h>
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 namespace djv
 {
@@ -82,6 +84,56 @@ namespace djv
                 std::vector<uint8_t> _data;
             };
 
+            //! This class provides a ring buffer of interleaved audio samples.
+            //!
+            //! The buffer is allocated when it is created, and reading and
+            //! writing do not allocate memory or take locks. One thread may
+            //! write to the buffer while another thread reads from it, which
+            //! makes it suitable for feeding a real-time audio callback.
+            class RingBuffer
+            {
+                DJV_NON_COPYABLE(RingBuffer);
+
+            protected:
+                void _init(const Info&);
+                RingBuffer();
+
+            public:
+                //! Create a new ring buffer. The capacity is given by the
+                //! sample count of the information.
+                static std::shared_ptr<RingBuffer> create(const Info&);
+
+                const Info& getInfo() const;
+                size_t getCapacity() const;
+
+                //! Get the number of samples that can be read.
+                size_t getReadCount() const;
+
+                //! Get the number of samples that can be written.
+                size_t getWriteCount() const;
+
+                //! Write samples to the buffer, returns the number of samples
+                //! written. This function should only be called by the
+                //! producer thread.
+                size_t write(const uint8_t*, size_t sampleCount);
+
+                //! Read samples from the buffer and scale them by the volume,
+                //! returns the number of samples read. This function should
+                //! only be called by the consumer thread.
+                size_t read(uint8_t*, size_t sampleCount, float volume = 1.F);
+
+                //! Remove all of the samples. This function must not be
+                //! called while the buffer is being read or written.
+                void reset();
+
+            private:
+                Info _info;
+                size_t _sampleByteCount = 0;
+                std::vector<uint8_t> _data;
+                std::atomic<size_t> _readPos;
+                std::atomic<size_t> _writePos;
+            };
+
         } // namespace Audio
     } // namespace AV
 } // namespace djv
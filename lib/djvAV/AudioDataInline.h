@@ -78,6 +78,31 @@ namespace djv
                 return _data.data();
             }
 
+            inline RingBuffer::RingBuffer() :
+                _readPos(0),
+                _writePos(0)
+            {}
+
+            inline const Info& RingBuffer::getInfo() const
+            {
+                return _info;
+            }
+
+            inline size_t RingBuffer::getCapacity() const
+            {
+                return _info.sampleCount;
+            }
+
+            inline size_t RingBuffer::getReadCount() const
+            {
+                return _writePos.load(std::memory_order_acquire) - _readPos.load(std::memory_order_acquire);
+            }
+
+            inline size_t RingBuffer::getWriteCount() const
+            {
+                return _info.sampleCount - getReadCount();
+            }
+
             template<typename T>
             inline void Data::extract(const T* value, T* out, size_t sampleCount, uint8_t inChannelCount, uint8_t outChannelCount)
             {
@@ -611,12 +611,12 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo & fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _threadPool, _frameCache, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
                 {
-                    return Write::create(fileInfo, info, options, _textSystem, _resourceSystem, _logSystem);
+                    return Write::create(fileInfo, info, options, _threadPool, _textSystem, _resourceSystem, _logSystem);
                 }
 
             } // namespace Cineon
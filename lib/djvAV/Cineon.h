@@ -200,12 +200,17 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<Core::ThreadPool>&,
+                        const std::shared_ptr<FrameCache>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    bool hasProxy() const override { return true; }
+
                     static std::shared_ptr<Image::Image> readImage(
                         const Info&,
+                        size_t proxy,
                         const std::shared_ptr<Core::FileSystem::FileIO>&);
 
                 protected:
@@ -233,6 +238,7 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const Info &,
                         const WriteOptions&,
+                        const std::shared_ptr<Core::ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -33,21 +33,33 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo & fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, frameCache, textSystem, resourceSystem, logSystem);
                     return out;
                 }
                 
                 std::shared_ptr<Image::Image> Read::readImage(
                     const Info& info,
+                    size_t proxy,
                     const std::shared_ptr<FileSystem::FileIO>& io)
                 {
+                    if (proxy > 0)
+                    {
+                        auto out = readProxy(info.video[0].info, proxy, io);
+                        out->setTags(info.tags);
+                        return out;
+                    }
 #if defined(DJV_MMAP)
+                    // The image data is not copied, the file stays mapped and the
+                    // endian conversion is left to the image layout.
                     auto out = Image::Image::create(info.video[0].info, io);
+                    out->setTags(info.tags);
 #else // DJV_MMAP
                     auto infoTmp = info;
                     bool convertEndian = false;
@@ -72,8 +84,8 @@ namespace djv
                             default: break;                            
                         }
                     }
-#endif // DJV_MMAP
                     out->setTags(infoTmp.tags);
+#endif // DJV_MMAP
                     return out;
                 }
 
@@ -87,7 +99,7 @@ namespace djv
                 {
                     auto io = FileSystem::FileIO::create();
                     const auto info = _open(fileName, io);
-                    auto out = readImage(info, io);
+                    auto out = readImage(info, _options.proxy, io);
                     out->setPluginName(pluginName);
                     return out;
                 }
@@ -310,10 +310,14 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<Core::ThreadPool>&,
+                        const std::shared_ptr<FrameCache>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    bool hasProxy() const override { return true; }
+
                 protected:
                     Info _readInfo(const std::string &) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
@@ -340,6 +344,7 @@ namespace djv
                         const Info &,
                         const WriteOptions&,
                         const Options&,
+                        const std::shared_ptr<Core::ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
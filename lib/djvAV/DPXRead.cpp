@@ -35,13 +35,15 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, frameCache, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -55,7 +57,7 @@ namespace djv
                 {
                     auto io = FileSystem::FileIO::create();
                     const auto info = _open(fileName, io);
-                    auto out = Cineon::Read::readImage(info, io);
+                    auto out = Cineon::Read::readImage(info, _options.proxy, io);
                     out->setPluginName(pluginName);
                     return out;
                 }
@@ -42,6 +42,24 @@ namespace djv
                     return out;
                 }
 
+                Image::Type toImageType(AVPixelFormat value)
+                {
+                    Image::Type out = Image::Type::None;
+                    switch (value)
+                    {
+                    case AV_PIX_FMT_GRAY8:  out = Image::Type::L_U8;     break;
+                    case AV_PIX_FMT_GRAY16: out = Image::Type::L_U16;    break;
+                    case AV_PIX_FMT_YA8:    out = Image::Type::LA_U8;    break;
+                    case AV_PIX_FMT_YA16:   out = Image::Type::LA_U16;   break;
+                    case AV_PIX_FMT_RGB24:  out = Image::Type::RGB_U8;   break;
+                    case AV_PIX_FMT_RGB48:  out = Image::Type::RGB_U16;  break;
+                    case AV_PIX_FMT_RGBA:   out = Image::Type::RGBA_U8;  break;
+                    case AV_PIX_FMT_RGBA64: out = Image::Type::RGBA_U16; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
                 std::string toString(AVSampleFormat value)
                 {
                     //! \todo How can we translate this?
@@ -130,7 +148,7 @@ namespace djv
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
                     DJV_PRIVATE_PTR();
-                    return Read::create(fileInfo, options, p.options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, p.options, _frameCache, _textSystem, _resourceSystem, _logSystem);
                 }
 
             } // namespace FFmpeg
@@ -142,6 +160,8 @@ namespace djv
         picojson::value out(picojson::object_type, true);
         {
             out.get<picojson::object>()["ThreadCount"] = toJSON(value.threadCount);
+            out.get<picojson::object>()["FrameThreading"] = toJSON(value.frameThreading);
+            out.get<picojson::object>()["ConvertThreadCount"] = toJSON(value.convertThreadCount);
         }
         return out;
     }
@@ -156,6 +176,14 @@ namespace djv
                 {
                     fromJSON(i.second, out.threadCount);
                 }
+                else if ("FrameThreading" == i.first)
+                {
+                    fromJSON(i.second, out.frameThreading);
+                }
+                else if ("ConvertThreadCount" == i.first)
+                {
+                    fromJSON(i.second, out.convertThreadCount);
+                }
             }
         }
         else
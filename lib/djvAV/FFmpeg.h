@@ -56,15 +56,28 @@ namespace djv
                 Audio::Type toAudioType(AVSampleFormat);
                 std::string toString(AVSampleFormat);
 
+                //! Get the image type that has the same memory layout as the
+                //! given pixel format, returns Image::Type::None if there is no
+                //! matching type.
+                Image::Type toImageType(AVPixelFormat);
+
                 std::string getErrorString(int);
 
                 //! This struct provides the FFmpeg file I/O optioms.
                 struct Options
                 {
-                    size_t threadCount = 4;
+                    size_t threadCount        = 4;
+                    bool   frameThreading     = true;
+                    size_t convertThreadCount = 2;
                 };
 
                 //! This class provides the FFmpeg file reader.
+                //!
+                //! A keyframe index is built when the file is opened so that
+                //! seeks start decoding from the nearest keyframe. Decoded
+                //! frames are stored in the frame cache, and reverse playback
+                //! decodes each group of pictures forward and then returns the
+                //! frames in reverse order.
                 class Read : public IRead
                 {
                     DJV_NON_COPYABLE(Read);
@@ -74,6 +87,7 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<FrameCache>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -86,6 +100,7 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<FrameCache>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -95,13 +110,32 @@ namespace djv
                     std::future<Info> getInfo() override;
 
                     void seek(int64_t, Direction) override;
+                    bool hasCache() const override { return true; }
 
                 private:
+                    //! Get the keyframes from the container index.
+                    void _indexKeyFrames();
+
+                    //! Get the keyframes by reading all of the packets, this
+                    //! is only done when the container has no index.
+                    void _scanKeyFrames();
+                    void _seek(Core::Frame::Number, bool cacheEnabled);
+                    void _readReverse(bool cacheEnabled);
+                    void _updateCache(const InOutPoints&, size_t sequenceSize);
+
+                    std::shared_ptr<Image::Image> _getPoolImage(const Image::Info&);
+                    void _finishConversions(size_t maxPending);
+                    void _cancelConversions();
+
                     struct DecodeVideo
                     {
                         AVPacket*           packet       = nullptr;
                         Core::Frame::Number seek         = -1;
                         bool                cacheEnabled = false;
+
+                        //! When set the decoded frames are stored here instead
+                        //! of being added to the video queue.
+                        std::map<Core::Frame::Number, std::shared_ptr<Image::Image> >* frames = nullptr;
                     };
                     int _decodeVideo(const DecodeVideo&, Core::Frame::Number&);
 
@@ -4,13 +4,18 @@
 
 #include <djvAV/FFmpeg.h>
 
+#include <djvAV/FrameCache.h>
+
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
+#include <djvCore/UID.h>
 #include <djvCore/Vector.h>
 
+#include <list>
+
 extern "C"
 {
 #include <libavformat/avformat.h>
@@ -30,6 +35,13 @@ namespace djv
         {
             namespace FFmpeg
             {
+                namespace
+                {
+                    //! \todo Should this be configurable?
+                    const double infoTimeout = 0.5;
+
+                } // namespace
+
                 struct Read::Private
                 {
                     Options options;
@@ -43,20 +55,73 @@ namespace djv
                     std::thread thread;
                     std::atomic<bool> running;
 
+                    std::shared_ptr<FrameCache> frameCache;
+                    FrameCache::Key cacheKey;
+                    UID cacheUID = 0;
+                    size_t frameByteCount = 0;
+                    std::chrono::steady_clock::time_point infoTimer;
+
+                    //! The keyframes of the video stream, mapping the frame
+                    //! number to the stream time stamp.
+                    std::map<Frame::Number, int64_t> keyFrames;
+                    bool keyFramesScanned = false;
+
+                    //! The next frame to be read and any pending decoder seek.
+                    Frame::Number frame = 0;
+                    Frame::Number decodeSeek = Frame::invalid;
+
+                    //! Frames from the current group of pictures that have been
+                    //! decoded for reverse playback but not yet queued. Frames
+                    //! that were added to the frame cache are not kept here, so
+                    //! they are counted by its byte budget. The others are
+                    //! limited to the size of the video queue, keeping the
+                    //! frames that are played next.
+                    std::map<Frame::Number, std::shared_ptr<Image::Image> > reverseFrames;
+                    size_t reverseFramesMax = 0;
+
                     AVFormatContext * avFormatContext = nullptr;
                     int avVideoStream = -1;
                     int avAudioStream = -1;
                     std::map<int, AVCodecParameters *> avCodecParameters;
                     std::map<int, AVCodecContext *> avCodecContext;
                     AVFrame * avFrame = nullptr;
-                    AVFrame * avFrameRgb = nullptr;
-                    SwsContext * swsContext = nullptr;
+
+                    //! The decoded frames are converted to images by a separate
+                    //! set of threads. The conversions are finished in the
+                    //! order the frames were decoded.
+                    bool swsBypass = false;
+                    struct ConvertRequest
+                    {
+                        AVFrame* avFrame = nullptr;
+                        std::shared_ptr<Image::Image> image;
+                        std::promise<std::shared_ptr<Image::Image> > promise;
+                    };
+                    std::list<ConvertRequest> convertRequests;
+                    std::mutex convertMutex;
+                    std::condition_variable convertCV;
+                    std::vector<std::thread> convertThreads;
+                    std::atomic<bool> convertRunning;
+                    struct Convert
+                    {
+                        Frame::Number frame = Frame::invalid;
+                        bool cache = false;
+                        std::map<Frame::Number, std::shared_ptr<Image::Image> >* frames = nullptr;
+                        std::future<std::shared_ptr<Image::Image> > future;
+                    };
+                    std::list<Convert> converts;
+                    size_t convertMax = 0;
+
+                    //! Images are recycled once they are no longer referenced
+                    //! outside of the pool.
+                    std::vector<std::shared_ptr<Image::Image> > imagePool;
+                    size_t imagePoolMax = 0;
                 };
 
                 void Read::_init(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
@@ -64,7 +129,21 @@ namespace djv
                     IRead::_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
                     DJV_PRIVATE_PTR();
                     p.options = options;
+                    p.frameCache = frameCache;
+                    p.cacheKey = FrameCache::Key(fileInfo.getFileName(), readOptions.layer);
+                    p.cacheUID = createUID();
+                    _videoQueue.setPopCallback(
+                        [this]
+                        {
+                            _p->queueCV.notify_one();
+                        });
+                    _audioQueue.setPopCallback(
+                        [this]
+                        {
+                            _p->queueCV.notify_one();
+                        });
                     p.running = true;
+                    p.convertRunning = true;
                     p.thread = std::thread(
                         [this]
                     {
@@ -155,7 +234,9 @@ namespace djv
                                         arg(FFmpeg::getErrorString(r)));
                                 }
                                 p.avCodecContext[p.avVideoStream]->thread_count = p.options.threadCount;
-                                p.avCodecContext[p.avVideoStream]->thread_type = FF_THREAD_SLICE;
+                                p.avCodecContext[p.avVideoStream]->thread_type = p.options.frameThreading ?
+                                    (FF_THREAD_FRAME | FF_THREAD_SLICE) :
+                                    FF_THREAD_SLICE;
                                 r = avcodec_open2(p.avCodecContext[p.avVideoStream], avVideoCodec, 0);
                                 if (r < 0)
                                 {
@@ -164,27 +245,106 @@ namespace djv
                                         arg(FFmpeg::getErrorString(r)));
                                 }
 
-                                // Initialize the buffers.
-                                p.avFrameRgb = av_frame_alloc();
-
-                                // Initialize the software scaler.
-                                p.swsContext = sws_getContext(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format),
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    AV_PIX_FMT_RGBA,
-                                    SWS_BILINEAR,
-                                    0,
-                                    0,
-                                    0);
+                                // Pixel formats that match an image type are copied
+                                // directly, otherwise they are converted to RGBA.
+                                const int width = p.avCodecParameters[p.avVideoStream]->width;
+                                const int height = p.avCodecParameters[p.avVideoStream]->height;
+                                const auto avPixelFormat = static_cast<AVPixelFormat>(p.avCodecParameters[p.avVideoStream]->format);
+                                Image::Type imageType = toImageType(avPixelFormat);
+                                p.swsBypass = imageType != Image::Type::None;
+                                if (!p.swsBypass)
+                                {
+                                    imageType = Image::Type::RGBA_U8;
+                                }
+
+                                // Start the conversion threads.
+                                const size_t convertThreadCount = std::max(p.options.convertThreadCount, static_cast<size_t>(1));
+                                p.convertMax = convertThreadCount * 2;
+                                for (size_t i = 0; i < convertThreadCount; ++i)
+                                {
+                                    p.convertThreads.push_back(std::thread(
+                                        [this, width, height, avPixelFormat]
+                                        {
+                                            DJV_PRIVATE_PTR();
+                                            SwsContext* swsContext = nullptr;
+                                            if (!p.swsBypass)
+                                            {
+                                                swsContext = sws_getContext(
+                                                    width,
+                                                    height,
+                                                    avPixelFormat,
+                                                    width,
+                                                    height,
+                                                    AV_PIX_FMT_RGBA,
+                                                    SWS_BILINEAR,
+                                                    0,
+                                                    0,
+                                                    0);
+                                            }
+                                            while (p.convertRunning)
+                                            {
+                                                Private::ConvertRequest request;
+                                                {
+                                                    std::unique_lock<std::mutex> lock(p.convertMutex);
+                                                    if (p.convertCV.wait_for(
+                                                        lock,
+                                                        Time::getTime(Time::TimerValue::Fast),
+                                                        [this]
+                                                        {
+                                                            return !_p->convertRequests.empty();
+                                                        }))
+                                                    {
+                                                        request = std::move(p.convertRequests.front());
+                                                        p.convertRequests.pop_front();
+                                                    }
+                                                }
+                                                if (request.avFrame)
+                                                {
+                                                    if (swsContext)
+                                                    {
+                                                        uint8_t* data[4];
+                                                        int linesize[4];
+                                                        av_image_fill_arrays(
+                                                            data,
+                                                            linesize,
+                                                            request.image->getData(),
+                                                            AV_PIX_FMT_RGBA,
+                                                            width,
+                                                            height,
+                                                            1);
+                                                        sws_scale(
+                                                            swsContext,
+                                                            (uint8_t const* const*)request.avFrame->data,
+                                                            request.avFrame->linesize,
+                                                            0,
+                                                            height,
+                                                            data,
+                                                            linesize);
+                                                    }
+                                                    else
+                                                    {
+                                                        const size_t scanlineByteCount = request.image->getScanlineByteCount();
+                                                        for (int y = 0; y < height; ++y)
+                                                        {
+                                                            memcpy(
+                                                                request.image->getData(y),
+                                                                request.avFrame->data[0] + y * request.avFrame->linesize[0],
+                                                                scanlineByteCount);
+                                                        }
+                                                    }
+                                                    av_frame_free(&request.avFrame);
+                                                    request.promise.set_value(request.image);
+                                                }
+                                            }
+                                            if (swsContext)
+                                            {
+                                                sws_freeContext(swsContext);
+                                            }
+                                        }));
+                                }
 
                                 // Get information.
-                                const auto pixelDataInfo = Image::Info(
-                                    p.avCodecParameters[p.avVideoStream]->width,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    Image::Type::RGBA_U8);
+                                const auto pixelDataInfo = Image::Info(width, height, imageType);
                                 if (avVideoStream->duration != AV_NOPTS_VALUE)
                                 {
                                     AVRational r;
@@ -209,6 +369,9 @@ namespace djv
                                 p.videoInfo = VideoInfo(pixelDataInfo, p.speed, Frame::Sequence(Frame::Range(1, sequenceSize)));
                                 p.videoInfo.codec = std::string(avVideoCodec->long_name);
                                 info.video.push_back(p.videoInfo);
+                                p.frameByteCount = pixelDataInfo.getDataByteCount();
+
+                                _indexKeyFrames();
                                 /*{
                                     std::stringstream ss;
                                     ss << _fileInfo << ": image size " << pixelDataInfo.size << "\n";
@@ -303,72 +466,49 @@ namespace djv
 
                             p.infoPromise.set_value(info);
 
+                            p.infoTimer = std::chrono::steady_clock::now();
                             while (p.running)
                             {
-                                //! \todo Implement me!
-                                /*bool cacheEnabled = false;
+                                bool playback = false;
+                                InOutPoints inOutPoints;
+                                bool cacheEnabled = false;
                                 size_t cacheMaxByteCount = 0;
                                 {
                                     std::lock_guard<std::mutex> lock(_mutex);
+                                    playback = _playback;
+                                    inOutPoints = _inOutPoints;
                                     cacheEnabled = _cacheEnabled;
                                     cacheMaxByteCount = _cacheMaxByteCount;
-                                    _cachedFrames = _getCachedFrames(_cache);
                                 }
-                                if (!cacheEnabled)
-                                {
-                                    _cache.clear();
-                                }
-                                if (info.video.size() && _options.layer < info.video.size())
-                                {
-                                    const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
-                                    _cache.setMax(cacheMaxByteCount / dataByteCount);
-                                }
-                                else
-                                {
-                                    _cache.setMax(0);
-                                }*/
+                                _cache.setMax(p.frameByteCount ? (cacheMaxByteCount / p.frameByteCount) : 0);
+                                _cache.setSequenceSize(sequenceSize);
+                                _cache.setInOutPoints(inOutPoints);
 
                                 bool read = false;
+                                bool reset = false;
                                 int64_t seek = Frame::invalid;
                                 {
-                                    //const std::vector<Frame::Number> cachedFrames = _cache.getKeys();
                                     std::unique_lock<std::mutex> lock(_mutex);
+                                    p.imagePoolMax = _videoQueue.getMax() + p.convertMax;
+                                    p.reverseFramesMax = _videoQueue.getMax();
                                     if (p.queueCV.wait_for(
                                         lock,
                                         Time::getTime(Time::TimerValue::Fast),
-                                        [this, sequenceSize]
-                                        //[this, sequenceSize, cacheEnabled, &cachedFrames]
+                                        [this, playback]
                                     {
                                         DJV_PRIVATE_PTR();
-                                        const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (_videoQueue.getCount() < _videoQueue.getMax()));
+                                        // Only the current frame is needed when playback is stopped.
+                                        const size_t videoMax = playback ? _videoQueue.getMax() : 1;
+                                        const size_t videoCount = _videoQueue.getCount() + p.converts.size();
+                                        const bool video = p.avVideoStream != -1 && (_videoQueue.isFinished() ? false : (videoCount < videoMax));
                                         const bool audio = p.avAudioStream != -1 && (_audioQueue.isFinished() ? false : (_audioQueue.getCount() < _audioQueue.getMax()));
-
-                                        /*bool cache = false;
-                                        if (cacheEnabled && !_videoQueue.isFinished() && !_audioQueue.isFinished())
-                                        {
-                                            const size_t cacheMax = _cache.getMax();
-                                            cache |= _cache.getSize() < cacheMax;
-                                            if (_videoQueue.getFrameCount())
-                                            {
-                                                const auto& frame = _videoQueue.getFrame();
-                                                for (const auto& i : cachedFrames)
-                                                {
-                                                    if (i < frame.frame || i > frame.frame + cacheMax)
-                                                    {
-                                                        cache = true;
-                                                        break;
-                                                    }
-                                                }
-                                            }
-                                        }*/
-                                        
                                         return video || audio || p.seek != Frame::invalid || p.direction != _direction;
-                                        //return video || audio || p.seek != Frame::invalid || p.direction != _direction || cache;
                                     }))
                                     {
                                         read = true;
                                         if (p.direction != _direction)
                                         {
+                                            reset = true;
                                             p.direction = _direction;
                                             _videoQueue.setFinished(false);
                                             _videoQueue.clearFrames();
@@ -377,6 +517,7 @@ namespace djv
                                         }
                                         if (p.seek != Frame::invalid)
                                         {
+                                            reset = true;
                                             seek = p.seek;
                                             p.seek = Frame::invalid;
                                             _videoQueue.setFinished(false);
@@ -384,98 +525,58 @@ namespace djv
                                             _audioQueue.setFinished(false);
                                             _audioQueue.clearFrames();
                                         }
+                                        if (Direction::Reverse == p.direction && p.avVideoStream != -1)
+                                        {
+                                            // Audio is not played in reverse.
+                                            _audioQueue.setFinished(true);
+                                        }
+                                    }
+                                }
+                                if (reset)
+                                {
+                                    _cancelConversions();
+                                }
+                                if (seek != Frame::invalid)
+                                {
+                                    p.frame = seek;
+                                    p.decodeSeek = seek;
+                                    p.reverseFrames.clear();
+
+                                    // Use the frame cache when scrubbing so the decoder
+                                    // does not need to seek for every frame.
+                                    std::shared_ptr<Image::Image> image;
+                                    if (cacheEnabled &&
+                                        !playback &&
+                                        Direction::Forward == p.direction &&
+                                        p.frameCache->get(p.cacheKey, seek, image))
+                                    {
+                                        std::lock_guard<std::mutex> lock(_mutex);
+                                        _videoQueue.addFrame(VideoFrame(seek, image));
+                                        p.decodeSeek = seek + 1;
                                     }
                                 }
                                 AVPacket packet;
+                                av_init_packet(&packet);
+                                packet.data = nullptr;
+                                packet.size = 0;
                                 try
                                 {
-                                    if (seek != Frame::invalid)
+                                    if (Direction::Reverse == p.direction && p.avVideoStream != -1)
                                     {
-                                        int64_t t = 0;
-                                        int stream = -1;
-                                        if (p.avVideoStream != -1)
+                                        p.decodeSeek = Frame::invalid;
+                                        if (read)
                                         {
-                                            stream = p.avVideoStream;
-                                            AVRational r;
-                                            r.num = p.speed.getDen();
-                                            r.den = p.speed.getNum();
-                                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
-                                            //t = av_rescale_q(seek, r, av_get_time_base_q());
-                                        }
-                                        else if (p.avAudioStream != -1)
-                                        {
-                                            stream = p.avAudioStream;
-                                            AVRational r;
-                                            r.num = 1;
-                                            r.den = p.audioInfo.info.sampleRate;
-                                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
-                                            //t = av_rescale_q(seek, r, av_get_time_base_q());
-                                        }
-                                        if (p.avVideoStream != -1)
-                                        {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                        }
-                                        if (p.avAudioStream != -1)
-                                        {
-                                            avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                        }
-                                        if (av_seek_frame(
-                                            p.avFormatContext,
-                                            stream,
-                                            t,
-                                            AVSEEK_FLAG_BACKWARD) < 0)
-                                        {
-                                            throw std::exception();
-                                        }
-                                        Frame::Number videoFrame = Frame::invalid;
-                                        Frame::Number audioFrame = Frame::invalid;
-                                        while (videoFrame < seek - 1 || audioFrame < seek - 1)
-                                        {
-                                            if (av_read_frame(p.avFormatContext, &packet) < 0)
-                                            {
-                                                if (p.avVideoStream != -1)
-                                                {
-                                                    DecodeVideo dv;
-                                                    //dv.cacheEnabled = cacheEnabled;
-                                                    dv.seek         = seek;
-                                                    _decodeVideo(dv, videoFrame);
-                                                    avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
-                                                }
-                                                if (p.avAudioStream != -1)
-                                                {
-                                                    DecodeAudio da;
-                                                    da.seek = seek;
-                                                    _decodeAudio(da, audioFrame);
-                                                    avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
-                                                }
-                                                throw std::exception();
-                                            }
-                                            if (p.avVideoStream == packet.stream_index)
-                                            {
-                                                DecodeVideo dv;
-                                                dv.packet       = &packet;
-                                                dv.seek         = seek;
-                                                //dv.cacheEnabled = cacheEnabled;
-                                                if (_decodeVideo(dv, videoFrame) < 0)
-                                                {
-                                                    throw std::exception();
-                                                }
-                                            }
-                                            else if (p.avAudioStream == packet.stream_index)
-                                            {
-                                                DecodeAudio da;
-                                                da.packet = &packet;
-                                                da.seek   = seek;
-                                                if (_decodeAudio(da, audioFrame) < 0)
-                                                {
-                                                    throw std::exception();
-                                                }
-                                            }
-                                            av_packet_unref(&packet);
+                                            _readReverse(cacheEnabled);
                                         }
                                     }
-                                    if (read)
+                                    else if (read)
                                     {
+                                        if (p.decodeSeek != Frame::invalid)
+                                        {
+                                            const Frame::Number decodeSeek = p.decodeSeek;
+                                            p.decodeSeek = Frame::invalid;
+                                            _seek(decodeSeek, cacheEnabled);
+                                        }
                                         Frame::Number videoFrame = Frame::invalid;
                                         Frame::Number audioFrame = Frame::invalid;
                                         int r = av_read_frame(p.avFormatContext, &packet);
@@ -484,7 +585,7 @@ namespace djv
                                             if (p.avVideoStream != -1)
                                             {
                                                 DecodeVideo dv;
-                                                //dv.cacheEnabled = cacheEnabled;
+                                                dv.cacheEnabled = cacheEnabled;
                                                 _decodeVideo(dv, videoFrame);
                                                 avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
                                             }
@@ -500,7 +601,7 @@ namespace djv
                                         {
                                             DecodeVideo dv;
                                             dv.packet       = &packet;
-                                            //dv.cacheEnabled = cacheEnabled;
+                                            dv.cacheEnabled = cacheEnabled;
                                             if (_decodeVideo(dv, videoFrame) < 0)
                                             {
                                                 throw std::exception();
@@ -526,12 +627,16 @@ namespace djv
                                         _logSystem->log("djv::AV::IO::FFmpeg::Read", ss.str());
                                     }*/
                                     av_packet_unref(&packet);
+                                    _finishConversions(0);
                                     {
                                         std::lock_guard<std::mutex> lock(_mutex);
                                         _videoQueue.setFinished(true);
                                         _audioQueue.setFinished(true);
                                     }
                                 }
+                                _finishConversions(p.convertMax);
+
+                                _updateCache(inOutPoints, sequenceSize);
                             }
                         }
                         catch (const std::exception & e)
@@ -539,13 +644,12 @@ namespace djv
                             p.infoPromise.set_value(Info());
                             _logSystem->log("djvAV::IO::FFmpeg::Read", e.what(), LogLevel::Error);
                         }
-                        if (p.swsContext)
+                        p.frameCache->removePlayhead(p.cacheUID);
+                        _cancelConversions();
+                        p.convertRunning = false;
+                        for (auto& i : p.convertThreads)
                         {
-                            sws_freeContext(p.swsContext);
-                        }
-                        if (p.avFrameRgb)
-                        {
-                            av_frame_free(&p.avFrameRgb);
+                            i.join();
                         }
                         if (p.avFrame)
                         {
@@ -586,12 +690,13 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, options, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, options, frameCache, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -605,18 +710,405 @@ namespace djv
                     return _p->infoPromise.get_future();
                 }
 
-                void Read::seek(Frame::Number value, Direction)
+                void Read::seek(Frame::Number value, Direction direction)
                 {
                     DJV_PRIVATE_PTR();
                     {
                         std::lock_guard<std::mutex> lock(_mutex);
-                        _videoQueue.clearFrames();
-                        _audioQueue.clearFrames();
+                        _videoQueue.invalidateFrames();
+                        _audioQueue.invalidateFrames();
                         p.seek = value;
+                        _direction = direction;
                     }
                     p.queueCV.notify_one();
                 }
 
+                void Read::_indexKeyFrames()
+                {
+                    DJV_PRIVATE_PTR();
+                    auto avVideoStream = p.avFormatContext->streams[p.avVideoStream];
+                    AVRational r;
+                    r.num = p.speed.getDen();
+                    r.den = p.speed.getNum();
+
+                    // Use the index from the container if it has one.
+                    for (int i = 0; i < avVideoStream->nb_index_entries; ++i)
+                    {
+                        const auto& entry = avVideoStream->index_entries[i];
+                        if (entry.flags & AVINDEX_KEYFRAME)
+                        {
+                            p.keyFrames[av_rescale_q(entry.timestamp, avVideoStream->time_base, r)] = entry.timestamp;
+                        }
+                    }
+                }
+
+                void Read::_scanKeyFrames()
+                {
+                    DJV_PRIVATE_PTR();
+                    p.keyFramesScanned = true;
+                    auto avVideoStream = p.avFormatContext->streams[p.avVideoStream];
+                    AVRational r;
+                    r.num = p.speed.getDen();
+                    r.den = p.speed.getNum();
+
+                    // The packets do not need to be decoded.
+                    AVPacket packet;
+                    av_init_packet(&packet);
+                    packet.data = nullptr;
+                    packet.size = 0;
+                    while (av_read_frame(p.avFormatContext, &packet) >= 0)
+                    {
+                        if (p.avVideoStream == packet.stream_index && (packet.flags & AV_PKT_FLAG_KEY))
+                        {
+                            const int64_t t = packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+                            if (t != AV_NOPTS_VALUE)
+                            {
+                                p.keyFrames[av_rescale_q(t, avVideoStream->time_base, r)] = t;
+                            }
+                        }
+                        av_packet_unref(&packet);
+                    }
+                    av_seek_frame(
+                        p.avFormatContext,
+                        p.avVideoStream,
+                        avVideoStream->start_time != AV_NOPTS_VALUE ? avVideoStream->start_time : 0,
+                        AVSEEK_FLAG_BACKWARD);
+                }
+
+                void Read::_seek(Frame::Number seek, bool cacheEnabled)
+                {
+                    DJV_PRIVATE_PTR();
+                    int64_t t = 0;
+                    int stream = -1;
+                    if (p.avVideoStream != -1)
+                    {
+                        stream = p.avVideoStream;
+                        const auto i = p.keyFrames.upper_bound(seek);
+                        if (i != p.keyFrames.begin())
+                        {
+                            // Seek directly to the nearest keyframe.
+                            t = std::prev(i)->second;
+                        }
+                        else
+                        {
+                            AVRational r;
+                            r.num = p.speed.getDen();
+                            r.den = p.speed.getNum();
+                            t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avVideoStream]->time_base);
+                        }
+                    }
+                    else if (p.avAudioStream != -1)
+                    {
+                        stream = p.avAudioStream;
+                        AVRational r;
+                        r.num = 1;
+                        r.den = p.audioInfo.info.sampleRate;
+                        t = av_rescale_q(seek, r, p.avFormatContext->streams[p.avAudioStream]->time_base);
+                    }
+                    if (p.avVideoStream != -1)
+                    {
+                        avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                    }
+                    if (p.avAudioStream != -1)
+                    {
+                        avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                    }
+                    if (av_seek_frame(
+                        p.avFormatContext,
+                        stream,
+                        t,
+                        AVSEEK_FLAG_BACKWARD) < 0)
+                    {
+                        throw std::exception();
+                    }
+                    AVPacket packet;
+                    av_init_packet(&packet);
+                    packet.data = nullptr;
+                    packet.size = 0;
+                    Frame::Number videoFrame = Frame::invalid;
+                    Frame::Number audioFrame = Frame::invalid;
+                    while ((p.avVideoStream != -1 && videoFrame < seek - 1) ||
+                        (p.avAudioStream != -1 && audioFrame < seek - 1))
+                    {
+                        if (av_read_frame(p.avFormatContext, &packet) < 0)
+                        {
+                            if (p.avVideoStream != -1)
+                            {
+                                DecodeVideo dv;
+                                dv.seek         = seek;
+                                dv.cacheEnabled = cacheEnabled;
+                                _decodeVideo(dv, videoFrame);
+                                avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                            }
+                            if (p.avAudioStream != -1)
+                            {
+                                DecodeAudio da;
+                                da.seek = seek;
+                                _decodeAudio(da, audioFrame);
+                                avcodec_flush_buffers(p.avCodecContext[p.avAudioStream]);
+                            }
+                            throw std::exception();
+                        }
+                        int r = 0;
+                        if (p.avVideoStream == packet.stream_index)
+                        {
+                            DecodeVideo dv;
+                            dv.packet       = &packet;
+                            dv.seek         = seek;
+                            dv.cacheEnabled = cacheEnabled;
+                            r = _decodeVideo(dv, videoFrame);
+                        }
+                        else if (p.avAudioStream == packet.stream_index)
+                        {
+                            DecodeAudio da;
+                            da.packet = &packet;
+                            da.seek   = seek;
+                            r = _decodeAudio(da, audioFrame);
+                        }
+                        av_packet_unref(&packet);
+                        if (r < 0)
+                        {
+                            throw std::exception();
+                        }
+                    }
+                }
+
+                void Read::_readReverse(bool cacheEnabled)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (p.frame < 0)
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _videoQueue.setFinished(true);
+                        return;
+                    }
+
+                    // Containers without an index are scanned for keyframes
+                    // the first time they are played in reverse, instead of
+                    // when the file is opened.
+                    if (p.keyFrames.empty() && !p.keyFramesScanned)
+                    {
+                        _scanKeyFrames();
+                    }
+
+                    std::shared_ptr<Image::Image> image;
+                    const auto i = p.reverseFrames.find(p.frame);
+                    if (i != p.reverseFrames.end())
+                    {
+                        image = i->second;
+                        p.reverseFrames.erase(i);
+                    }
+                    else if (!(cacheEnabled && p.frameCache->get(p.cacheKey, p.frame, image)))
+                    {
+                        // Decode the group of pictures that contains the frame,
+                        // the earlier frames are kept for the following reads.
+                        // If the frame is not found (for example when the index
+                        // time stamps do not match the presentation time stamps)
+                        // try again from the previous keyframe.
+                        p.reverseFrames.clear();
+                        const auto avVideoStream = p.avFormatContext->streams[p.avVideoStream];
+                        auto j = p.keyFrames.upper_bound(p.frame);
+                        while (!image)
+                        {
+                            Frame::Number keyFrame = Frame::invalid;
+                            int64_t t = avVideoStream->start_time != AV_NOPTS_VALUE ? avVideoStream->start_time : 0;
+                            if (j != p.keyFrames.begin())
+                            {
+                                --j;
+                                keyFrame = j->first;
+                                t = j->second;
+                            }
+                            avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                            if (av_seek_frame(
+                                p.avFormatContext,
+                                p.avVideoStream,
+                                t,
+                                AVSEEK_FLAG_BACKWARD) < 0)
+                            {
+                                throw std::exception();
+                            }
+                            AVPacket packet;
+                            av_init_packet(&packet);
+                            packet.data = nullptr;
+                            packet.size = 0;
+                            DecodeVideo dv;
+                            dv.seek         = keyFrame;
+                            dv.cacheEnabled = cacheEnabled;
+                            dv.frames       = &p.reverseFrames;
+                            Frame::Number videoFrame = Frame::invalid;
+                            while (videoFrame < p.frame)
+                            {
+                                if (av_read_frame(p.avFormatContext, &packet) < 0)
+                                {
+                                    dv.packet = nullptr;
+                                    _decodeVideo(dv, videoFrame);
+                                    avcodec_flush_buffers(p.avCodecContext[p.avVideoStream]);
+                                    break;
+                                }
+                                int r = 0;
+                                if (p.avVideoStream == packet.stream_index)
+                                {
+                                    dv.packet = &packet;
+                                    r = _decodeVideo(dv, videoFrame);
+                                }
+                                av_packet_unref(&packet);
+                                if (r < 0)
+                                {
+                                    throw std::exception();
+                                }
+                            }
+                            _finishConversions(0);
+                            const auto k = p.reverseFrames.find(p.frame);
+                            if (k != p.reverseFrames.end())
+                            {
+                                image = k->second;
+                                p.reverseFrames.erase(k);
+                            }
+                            else if (cacheEnabled)
+                            {
+                                p.frameCache->get(p.cacheKey, p.frame, image);
+                            }
+                            if (j == p.keyFrames.begin())
+                            {
+                                break;
+                            }
+                        }
+                    }
+
+                    if (image)
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (Frame::invalid == p.seek)
+                        {
+                            _videoQueue.addFrame(VideoFrame(p.frame, image));
+                        }
+                    }
+                    --p.frame;
+                }
+
+                void Read::_updateCache(const InOutPoints& inOutPoints, size_t sequenceSize)
+                {
+                    DJV_PRIVATE_PTR();
+
+                    // Update the playhead so the frame cache evicts the frames
+                    // that are farthest away first.
+                    const Frame::Number frame = _videoQueue.getFrameNumber();
+                    if (frame != Frame::invalid)
+                    {
+                        _cache.setDirection(p.direction);
+                        _cache.setCurrentFrame(frame);
+                        FrameCache::Playhead playhead;
+                        playhead.key = p.cacheKey;
+                        playhead.frame = frame;
+                        playhead.direction = p.direction;
+                        playhead.range = inOutPoints.getRange(sequenceSize);
+                        playhead.readBehind = _cache.getReadBehind();
+                        p.frameCache->setPlayhead(p.cacheUID, playhead);
+                    }
+
+                    // Update information.
+                    const auto now = std::chrono::steady_clock::now();
+                    std::chrono::duration<double> delta = now - p.infoTimer;
+                    if (delta.count() > infoTimeout)
+                    {
+                        p.infoTimer = now;
+                        size_t cacheByteCount = p.frameCache->getByteCount(p.cacheKey);
+                        auto cacheSequence = _cache.getSequence();
+                        auto cachedFrames = p.frameCache->getFrames(p.cacheKey);
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _cacheByteCount = cacheByteCount;
+                            _cacheSequence = cacheSequence;
+                            _cachedFrames = std::move(cachedFrames);
+                        }
+                    }
+                }
+
+                std::shared_ptr<Image::Image> Read::_getPoolImage(const Image::Info& info)
+                {
+                    DJV_PRIVATE_PTR();
+                    std::shared_ptr<Image::Image> out;
+                    for (const auto& i : p.imagePool)
+                    {
+                        if (1 == i.use_count() && i->getInfo() == info)
+                        {
+                            // The texture caches are keyed by the image ID, so
+                            // a recycled image needs a new one.
+                            out = i;
+                            out->resetUID();
+                            break;
+                        }
+                    }
+                    if (!out)
+                    {
+                        out = Image::Image::create(info);
+                        out->setPluginName(pluginName);
+                        if (p.imagePool.size() < p.imagePoolMax)
+                        {
+                            p.imagePool.push_back(out);
+                        }
+                    }
+                    return out;
+                }
+
+                void Read::_finishConversions(size_t maxPending)
+                {
+                    DJV_PRIVATE_PTR();
+                    while (p.converts.size())
+                    {
+                        auto& convert = p.converts.front();
+                        if (p.converts.size() <= maxPending &&
+                            convert.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                        {
+                            break;
+                        }
+                        const auto image = convert.future.get();
+                        bool cached = false;
+                        if (convert.cache)
+                        {
+                            cached = p.frameCache->add(p.cacheKey, convert.frame, image);
+                        }
+                        if (convert.frames)
+                        {
+                            // Frames after the one being read have already
+                            // been played.
+                            if (!cached && convert.frame <= p.frame)
+                            {
+                                (*convert.frames)[convert.frame] = image;
+                                while (convert.frames->size() > std::max(p.reverseFramesMax, static_cast<size_t>(1)))
+                                {
+                                    // Reverse playback reads the highest frames
+                                    // first, drop the lowest.
+                                    convert.frames->erase(convert.frames->begin());
+                                }
+                            }
+                        }
+                        else
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (Frame::invalid == p.seek)
+                            {
+                                _videoQueue.addFrame(VideoFrame(convert.frame, image));
+                            }
+                        }
+                        p.converts.pop_front();
+                    }
+                }
+
+                void Read::_cancelConversions()
+                {
+                    DJV_PRIVATE_PTR();
+                    for (auto& i : p.converts)
+                    {
+                        const auto image = i.future.get();
+                        if (i.cache)
+                        {
+                            p.frameCache->add(p.cacheKey, i.frame, image);
+                        }
+                    }
+                    p.converts.clear();
+                }
+
                 int Read::_decodeVideo(const DecodeVideo& dv, Frame::Number& frame)
                 {
                     DJV_PRIVATE_PTR();
@@ -645,9 +1137,16 @@ namespace djv
 
                         if (Frame::invalid == dv.seek || frame >= dv.seek)
                         {
+                            Private::Convert convert;
+                            convert.frame = frame;
+                            convert.frames = dv.frames;
                             std::shared_ptr<Image::Image> image;
-                            if (dv.cacheEnabled && _cache.get(frame, image))
-                            {}
+                            if (dv.cacheEnabled && p.frameCache->get(p.cacheKey, frame, image))
+                            {
+                                std::promise<std::shared_ptr<Image::Image> > promise;
+                                promise.set_value(image);
+                                convert.future = promise.get_future();
+                            }
                             else
                             {
                                 auto info = p.videoInfo.info;
@@ -656,36 +1155,19 @@ namespace djv
                                 {
                                     info.pixelAspectRatio = p.avFrame->sample_aspect_ratio.num / static_cast<float>(p.avFrame->sample_aspect_ratio.den);
                                 }
-                                image = Image::Image::create(info);
-                                image->setPluginName(pluginName);
-                                av_image_fill_arrays(
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize,
-                                    image->getData(),
-                                    AV_PIX_FMT_RGBA,
-                                    image->getWidth(),
-                                    image->getHeight(),
-                                    1);
-                                sws_scale(
-                                    p.swsContext,
-                                    (uint8_t const* const*)p.avFrame->data,
-                                    p.avFrame->linesize,
-                                    0,
-                                    p.avCodecParameters[p.avVideoStream]->height,
-                                    p.avFrameRgb->data,
-                                    p.avFrameRgb->linesize);
-                                if (dv.cacheEnabled)
-                                {
-                                    _cache.add(frame, image);
-                                }
-                            }
-                            {
-                                std::lock_guard<std::mutex> lock(_mutex);
-                                if (Frame::invalid == p.seek)
+                                Private::ConvertRequest request;
+                                request.avFrame = av_frame_clone(p.avFrame);
+                                request.image = _getPoolImage(info);
+                                convert.cache = dv.cacheEnabled;
+                                convert.future = request.promise.get_future();
                                 {
-                                    _videoQueue.addFrame(VideoFrame(frame, image));
+                                    std::lock_guard<std::mutex> lock(p.convertMutex);
+                                    p.convertRequests.push_back(std::move(request));
                                 }
+                                p.convertCV.notify_one();
                             }
+                            p.converts.push_back(std::move(convert));
+                            _finishConversions(p.convertMax);
                         }
                     }
                     return r;
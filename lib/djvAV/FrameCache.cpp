@@ -0,0 +1,448 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/FrameCache.h>
+
+#include <algorithm>
+#include <limits>
+#include <functional>
+#include <set>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! The priority of frames that do not belong to a playhead.
+                const int64_t noPlayhead = std::numeric_limits<int64_t>::max();
+
+                //! The priority of frames that are outside of the playhead range.
+                const int64_t outOfRange = noPlayhead - 1;
+
+                int64_t getDistance(const FrameCache::Playhead& playhead, Frame::Index frame)
+                {
+                    if (frame < playhead.range.min || frame > playhead.range.max)
+                    {
+                        return outOfRange;
+                    }
+                    const int64_t size = playhead.range.max - playhead.range.min + 1;
+                    int64_t ahead = 0;
+                    switch (playhead.direction)
+                    {
+                    case Direction::Forward: ahead = frame - playhead.frame; break;
+                    case Direction::Reverse: ahead = playhead.frame - frame; break;
+                    default: break;
+                    }
+                    ahead = ((ahead % size) + size) % size;
+                    const int64_t behind = ahead ? (size - ahead) : 0;
+                    return behind <= static_cast<int64_t>(playhead.readBehind) ? behind : ahead;
+                }
+
+                size_t getByteCount(const std::shared_ptr<Image::Image>& value)
+                {
+                    return value ? value->getDataByteCount() : 0;
+                }
+
+            } // namespace
+
+            struct FrameCache::Private
+            {
+                size_t maxByteCount = 0;
+                size_t byteCount = 0;
+                size_t hits = 0;
+                size_t misses = 0;
+                size_t evictions = 0;
+                std::map<UID, Playhead> playheads;
+
+                struct CacheFrame
+                {
+                    std::shared_ptr<Image::Image> image;
+                    mutable int64_t priority = 0;
+                };
+                std::map<Key, std::map<Frame::Index, CacheFrame> > frames;
+                std::map<Key, size_t> byteCounts;
+
+                //! The eviction order, with the frames that should be evicted
+                //! first at the beginning. The keys point into the frames map.
+                struct Entry
+                {
+                    int64_t priority = 0;
+                    const Key* key = nullptr;
+                    Frame::Index frame = 0;
+
+                    bool operator < (const Entry& other) const
+                    {
+                        if (priority != other.priority)
+                        {
+                            return priority > other.priority;
+                        }
+                        if (key != other.key)
+                        {
+                            return std::less<const Key*>()(key, other.key);
+                        }
+                        return frame < other.frame;
+                    }
+                };
+                mutable std::set<Entry> evictionOrder;
+
+                //! The files whose frames need to be ranked again because a
+                //! playhead has changed.
+                mutable std::set<std::string> dirtyFiles;
+
+                mutable std::mutex mutex;
+
+                int64_t getPriority(const Key&, Frame::Index) const;
+                void updateEvictionOrder() const;
+                bool getEvictions(size_t byteCount, int64_t priority, std::vector<std::pair<Key, Frame::Index> >* = nullptr) const;
+
+                void remove(const Key&, Frame::Index);
+                bool makeRoom(size_t byteCount, int64_t priority);
+            };
+
+            int64_t FrameCache::Private::getPriority(const Key& key, Frame::Index frame) const
+            {
+                int64_t out = noPlayhead;
+                for (const auto& i : playheads)
+                {
+                    const auto& playheadKey = i.second.key;
+                    if (playheadKey == key ||
+                        (playheadKey.fileName == key.fileName &&
+                         playheadKey.proxy == key.proxy &&
+                         playheadKey.roi == key.roi &&
+                         i.second.layers.count(key.layer)))
+                    {
+                        out = std::min(out, getDistance(i.second, frame));
+                    }
+                }
+                return out;
+            }
+
+            void FrameCache::Private::updateEvictionOrder() const
+            {
+                if (dirtyFiles.empty())
+                    return;
+                for (const auto& i : frames)
+                {
+                    if (dirtyFiles.count(i.first.fileName))
+                    {
+                        for (const auto& j : i.second)
+                        {
+                            const int64_t priority = getPriority(i.first, j.first);
+                            if (priority != j.second.priority)
+                            {
+                                Entry entry;
+                                entry.priority = j.second.priority;
+                                entry.key = &i.first;
+                                entry.frame = j.first;
+                                evictionOrder.erase(entry);
+                                entry.priority = priority;
+                                evictionOrder.insert(entry);
+                                j.second.priority = priority;
+                            }
+                        }
+                    }
+                }
+                dirtyFiles.clear();
+            }
+
+            bool FrameCache::Private::getEvictions(
+                size_t value,
+                int64_t priority,
+                std::vector<std::pair<Key, Frame::Index> >* out) const
+            {
+                if (value > maxByteCount)
+                {
+                    return false;
+                }
+                size_t available = maxByteCount - std::min(byteCount, maxByteCount);
+                if (available >= value)
+                {
+                    return true;
+                }
+                updateEvictionOrder();
+                for (auto i = evictionOrder.begin(); i != evictionOrder.end() && i->priority > priority; ++i)
+                {
+                    const auto j = frames.find(*i->key);
+                    available += IO::getByteCount(j->second.find(i->frame)->second.image);
+                    if (out)
+                    {
+                        out->push_back(std::make_pair(*i->key, i->frame));
+                    }
+                    if (available >= value)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void FrameCache::Private::remove(const Key& key, Frame::Index frame)
+            {
+                const auto i = frames.find(key);
+                if (i != frames.end())
+                {
+                    const auto j = i->second.find(frame);
+                    if (j != i->second.end())
+                    {
+                        const size_t size = IO::getByteCount(j->second.image);
+#if defined(DJV_MMAP)
+                        if (j->second.image)
+                        {
+                            j->second.image->mmapDontNeed();
+                        }
+#endif // DJV_MMAP
+                        Entry entry;
+                        entry.priority = j->second.priority;
+                        entry.key = &i->first;
+                        entry.frame = frame;
+                        evictionOrder.erase(entry);
+                        byteCount -= size;
+                        byteCounts[key] -= size;
+                        i->second.erase(j);
+                        if (i->second.empty())
+                        {
+                            byteCounts.erase(i->first);
+                            frames.erase(i);
+                        }
+                    }
+                }
+            }
+
+            bool FrameCache::Private::makeRoom(size_t value, int64_t priority)
+            {
+                std::vector<std::pair<Key, Frame::Index> > remove;
+                const bool out = getEvictions(value, priority, &remove);
+                if (out)
+                {
+                    for (const auto& i : remove)
+                    {
+                        this->remove(i.first, i.second);
+                        ++evictions;
+                    }
+                }
+                return out;
+            }
+
+            FrameCache::FrameCache() :
+                _p(new Private)
+            {}
+
+            FrameCache::~FrameCache()
+            {}
+
+            std::shared_ptr<FrameCache> FrameCache::create()
+            {
+                return std::shared_ptr<FrameCache>(new FrameCache);
+            }
+
+            size_t FrameCache::getMaxByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.maxByteCount;
+            }
+
+            void FrameCache::setMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxByteCount = value;
+                p.updateEvictionOrder();
+                while (p.byteCount > p.maxByteCount && !p.evictionOrder.empty())
+                {
+                    const auto& entry = *p.evictionOrder.begin();
+                    const Key key = *entry.key;
+                    p.remove(key, entry.frame);
+                    ++p.evictions;
+                }
+            }
+
+            void FrameCache::setPlayhead(UID uid, const Playhead& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.playheads.find(uid);
+                if (i == p.playheads.end())
+                {
+                    p.dirtyFiles.insert(value.key.fileName);
+                    p.playheads[uid] = value;
+                }
+                else if (i->second != value)
+                {
+                    p.dirtyFiles.insert(i->second.key.fileName);
+                    p.dirtyFiles.insert(value.key.fileName);
+                    i->second = value;
+                }
+            }
+
+            void FrameCache::removePlayhead(UID uid)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.playheads.find(uid);
+                if (i != p.playheads.end())
+                {
+                    p.dirtyFiles.insert(i->second.key.fileName);
+                    p.playheads.erase(i);
+                }
+            }
+
+            size_t FrameCache::getByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.byteCount;
+            }
+
+            size_t FrameCache::getByteCount(const Key& key) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.byteCounts.find(key);
+                return i != p.byteCounts.end() ? i->second : 0;
+            }
+
+            Frame::Sequence FrameCache::getFrames(const Key& key) const
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<Frame::Index> frames;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    const auto i = p.frames.find(key);
+                    if (i != p.frames.end())
+                    {
+                        for (const auto& j : i->second)
+                        {
+                            frames.push_back(j.first);
+                        }
+                    }
+                }
+                return Frame::fromFrames(frames);
+            }
+
+            FrameCacheStats FrameCache::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                FrameCacheStats out;
+                out.byteCount = p.byteCount;
+                out.maxByteCount = p.maxByteCount;
+                out.hits = p.hits;
+                out.misses = p.misses;
+                out.evictions = p.evictions;
+                return out;
+            }
+
+            bool FrameCache::contains(const Key& key, Frame::Index frame) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.frames.find(key);
+                return i != p.frames.end() && i->second.find(frame) != i->second.end();
+            }
+
+            bool FrameCache::canAdd(const Key& key, Frame::Index frame, size_t byteCount) const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                return p.getEvictions(byteCount, p.getPriority(key, frame));
+            }
+
+            bool FrameCache::get(const Key& key, Frame::Index frame, std::shared_ptr<Image::Image>& out)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                bool found = false;
+                const auto i = p.frames.find(key);
+                if (i != p.frames.end())
+                {
+                    const auto j = i->second.find(frame);
+                    if (j != i->second.end())
+                    {
+                        out = j->second.image;
+                        found = true;
+                    }
+                }
+                if (found)
+                {
+                    ++p.hits;
+                }
+                else
+                {
+                    ++p.misses;
+                }
+                return found;
+            }
+
+            bool FrameCache::add(const Key& key, Frame::Index frame, const std::shared_ptr<Image::Image>& image)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.remove(key, frame);
+                const size_t byteCount = IO::getByteCount(image);
+                const int64_t priority = p.getPriority(key, frame);
+                const bool out = p.makeRoom(byteCount, priority);
+                if (out)
+                {
+                    // Rank the other frames of the file before adding this
+                    // one so that it is not ranked twice.
+                    p.updateEvictionOrder();
+                    const auto i = p.frames.insert(std::make_pair(key, std::map<Frame::Index, Private::CacheFrame>())).first;
+                    auto& cacheFrame = i->second[frame];
+                    cacheFrame.image = image;
+                    cacheFrame.priority = priority;
+                    Private::Entry entry;
+                    entry.priority = priority;
+                    entry.key = &i->first;
+                    entry.frame = frame;
+                    p.evictionOrder.insert(entry);
+                    p.byteCounts[key] += byteCount;
+                    p.byteCount += byteCount;
+                }
+                return out;
+            }
+
+            void FrameCache::clear(const Key& key)
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.frames.find(key);
+                if (i != p.frames.end())
+                {
+                    for (const auto& j : i->second)
+                    {
+                        Private::Entry entry;
+                        entry.priority = j.second.priority;
+                        entry.key = &i->first;
+                        entry.frame = j.first;
+                        p.evictionOrder.erase(entry);
+                    }
+                    p.frames.erase(i);
+                }
+                const auto j = p.byteCounts.find(key);
+                if (j != p.byteCounts.end())
+                {
+                    p.byteCount -= j->second;
+                    p.byteCounts.erase(j);
+                }
+            }
+
+            void FrameCache::clear()
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.byteCount = 0;
+                p.byteCounts.clear();
+                p.evictionOrder.clear();
+                p.frames.clear();
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/IO.h>
+
+#include <djvCore/UID.h>
+
+#include <tuple>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides frame cache statistics.
+            class FrameCacheStats
+            {
+            public:
+                FrameCacheStats();
+
+                size_t byteCount    = 0;
+                size_t maxByteCount = 0;
+                size_t hits         = 0;
+                size_t misses       = 0;
+                size_t evictions    = 0;
+
+                float getPercentageUsed() const;
+
+                bool operator == (const FrameCacheStats&) const;
+            };
+
+            //! This class provides a frame cache that is shared by all of the
+            //! readers. Frames are keyed by file name, layer, and frame index,
+            //! and the total size of the cache is limited by a byte budget.
+            //!
+            //! Each reader registers its playhead with the cache. When the
+            //! cache is full the frames that are farthest from a playhead,
+            //! taking into account the playback direction, are evicted first.
+            //! Frames that do not belong to any playhead are evicted before
+            //! all others.
+            //!
+            //! The eviction order is kept sorted as frames are added and
+            //! removed. When a playhead moves only the frames of its file are
+            //! ranked again, the next time the order is needed.
+            class FrameCache : public std::enable_shared_from_this<FrameCache>
+            {
+                DJV_NON_COPYABLE(FrameCache);
+                FrameCache();
+
+            public:
+                ~FrameCache();
+
+                //! Create a new frame cache.
+                static std::shared_ptr<FrameCache> create();
+
+                //! This struct provides a key for the frames of a file layer.
+                struct Key
+                {
+                    Key();
+                    Key(const std::string& fileName, size_t layer, size_t proxy = 0, const Core::BBox2i& roi = Core::BBox2i());
+
+                    std::string  fileName;
+                    size_t       layer    = 0;
+                    size_t       proxy    = 0;
+                    Core::BBox2i roi;
+
+                    bool operator == (const Key&) const;
+                    bool operator < (const Key&) const;
+                };
+
+                //! This struct provides a playhead.
+                struct Playhead
+                {
+                    Key                                    key;
+                    Core::Frame::Index                     frame       = 0;
+                    Direction                              direction   = Direction::Forward;
+                    Core::Range::Range<Core::Frame::Index> range;
+                    size_t                                 readBehind  = 0;
+
+                    //! Other layers of the same file that share the playhead.
+                    std::set<size_t>                       layers;
+
+                    bool operator == (const Playhead&) const;
+                    bool operator != (const Playhead&) const;
+                };
+
+                //! \name Budget
+                ///@{
+
+                size_t getMaxByteCount() const;
+                void setMaxByteCount(size_t);
+
+                ///@}
+
+                //! \name Playheads
+                ///@{
+
+                void setPlayhead(Core::UID, const Playhead&);
+                void removePlayhead(Core::UID);
+
+                ///@}
+
+                //! \name Frames
+                ///@{
+
+                size_t getByteCount() const;
+                size_t getByteCount(const Key&) const;
+                Core::Frame::Sequence getFrames(const Key&) const;
+                FrameCacheStats getStats() const;
+
+                bool contains(const Key&, Core::Frame::Index) const;
+
+                //! Get whether a frame of the given size would be kept by the
+                //! cache, either because there is room or because frames
+                //! with a lower priority can be evicted to make room.
+                bool canAdd(const Key&, Core::Frame::Index, size_t byteCount) const;
+
+                bool get(const Key&, Core::Frame::Index, std::shared_ptr<Image::Image>&);
+
+                //! Add a frame to the cache. Returns false if the frame was
+                //! not added because it has a lower priority than the frames
+                //! already in the cache.
+                bool add(const Key&, Core::Frame::Index, const std::shared_ptr<Image::Image>&);
+
+                void clear(const Key&);
+                void clear();
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/FrameCacheInline.h>
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            inline FrameCacheStats::FrameCacheStats()
+            {}
+
+            inline float FrameCacheStats::getPercentageUsed() const
+            {
+                return maxByteCount ? (byteCount / static_cast<float>(maxByteCount) * 100.F) : 0.F;
+            }
+
+            inline bool FrameCacheStats::operator == (const FrameCacheStats& other) const
+            {
+                return
+                    byteCount == other.byteCount &&
+                    maxByteCount == other.maxByteCount &&
+                    hits == other.hits &&
+                    misses == other.misses &&
+                    evictions == other.evictions;
+            }
+
+            inline FrameCache::Key::Key()
+            {}
+
+            inline FrameCache::Key::Key(const std::string& fileName, size_t layer, size_t proxy, const Core::BBox2i& roi) :
+                fileName(fileName),
+                layer(layer),
+                proxy(proxy),
+                roi(roi)
+            {}
+
+            inline bool FrameCache::Key::operator == (const Key& other) const
+            {
+                return fileName == other.fileName && layer == other.layer && proxy == other.proxy && roi == other.roi;
+            }
+
+            inline bool FrameCache::Key::operator < (const Key& other) const
+            {
+                return
+                    std::tie(fileName, layer, proxy, roi.min.x, roi.min.y, roi.max.x, roi.max.y) <
+                    std::tie(other.fileName, other.layer, other.proxy, other.roi.min.x, other.roi.min.y, other.roi.max.x, other.roi.max.y);
+            }
+
+            inline bool FrameCache::Playhead::operator == (const Playhead& other) const
+            {
+                return
+                    key == other.key &&
+                    frame == other.frame &&
+                    direction == other.direction &&
+                    range == other.range &&
+                    readBehind == other.readBehind &&
+                    layers == other.layers;
+            }
+
+            inline bool FrameCache::Playhead::operator != (const Playhead& other) const
+            {
+                return !(*this == other);
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
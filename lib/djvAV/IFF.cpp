@@ -33,7 +33,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _threadPool, _frameCache, _textSystem, _resourceSystem, _logSystem);
                 }
 
             } // namespace IFF
@@ -41,6 +41,8 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<Core::ThreadPool>&,
+                        const std::shared_ptr<FrameCache>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -79,12 +79,14 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, frameCache, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -6,7 +6,7 @@
 
 #include <djvAV/Cineon.h>
 #include <djvAV/DPX.h>
-#include <djvAV/GLFWSystem.h>
+#include <djvAV/FrameCache.h>
 #include <djvAV/IFF.h>
 #include <djvAV/PPM.h>
 #include <djvAV/RLA.h>
@@ -30,6 +30,7 @@
 #endif // TIFF_FOUND
 
 #include <djvCore/Context.h>
+#include <djvCore/CoreSystem.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/Path.h>
@@ -37,6 +38,7 @@
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/ThreadPool.h>
 
 using namespace djv::Core;
 
@@ -46,74 +48,6 @@ namespace djv
     {
         namespace IO
         {
-            void VideoQueue::setMax(size_t value)
-            {
-                _max = value;
-            }
-
-            void VideoQueue::addFrame(const VideoFrame& value)
-            {
-                _queue.push(value);
-            }
-
-            VideoFrame VideoQueue::popFrame()
-            {
-                VideoFrame out;
-                if (_queue.size())
-                {
-                    out = _queue.front();
-                    _queue.pop();
-                }
-                return out;
-            }
-
-            void VideoQueue::clearFrames()
-            {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
-            }
-
-            void VideoQueue::setFinished(bool value)
-            {
-                _finished = value;
-            }
-
-            void AudioQueue::setMax(size_t value)
-            {
-                _max = value;
-            }
-
-            void AudioQueue::addFrame(const AudioFrame& value)
-            {
-                _queue.push(value);
-            }
-
-            AudioFrame AudioQueue::popFrame()
-            {
-                AudioFrame out;
-                if (_queue.size())
-                {
-                    out = _queue.front();
-                    _queue.pop();
-                }
-                return out;
-            }
-
-            void AudioQueue::clearFrames()
-            {
-                while (_queue.size())
-                {
-                    _queue.pop();
-                }
-            }
-
-            void AudioQueue::setFinished(bool value)
-            {
-                _finished = value;
-            }
-
             void IIO::_init(
                 const FileSystem::FileInfo& fileInfo,
                 const IOOptions& options,
@@ -340,6 +274,11 @@ namespace djv
                 _inOutPoints = value;
             }
             
+            size_t IRead::getProxy(size_t value) const
+            {
+                return hasProxy() ? std::min(value, proxyMax) : 0;
+            }
+
             bool IRead::isCacheEnabled() const
             {
                 return _cacheEnabled;
@@ -405,6 +344,11 @@ namespace djv
                 _logSystem      = context->getSystemT<LogSystem>();
                 _resourceSystem = context->getSystemT<ResourceSystem>();
                 _textSystem     = context->getSystemT<TextSystem>();
+                if (auto system = context->getSystemT<System>())
+                {
+                    _threadPool = system->getThreadPool();
+                    _frameCache = system->getFrameCache();
+                }
                 _pluginName     = pluginName;
                 _pluginInfo     = pluginInfo;
                 _fileExtensions = fileExtensions;
@@ -462,6 +406,8 @@ namespace djv
             struct System::Private
             {
                 std::shared_ptr<TextSystem> textSystem;
+                std::shared_ptr<ThreadPool> threadPool;
+                std::shared_ptr<FrameCache> frameCache;
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
@@ -473,10 +419,18 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
-                addDependency(context->getSystemT<GLFW::System>());
+                addDependency(context->getSystemT<CoreSystem>());
 
                 p.textSystem = context->getSystemT<TextSystem>();
 
+                p.threadPool = ThreadPool::create();
+                {
+                    std::stringstream ss;
+                    ss << "Thread pool size: " << p.threadPool->getThreadCount();
+                    _log(ss.str());
+                }
+                p.frameCache = FrameCache::create();
+
                 p.optionsChanged = ValueSubject<bool>::create();
 
                 p.plugins[Cineon::pluginName] = Cineon::Plugin::create(context);
@@ -664,6 +618,16 @@ namespace djv
                 return out;
             }
 
+            const std::shared_ptr<ThreadPool>& System::getThreadPool() const
+            {
+                return _p->threadPool;
+            }
+
+            const std::shared_ptr<FrameCache>& System::getFrameCache() const
+            {
+                return _p->frameCache;
+            }
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
@@ -8,6 +8,7 @@
 #include <djvAV/Image.h>
 #include <djvAV/Tags.h>
 
+#include <djvCore/BBox.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/ISystem.h>
@@ -16,8 +17,10 @@
 #include <djvCore/Time.h>
 #include <djvCore/ValueObserver.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <future>
-#include <queue>
 #include <mutex>
 #include <set>
 
@@ -28,6 +31,7 @@ namespace djv
         class LogSystem;
         class ResourceSystem;
         class TextSystem;
+        class ThreadPool;
 
     } // namespace Core
 
@@ -85,6 +89,81 @@ namespace djv
                 bool operator == (const Info &) const;
             };
 
+            //! This class provides a bounded lock-free queue of frames for a
+            //! single producer thread and a single consumer thread.
+            //!
+            //! The producer adds frames and sets the finished state, and the
+            //! consumer gets and pops frames. The counts and the finished state
+            //! can be queried from either thread. Clearing the queue can also be
+            //! done from either thread; the cleared frames are released by the
+            //! consumer the next time it pops a frame.
+            template<typename T>
+            class FrameQueue
+            {
+                DJV_NON_COPYABLE(FrameQueue);
+
+            public:
+                FrameQueue();
+
+                size_t getMax() const;
+
+                //! Set the maximum number of frames. The capacity of the queue
+                //! is larger than the maximum so that frames can be added
+                //! before the consumer releases the cleared frames. This
+                //! function is not thread safe.
+                void setMax(size_t);
+
+                bool isEmpty() const;
+                size_t getCount() const;
+
+                //! Get a frame without removing it from the queue, by default
+                //! the first frame. This function should only be called by the
+                //! consumer.
+                T getFrame(size_t index = 0) const;
+
+                //! Add a frame. This function should only be called by the
+                //! producer. Returns false if the queue is full.
+                bool addFrame(const T&);
+
+                //! Pop the first frame. This function should only be called by
+                //! the consumer.
+                T popFrame();
+
+                //! Mark the frames in the queue as stale, for example when
+                //! the consumer requests a seek. The queue appears empty to
+                //! the consumer until the producer calls clearFrames(), so
+                //! frames from before the seek are never returned. This
+                //! function should only be called by the consumer.
+                void invalidateFrames();
+
+                //! Clear the frames and acknowledge any pending
+                //! invalidation. This function should only be called by the
+                //! producer.
+                void clearFrames();
+
+                bool isFinished() const;
+                void setFinished(bool);
+
+                //! Set a callback that is called by the consumer after a frame
+                //! is popped, for example to wake the producer. This function
+                //! is not thread safe.
+                void setPopCallback(const std::function<void(void)>&);
+
+            protected:
+                size_t _getFirst() const;
+                bool _isStale() const;
+
+                size_t _max = 0;
+                std::vector<T> _frames;
+                std::atomic<size_t> _head;
+                std::atomic<size_t> _tail;
+                std::atomic<size_t> _clear;
+                std::atomic<size_t> _epoch;
+                std::atomic<size_t> _clearEpoch;
+                std::atomic<bool> _finished;
+                std::function<void(void)> _popCallback;
+            };
+
             //! This class provides a video frame.
             class VideoFrame
             {
@@ -99,30 +178,13 @@ namespace djv
             };
 
             //! This class provides a queue of video frames.
-            class VideoQueue
+            class VideoQueue : public FrameQueue<VideoFrame>
             {
-                DJV_NON_COPYABLE(VideoQueue);
-
             public:
-                VideoQueue();
-
-                size_t getMax() const;
-                void setMax(size_t);
-
-                bool isEmpty() const;
-                size_t getCount() const;
-                VideoFrame getFrame() const;
-                void addFrame(const VideoFrame&);
-                VideoFrame popFrame();
-                void clearFrames();
-
-                bool isFinished() const;
-                void setFinished(bool);
-
-            private:
-                size_t _max = 0;
-                std::queue<VideoFrame> _queue;
-                bool _finished = false;
+                //! Get the number of the first frame, or Core::Frame::invalid
+                //! if the queue is empty. Unlike getFrame() this function can
+                //! also be called by the producer.
+                Core::Frame::Number getFrameNumber() const;
             };
 
             //! This class provides an audio frame.
@@ -138,32 +200,8 @@ namespace djv
             };
 
             //! This class provides a queue of audio frames.
-            class AudioQueue
-            {
-                DJV_NON_COPYABLE(AudioQueue);
-
-            public:
-                AudioQueue();
-
-                size_t getMax() const;
-                void setMax(size_t);
-
-                bool isEmpty() const;
-                size_t getCount() const;
-                AudioFrame getFrame() const;
-                void addFrame(const AudioFrame &);
-                AudioFrame popFrame();
-                void clearFrames();
-
-                bool isFinished() const;
-                void setFinished(bool);
-
-            private:
-                std::mutex _mutex;
-                size_t _max = 0;
-                std::queue<AudioFrame> _queue;
-                bool _finished = false;
-            };
+            class AudioQueue : public FrameQueue<AudioFrame>
+            {};
 
             //! This class provides I/O options.
             struct IOOptions
@@ -207,11 +245,39 @@ namespace djv
                 size_t _threadCount = 4;
             };
 
+            class FrameCache;
+
+            //! This constant provides the maximum proxy level.
+            const size_t proxyMax = 3;
+
+            //! Get the image size for a proxy level. Each proxy level halves
+            //! the image resolution, rounding up.
+            Image::Size getProxySize(const Image::Size&, size_t proxy);
+
             //! This class provides options for reading.
             struct ReadOptions : IOOptions
             {
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! The requested proxy level, from zero for the full resolution
+                //! up to proxyMax for 1/8 resolution. Readers that cannot read
+                //! a reduced resolution cheaply may ignore it, the proxy level
+                //! of each image is set to the level that was actually read.
+                size_t proxy = 0;
+
+                //! The requested region of interest, in full resolution pixels
+                //! relative to the upper left corner of the image. Readers that
+                //! support it only decode the pixels inside the region and fill
+                //! the rest of the image with zero. An invalid region reads the
+                //! whole image.
+                Core::BBox2i roi;
+
+                //! Additional layers that are decoded in the same pass as the
+                //! current layer and stored in the frame cache, so switching to
+                //! one of them is a cache hit. Readers that cannot decode
+                //! several layers at once ignore it.
+                std::set<size_t> cacheLayers;
             };
 
             //! This class provides playback in/out points.
@@ -303,6 +369,18 @@ namespace djv
                 //! frame number, for audio files it represents the audio sample.
                 virtual void seek(int64_t value, Direction) = 0;
 
+                //! Get whether the reader can read reduced resolution proxy
+                //! images. Otherwise ReadOptions::proxy is ignored.
+                virtual bool hasProxy() const { return false; }
+
+                //! Get the proxy level that the reader uses for the given
+                //! requested proxy level.
+                virtual size_t getProxy(size_t) const;
+
+                //! Get whether the reader can read a region of interest.
+                //! Otherwise ReadOptions::roi is ignored.
+                virtual bool hasROI() const { return false; }
+
                 virtual bool hasCache() const { return false; }
                 bool isCacheEnabled() const;
                 size_t getCacheMaxByteCount() const;
@@ -392,6 +470,8 @@ namespace djv
                 std::shared_ptr<Core::LogSystem> _logSystem;
                 std::shared_ptr<Core::ResourceSystem> _resourceSystem;
                 std::shared_ptr<Core::TextSystem> _textSystem;
+                std::shared_ptr<Core::ThreadPool> _threadPool;
+                std::shared_ptr<FrameCache> _frameCache;
                 std::string _pluginName;
                 std::string _pluginInfo;
                 std::set<std::string> _fileExtensions;
@@ -435,6 +515,12 @@ namespace djv
                 //! - Core::FileSystem::Error
                 std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info &, const WriteOptions& = WriteOptions());
 
+                //! Get the thread pool shared by the readers and writers.
+                const std::shared_ptr<Core::ThreadPool>& getThreadPool() const;
+
+                //! Get the frame cache shared by the readers.
+                const std::shared_ptr<FrameCache>& getFrameCache() const;
+
             private:
                 DJV_PRIVATE();
             };
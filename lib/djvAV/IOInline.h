@@ -8,6 +8,190 @@ namespace djv
     {
         namespace IO
         {
+            inline Image::Size getProxySize(const Image::Size& value, size_t proxy)
+            {
+                const size_t scale = static_cast<size_t>(1) << std::min(proxy, proxyMax);
+                return Image::Size(
+                    static_cast<uint16_t>((value.w + scale - 1) / scale),
+                    static_cast<uint16_t>((value.h + scale - 1) / scale));
+            }
+
+            template<typename T>
+            inline FrameQueue<T>::FrameQueue() :
+                _head(0),
+                _tail(0),
+                _clear(0),
+                _epoch(0),
+                _clearEpoch(0),
+                _finished(false)
+            {
+                setMax(0);
+            }
+
+            template<typename T>
+            inline size_t FrameQueue<T>::getMax() const
+            {
+                return _max;
+            }
+
+            template<typename T>
+            inline void FrameQueue<T>::setMax(size_t value)
+            {
+                _max = value;
+                _frames.clear();
+                _frames.resize(value * 2 + 16);
+                _head = 0;
+                _tail = 0;
+                _clear = 0;
+                _epoch = 0;
+                _clearEpoch = 0;
+            }
+
+            template<typename T>
+            inline bool FrameQueue<T>::isEmpty() const
+            {
+                return 0 == getCount();
+            }
+
+            template<typename T>
+            inline size_t FrameQueue<T>::getCount() const
+            {
+                const size_t first = _getFirst();
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                return tail > first ? (tail - first) : 0;
+            }
+
+            template<typename T>
+            inline T FrameQueue<T>::getFrame(size_t index) const
+            {
+                const size_t i = _getFirst() + index;
+                if (i >= _tail.load(std::memory_order_acquire))
+                {
+                    return T();
+                }
+                T out = _frames[i % _frames.size()];
+
+                // Discard the frame if it was cleared while it was copied.
+                if (_isStale() || _clear.load(std::memory_order_acquire) > i)
+                {
+                    out = T();
+                }
+                return out;
+            }
+
+            template<typename T>
+            inline bool FrameQueue<T>::addFrame(const T& value)
+            {
+                const size_t tail = _tail.load(std::memory_order_relaxed);
+                if (tail - _head.load(std::memory_order_acquire) >= _frames.size())
+                {
+                    return false;
+                }
+                _frames[tail % _frames.size()] = value;
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            template<typename T>
+            inline T FrameQueue<T>::popFrame()
+            {
+                T out;
+                if (_isStale())
+                {
+                    return out;
+                }
+                size_t head = _head.load(std::memory_order_relaxed);
+                const size_t size = _frames.size();
+                bool popped = false;
+                while (!popped)
+                {
+                    // Release the frames that have been cleared.
+                    const size_t clear = _clear.load(std::memory_order_acquire);
+                    for (; head < clear; ++head)
+                    {
+                        T tmp(std::move(_frames[head % size]));
+                    }
+
+                    if (head >= _tail.load(std::memory_order_acquire))
+                    {
+                        break;
+                    }
+                    out = std::move(_frames[head % size]);
+                    ++head;
+                    popped = true;
+
+                    // If the producer cleared the queue while the frame was
+                    // being taken, the frame is from before the clear and is
+                    // discarded.
+                    if (_clear.load(std::memory_order_acquire) >= head)
+                    {
+                        out = T();
+                        popped = false;
+                    }
+                }
+                _head.store(head, std::memory_order_release);
+                if (popped && _popCallback)
+                {
+                    _popCallback();
+                }
+                return out;
+            }
+
+            template<typename T>
+            inline void FrameQueue<T>::invalidateFrames()
+            {
+                _epoch.fetch_add(1, std::memory_order_acq_rel);
+            }
+
+            template<typename T>
+            inline void FrameQueue<T>::clearFrames()
+            {
+                // Load the epoch before clearing so that an invalidation
+                // requested after this point stays pending.
+                const size_t epoch = _epoch.load(std::memory_order_acquire);
+                const size_t tail = _tail.load(std::memory_order_acquire);
+                size_t clear = _clear.load(std::memory_order_relaxed);
+                while (clear < tail && !_clear.compare_exchange_weak(clear, tail))
+                    ;
+                _clearEpoch.store(epoch, std::memory_order_release);
+            }
+
+            template<typename T>
+            inline bool FrameQueue<T>::isFinished() const
+            {
+                return _finished;
+            }
+
+            template<typename T>
+            inline void FrameQueue<T>::setFinished(bool value)
+            {
+                _finished = value;
+            }
+
+            template<typename T>
+            inline void FrameQueue<T>::setPopCallback(const std::function<void(void)>& value)
+            {
+                _popCallback = value;
+            }
+
+            template<typename T>
+            inline size_t FrameQueue<T>::_getFirst() const
+            {
+                if (_isStale())
+                {
+                    return _tail.load(std::memory_order_acquire);
+                }
+                return std::max(
+                    _head.load(std::memory_order_acquire),
+                    _clear.load(std::memory_order_acquire));
+            }
+
+            template<typename T>
+            inline bool FrameQueue<T>::_isStale() const
+            {
+                return _clearEpoch.load(std::memory_order_acquire) != _epoch.load(std::memory_order_acquire);
+            }
+
             inline VideoInfo::VideoInfo()
             {}
 
@@ -84,32 +268,14 @@ namespace djv
                 return frame == other.frame && image == other.image;
             }
 
-            inline VideoQueue::VideoQueue()
-            {}
-
-            inline size_t VideoQueue::getMax() const
-            {
-                return _max;
-            }
-
-            inline bool VideoQueue::isEmpty() const
-            {
-                return 0 == _queue.size();
-            }
-
-            inline size_t VideoQueue::getCount() const
-            {
-                return _queue.size();
-            }
-
-            inline VideoFrame VideoQueue::getFrame() const
-            {
-                return _queue.size() ? _queue.front() : VideoFrame();
-            }
-
-            inline bool VideoQueue::isFinished() const
+            inline Core::Frame::Number VideoQueue::getFrameNumber() const
             {
-                return _finished;
+                // The consumer only moves the image out of a frame so the frame
+                // number can be read safely by the producer.
+                const size_t first = _getFirst();
+                return first < _tail.load(std::memory_order_acquire) ?
+                    _frames[first % _frames.size()].frame :
+                    Core::Frame::invalid;
             }
 
             inline AudioFrame::AudioFrame()
@@ -124,34 +290,6 @@ namespace djv
                 return audio == other.audio;
             }
 
-            inline AudioQueue::AudioQueue()
-            {}
-
-            inline size_t AudioQueue::getMax() const
-            {
-                return _max;
-            }
-
-            inline bool AudioQueue::isEmpty() const
-            {
-                return 0 == _queue.size();
-            }
-
-            inline size_t AudioQueue::getCount() const
-            {
-                return _queue.size();
-            }
-
-            inline bool AudioQueue::isFinished() const
-            {
-                return _finished;
-            }
-
-            inline AudioFrame AudioQueue::getFrame() const
-            {
-                return _queue.size() ? _queue.front() : AudioFrame();
-            }
-
             inline size_t IIO::getThreadCount() const
             {
                 return _threadCount;
@@ -57,6 +57,16 @@ namespace djv
                 _tags = value;
             }
 
+            size_t Image::getProxy() const
+            {
+                return _proxy;
+            }
+
+            void Image::setProxy(size_t value)
+            {
+                _proxy = value;
+            }
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
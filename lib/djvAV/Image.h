@@ -37,9 +37,15 @@ namespace djv
                 const Tags& getTags() const;
                 void setTags(const Tags&);
 
+                //! Get the proxy level. Each proxy level halves the resolution
+                //! of the original image.
+                size_t getProxy() const;
+                void setProxy(size_t);
+
             private:
                 std::string _pluginName;
                 Tags _tags;
+                size_t _proxy = 0;
             };
 
         } // namespace Image
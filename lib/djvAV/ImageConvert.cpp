@@ -14,9 +14,14 @@
 
 #include <djvCore/Context.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/SIMD.h>
+#include <djvCore/ThreadPool.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace djv::Core;
 
 namespace djv
@@ -25,8 +30,142 @@ namespace djv
     {
         namespace Image
         {
+            namespace
+            {
+                //! The number of scanlines that are converted by each job of
+                //! the CPU backend.
+                const uint16_t scanlineTileSize = 64;
+
+                size_t getWordByteCount(Type value)
+                {
+                    return Type::RGB_U10 == value ? 4 : getByteCount(getDataType(value));
+                }
+
+                // The following functions convert the given number of channel
+                // values and produce the same results as the per-channel
+                // conversion functions.
+
+                void scanline_U8_F32(const void* in, void* out, size_t size)
+                {
+                    const U8_T* inP = reinterpret_cast<const U8_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    size_t i = 0;
+#if defined(DJV_SSE2)
+                    const __m128 max = _mm_set1_ps(static_cast<float>(U8Range.max));
+                    const __m128i zero = _mm_setzero_si128();
+                    for (; i + 16 <= size; i += 16, inP += 16, outP += 16)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP));
+                        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                        _mm_storeu_ps(outP,      _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), max));
+                        _mm_storeu_ps(outP + 4,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), max));
+                        _mm_storeu_ps(outP + 8,  _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), max));
+                        _mm_storeu_ps(outP + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), max));
+                    }
+#endif // DJV_SSE2
+                    for (; i < size; ++i, ++inP, ++outP)
+                    {
+                        convert_U8_F32(*inP, *outP);
+                    }
+                }
+
+                void scanline_U16_F32(const void* in, void* out, size_t size)
+                {
+                    const U16_T* inP = reinterpret_cast<const U16_T*>(in);
+                    F32_T* outP = reinterpret_cast<F32_T*>(out);
+                    size_t i = 0;
+#if defined(DJV_SSE2)
+                    const __m128 max = _mm_set1_ps(static_cast<float>(U16Range.max));
+                    const __m128i zero = _mm_setzero_si128();
+                    for (; i + 8 <= size; i += 8, inP += 8, outP += 8)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP));
+                        _mm_storeu_ps(outP,     _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), max));
+                        _mm_storeu_ps(outP + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), max));
+                    }
+#endif // DJV_SSE2
+                    for (; i < size; ++i, ++inP, ++outP)
+                    {
+                        convert_U16_F32(*inP, *outP);
+                    }
+                }
+
+                void scanline_F32_U8(const void* in, void* out, size_t size)
+                {
+                    const F32_T* inP = reinterpret_cast<const F32_T*>(in);
+                    U8_T* outP = reinterpret_cast<U8_T*>(out);
+                    size_t i = 0;
+#if defined(DJV_SSE2)
+                    const __m128 max = _mm_set1_ps(static_cast<float>(U8Range.max));
+                    for (; i + 16 <= size; i += 16, inP += 16, outP += 16)
+                    {
+                        const __m128i a = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(inP),      max));
+                        const __m128i b = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(inP + 4),  max));
+                        const __m128i c = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(inP + 8),  max));
+                        const __m128i d = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(inP + 12), max));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(outP),
+                            _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+                    }
+#endif // DJV_SSE2
+                    for (; i < size; ++i, ++inP, ++outP)
+                    {
+                        convert_F32_U8(*inP, *outP);
+                    }
+                }
+
+                //! Get a function for converting scanlines, using the vectorized
+                //! functions when they are available.
+                ConvertFunction getScanlineFunction(Type inType, Type outType)
+                {
+                    ConvertFunction out;
+                    const size_t channelCount = getChannelCount(inType);
+                    if (inType == outType)
+                    {
+                        const size_t byteCount = getByteCount(inType);
+                        out = [byteCount](const void* inP, void* outP, size_t size)
+                        {
+                            memcpy(outP, inP, size * byteCount);
+                        };
+                    }
+                    else if (getChannels(inType) == getChannels(outType) && Type::RGB_U10 != inType && Type::RGB_U10 != outType)
+                    {
+                        void (*function)(const void*, void*, size_t) = nullptr;
+                        switch (getDataType(inType))
+                        {
+                        case DataType::U8:
+                            function = DataType::F32 == getDataType(outType) ? scanline_U8_F32 : nullptr;
+                            break;
+                        case DataType::U16:
+                            function = DataType::F32 == getDataType(outType) ? scanline_U16_F32 : nullptr;
+                            break;
+                        case DataType::F32:
+                            function = DataType::U8 == getDataType(outType) ? scanline_F32_U8 : nullptr;
+                            break;
+                        default: break;
+                        }
+                        if (function)
+                        {
+                            out = [function, channelCount](const void* inP, void* outP, size_t size)
+                            {
+                                function(inP, outP, size * channelCount);
+                            };
+                        }
+                    }
+                    if (!out)
+                    {
+                        out = getConvertFunction(inType, outType);
+                    }
+                    return out;
+                }
+
+            } // namespace
+
             struct Convert::Private
             {
+                ConvertBackend backend = ConvertBackend::OpenGL;
+                std::shared_ptr<ThreadPool> threadPool;
                 Size size;
                 Mirror mirror;
                 std::shared_ptr<OpenGL::OffscreenBuffer> offscreenBuffer;
@@ -37,13 +176,21 @@ namespace djv
                 glm::mat4x4 mvp = glm::mat4x4(1.F);
             };
 
-            void Convert::_init(const std::shared_ptr<ResourceSystem>& resourceSystem)
+            void Convert::_init(
+                const std::shared_ptr<ResourceSystem>& resourceSystem,
+                ConvertBackend backend,
+                const std::shared_ptr<ThreadPool>& threadPool)
             {
                 DJV_PRIVATE_PTR();
-                const FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
-                p.shader = AV::OpenGL::Shader::create(Render::Shader::create(
-                    FileSystem::Path(shaderPath, "djvAVImageConvertVertex.glsl"),
-                    FileSystem::Path(shaderPath, "djvAVImageConvertFragment.glsl")));
+                p.backend = backend;
+                p.threadPool = threadPool;
+                if (ConvertBackend::OpenGL == backend)
+                {
+                    const FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
+                    p.shader = AV::OpenGL::Shader::create(Render::Shader::create(
+                        FileSystem::Path(shaderPath, "djvAVImageConvertVertex.glsl"),
+                        FileSystem::Path(shaderPath, "djvAVImageConvertFragment.glsl")));
+                }
             }
 
             Convert::Convert() :
@@ -53,14 +200,32 @@ namespace djv
             Convert::~Convert()
             {}
 
-            std::shared_ptr<Convert> Convert::create(const std::shared_ptr<ResourceSystem>& resourceSystem)
+            std::shared_ptr<Convert> Convert::create(
+                const std::shared_ptr<ResourceSystem>& resourceSystem,
+                ConvertBackend backend,
+                const std::shared_ptr<ThreadPool>& threadPool)
             {
                 auto out = std::shared_ptr<Convert>(new Convert);
-                out->_init(resourceSystem);
+                out->_init(resourceSystem, backend, threadPool);
                 return out;
             }
 
+            ConvertBackend Convert::getBackend() const
+            {
+                return _p->backend;
+            }
+
             void Convert::process(const Data& data, const Info& info, Data& out)
+            {
+                switch (_p->backend)
+                {
+                case ConvertBackend::OpenGL: _processGL(data, info, out); break;
+                case ConvertBackend::CPU: _processCPU(data, info, out); break;
+                default: break;
+                }
+            }
+
+            void Convert::_processGL(const Data& data, const Info& info, Data& out)
             {
                 DJV_PRIVATE_PTR();
                 bool create = !p.offscreenBuffer;
@@ -150,6 +315,121 @@ namespace djv
                     out.getData());
             }
 
+            void Convert::_processCPU(const Data& data, const Info& info, Data& out)
+            {
+                DJV_PRIVATE_PTR();
+                const Info& inInfo = data.getInfo();
+                const auto function = getScanlineFunction(inInfo.type, info.type);
+                if (!function || !inInfo.isValid() || !info.isValid())
+                {
+                    return;
+                }
+
+                const uint16_t inW = inInfo.size.w;
+                const uint16_t inH = inInfo.size.h;
+                const uint16_t w = info.size.w;
+                const uint16_t h = info.size.h;
+                const bool resize = inInfo.size != info.size;
+                const Mirror mirror(
+                    inInfo.layout.mirror.x != info.layout.mirror.x,
+                    inInfo.layout.mirror.y != info.layout.mirror.y);
+                const size_t inPixelByteCount = inInfo.getPixelByteCount();
+                const size_t inWordByteCount = getWordByteCount(inInfo.type);
+                const size_t outPixelByteCount = info.getPixelByteCount();
+                const size_t outWordByteCount = getWordByteCount(info.type);
+                const bool inEndian = inInfo.layout.endian != Memory::getEndian() && inWordByteCount > 1;
+                const bool outEndian = info.layout.endian != Memory::getEndian() && outWordByteCount > 1;
+                const size_t outScanlineByteCount = info.getScanlineByteCount();
+                uint8_t* outData = out.getData();
+
+                auto scanlines = [&](uint16_t y0, uint16_t y1)
+                {
+                    std::vector<uint8_t> inTmp;
+                    std::vector<uint8_t> outTmp;
+                    if (resize || mirror.x || inEndian)
+                    {
+                        inTmp.resize(w * inPixelByteCount);
+                    }
+                    if (outEndian)
+                    {
+                        outTmp.resize(w * outPixelByteCount);
+                    }
+                    for (uint16_t y = y0; y < y1; ++y)
+                    {
+                        uint16_t inY = resize ? static_cast<uint16_t>(y * static_cast<size_t>(inH) / h) : y;
+                        if (mirror.y)
+                        {
+                            inY = inH - 1 - inY;
+                        }
+                        const uint8_t* inP = data.getData(inY);
+                        if (resize || mirror.x)
+                        {
+                            uint8_t* tmpP = inTmp.data();
+                            for (uint16_t x = 0; x < w; ++x, tmpP += inPixelByteCount)
+                            {
+                                uint16_t inX = resize ? static_cast<uint16_t>(x * static_cast<size_t>(inW) / w) : x;
+                                if (mirror.x)
+                                {
+                                    inX = inW - 1 - inX;
+                                }
+                                memcpy(tmpP, inP + inX * inPixelByteCount, inPixelByteCount);
+                            }
+                            inP = inTmp.data();
+                        }
+                        if (inEndian)
+                        {
+                            const size_t wordCount = w * inPixelByteCount / inWordByteCount;
+                            if (inP == inTmp.data())
+                            {
+                                Memory::endian(inTmp.data(), wordCount, inWordByteCount);
+                            }
+                            else
+                            {
+                                Memory::endian(inP, inTmp.data(), wordCount, inWordByteCount);
+                            }
+                            inP = inTmp.data();
+                        }
+                        uint8_t* outP = outData + y * outScanlineByteCount;
+                        if (outEndian)
+                        {
+                            function(inP, outTmp.data(), w);
+                            Memory::endian(outTmp.data(), outP, w * outPixelByteCount / outWordByteCount, outWordByteCount);
+                        }
+                        else
+                        {
+                            function(inP, outP, w);
+                        }
+                    }
+                };
+
+                const size_t tileCount = (h + scanlineTileSize - 1) / scanlineTileSize;
+                if (p.threadPool && tileCount > 1)
+                {
+                    // The calling thread converts tiles along with the thread
+                    // pool, so the conversion finishes even if the pool is busy.
+                    p.threadPool->parallelFor(
+                        tileCount,
+                        [&scanlines, h](size_t i)
+                        {
+                            const size_t y = i * scanlineTileSize;
+                            scanlines(
+                                static_cast<uint16_t>(y),
+                                static_cast<uint16_t>(std::min(y + scanlineTileSize, static_cast<size_t>(h))));
+                        });
+                }
+                else
+                {
+                    scanlines(0, h);
+                }
+            }
+
         } // namespace Image
     } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        ConvertBackend,
+        DJV_TEXT("av_image_convert_backend_opengl"),
+        DJV_TEXT("av_image_convert_backend_cpu"));
+
 } // namespace djv
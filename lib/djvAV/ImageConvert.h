@@ -11,6 +11,7 @@ namespace djv
     namespace Core
     {
         class ResourceSystem;
+        class ThreadPool;
 
     } // namespace Core
 
@@ -18,33 +19,65 @@ namespace djv
     {
         namespace Image
         {
+            //! This enumeration provides the image conversion backends.
+            enum class ConvertBackend
+            {
+                OpenGL,
+                CPU,
+
+                Count,
+                First = OpenGL
+            };
+            DJV_ENUM_HELPERS(ConvertBackend);
+
             //! This class provides image data conversion.
+            //!
+            //! The OpenGL backend draws the image into an offscreen buffer and
+            //! requires an OpenGL context. The CPU backend does not require an
+            //! OpenGL context; it converts the image in tiles of scanlines which
+            //! are distributed across the threads of the given thread pool.
+            //! Note that the CPU backend uses nearest neighbor sampling when the
+            //! image is resized.
             class Convert
             {
                 DJV_NON_COPYABLE(Convert);
 
             protected:
-                void _init(const std::shared_ptr<Core::ResourceSystem>&);
+                void _init(
+                    const std::shared_ptr<Core::ResourceSystem>&,
+                    ConvertBackend,
+                    const std::shared_ptr<Core::ThreadPool>&);
                 Convert();
 
             public:
                 ~Convert();
 
-                //! Note that this function requires an OpenGL context.
+                //! Note that the OpenGL backend requires an OpenGL context.
                 //! Throws:
                 //! - OpenGL::ShaderError
                 //! - Render::ShaderError
-                static std::shared_ptr<Convert> create(const std::shared_ptr<Core::ResourceSystem>&);
+                static std::shared_ptr<Convert> create(
+                    const std::shared_ptr<Core::ResourceSystem>&,
+                    ConvertBackend = ConvertBackend::OpenGL,
+                    const std::shared_ptr<Core::ThreadPool>& = nullptr);
 
-                //! Note that this function requires an OpenGL context.
+                ConvertBackend getBackend() const;
+
+                //! Note that the OpenGL backend requires an OpenGL context.
                 //! Throws:
                 //! - OpenGL::OffscreenBufferError
                 void process(const Data&, const Info&, Data&);
 
             private:
+                void _processGL(const Data&, const Info&, Data&);
+                void _processCPU(const Data&, const Info&, Data&);
+
                 DJV_PRIVATE();
             };
 
         } // namespace Image
     } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::ConvertBackend);
+
 } // namespace djv
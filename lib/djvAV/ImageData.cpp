@@ -20,15 +20,24 @@ namespace djv
                 _scanlineByteCount = info.getScanlineByteCount();
                 _dataByteCount = info.getDataByteCount();
 #if defined(DJV_MMAP)
-                _fileIO = fileIO;
-                if (_fileIO)
+                if (fileIO && fileIO->mmapP() &&
+                    static_cast<size_t>(fileIO->mmapEnd() - fileIO->mmapP()) >= _dataByteCount)
                 {
+                    // Start reading the pages in the background, the data is
+                    // typically used soon after it is mapped.
+                    _fileIO = fileIO;
+                    _fileIO->mmapWillNeed();
                     _p = _fileIO->mmapP();
                 }
                 else if (_dataByteCount)
                 {
                     _data = new uint8_t[_dataByteCount];
                     _p = _data;
+                    if (fileIO && fileIO->mmapP())
+                    {
+                        // The file is too short to be mapped, copy what is there.
+                        memcpy(_data, fileIO->mmapP(), fileIO->mmapEnd() - fileIO->mmapP());
+                    }
                 }
 #else // DJV_MMAP
                 if (_dataByteCount)
@@ -60,13 +69,14 @@ namespace djv
             }
 #endif // DJV_MMAP
 
+            void Data::resetUID()
+            {
+                _uid = Core::createUID();
+            }
+
             size_t Data::getDataByteCount() const
             {
-#if defined(DJV_MMAP)
-                return _fileIO ? (_fileIO->getSize() - _fileIO->getPos()) : _dataByteCount;
-#else
                 return _dataByteCount;
-#endif // DJV_MMAP
             }
 
             void Data::zero()
@@ -78,14 +88,39 @@ namespace djv
             }
 
 #if defined(DJV_MMAP)
+            bool Data::isMapped() const
+            {
+                return _fileIO && !_data;
+            }
+
+            void Data::mmapWillNeed()
+            {
+                if (isMapped())
+                {
+                    _fileIO->mmapWillNeed();
+                }
+            }
+
+            void Data::mmapDontNeed()
+            {
+                if (isMapped())
+                {
+                    _fileIO->mmapDontNeed();
+                }
+            }
+
             void Data::detach()
             {
-                if (_fileIO)
+                if (isMapped())
                 {
-                    _data = new uint8_t[_dataByteCount];
-                    memcpy(_data, _fileIO->mmapP(), std::min(_fileIO->getSize() - _fileIO->getPos(), _dataByteCount));
-                    _p = _data;
-                    _fileIO.reset();
+                    std::lock_guard<std::mutex> lock(_detachMutex);
+                    if (!_data)
+                    {
+                        uint8_t* data = new uint8_t[_dataByteCount];
+                        memcpy(data, _p, _dataByteCount);
+                        _data = data;
+                        _p = data;
+                    }
                 }
             }
 #endif // DJV_MMAP
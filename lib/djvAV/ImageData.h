@@ -10,7 +10,9 @@
 #include <djvCore/PicoJSON.h>
 #include <djvCore/UID.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace djv
 {
@@ -121,6 +123,11 @@ namespace djv
 
                 Core::UID getUID() const;
 
+                //! Give the data a new unique ID. This is used when the data
+                //! is recycled for a different image, so that caches keyed by
+                //! the ID do not return the previous contents.
+                void resetUID();
+
                 const Info& getInfo() const;
                 const Size& getSize() const;
                 uint16_t getWidth() const;
@@ -147,6 +154,26 @@ namespace djv
                 void zero();
 
 #if defined(DJV_MMAP)
+                //! Get whether the data is memory mapped from a file.
+                bool isMapped() const;
+
+                //! Advise the operating system that the memory mapped data will
+                //! be needed soon.
+                void mmapWillNeed();
+
+                //! Advise the operating system that the memory mapped data is no
+                //! longer needed. The data is still valid and will be read again
+                //! from the file if it is used.
+                void mmapDontNeed();
+
+                //! Copy memory mapped data so that it can be modified. The file
+                //! stays mapped until the data is destroyed, so pointers returned
+                //! by the const getData() functions remain valid.
+                //!
+                //! Mapped data may be shared between threads by the frame cache,
+                //! so the copy is made only once even when several threads call
+                //! the non-const getData() functions at the same time. Modifying
+                //! shared data is still not thread safe.
                 void detach();
 #endif // DJV_MMAP
 
@@ -159,10 +186,14 @@ namespace djv
                 uint8_t _pixelByteCount = 0;
                 size_t _scanlineByteCount = 0;
                 size_t _dataByteCount = 0;
-                uint8_t* _data = nullptr;
-                const uint8_t* _p = nullptr;
 #if defined(DJV_MMAP)
+                std::atomic<uint8_t*> _data { nullptr };
+                std::atomic<const uint8_t*> _p { nullptr };
                 std::shared_ptr<Core::FileSystem::FileIO> _fileIO;
+                std::mutex _detachMutex;
+#else // DJV_MMAP
+                uint8_t* _data = nullptr;
+                const uint8_t* _p = nullptr;
 #endif // DJV_MMAP
             };
 
@@ -0,0 +1,357 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ImageScopes.h>
+
+#include <djvCore/SIMD.h>
+#include <djvCore/ThreadPool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                // The Rec. 709 luma and chroma coefficients.
+                const float lumaR    = .2126F;
+                const float lumaG    = .7152F;
+                const float lumaB    = .0722F;
+                const float cbFactor = 1.F / 1.8556F;
+                const float crFactor = 1.F / 1.5748F;
+
+                //! This struct provides the mapping from values to bins.
+                struct Bins
+                {
+                    size_t histogramBins   = 0;
+                    bool   histogramLog    = false;
+                    float  histogramMin    = 0.F;
+                    float  histogramScale  = 0.F;
+                    size_t waveformSize    = 0;
+                    size_t vectorscopeSize = 0;
+
+                    size_t getHistogramBin(float value) const
+                    {
+                        if (histogramLog)
+                        {
+                            value = value > 0.F ? std::log2(value) : histogramMin;
+                        }
+                        return getBin((value - histogramMin) * histogramScale, histogramBins);
+                    }
+
+                    static size_t getBin(float value, size_t size)
+                    {
+                        // Note that NaN values are mapped to the first bin.
+                        const float max = static_cast<float>(size - 1);
+                        return static_cast<size_t>(value > 0.F ? (value < max ? value : max) : 0.F);
+                    }
+                };
+
+                //! This struct provides the scopes that are accumulated by
+                //! each job.
+                struct Accumulator
+                {
+                    std::vector<uint32_t> histogram;
+                    std::vector<uint32_t> waveform;
+                    std::vector<uint32_t> vectorscope;
+                };
+
+                //! Accumulate RGBA floating point pixels.
+                void accumulate(
+                    const float* p,
+                    size_t size,
+                    const uint32_t* columns,
+                    const std::vector<size_t>& channels,
+                    const Bins& bins,
+                    Accumulator& out)
+                {
+                    uint32_t* histogram = out.histogram.data();
+                    uint32_t* waveform = out.waveform.data();
+                    uint32_t* vectorscope = out.vectorscope.data();
+                    const size_t histogramBins = bins.histogramBins;
+                    const size_t channelCount = channels.size();
+                    const size_t waveformSize = bins.waveformSize;
+                    const size_t vectorscopeSize = bins.vectorscopeSize;
+                    size_t i = 0;
+#if defined(DJV_SSE2)
+                    // Transpose four pixels into vectors of channels and compute
+                    // the bins for all of them at once.
+                    const __m128 zero = _mm_setzero_ps();
+                    const __m128 half = _mm_set1_ps(.5F);
+                    const __m128 kr = _mm_set1_ps(lumaR);
+                    const __m128 kg = _mm_set1_ps(lumaG);
+                    const __m128 kb = _mm_set1_ps(lumaB);
+                    const __m128 kcb = _mm_set1_ps(cbFactor);
+                    const __m128 kcr = _mm_set1_ps(crFactor);
+                    const __m128 histogramMin = _mm_set1_ps(bins.histogramMin);
+                    const __m128 histogramScale = _mm_set1_ps(bins.histogramScale);
+                    const __m128 histogramMax = _mm_set1_ps(static_cast<float>(histogramBins - 1));
+                    const __m128 waveformScale = _mm_set1_ps(static_cast<float>(waveformSize));
+                    const __m128 waveformMax = _mm_set1_ps(static_cast<float>(waveformSize - 1));
+                    const __m128 vectorscopeScale = _mm_set1_ps(static_cast<float>(vectorscopeSize));
+                    const __m128 vectorscopeMax = _mm_set1_ps(static_cast<float>(vectorscopeSize - 1));
+                    alignas(16) int32_t histogramBin[4][4];
+                    alignas(16) int32_t waveformBin[4];
+                    alignas(16) int32_t cbBin[4];
+                    alignas(16) int32_t crBin[4];
+                    for (; i + 4 <= size; i += 4, p += 16)
+                    {
+                        __m128 c[4] =
+                        {
+                            _mm_loadu_ps(p),
+                            _mm_loadu_ps(p + 4),
+                            _mm_loadu_ps(p + 8),
+                            _mm_loadu_ps(p + 12)
+                        };
+                        _MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+                        if (!bins.histogramLog)
+                        {
+                            for (size_t j = 0; j < channelCount; ++j)
+                            {
+                                const __m128 v = _mm_mul_ps(_mm_sub_ps(c[channels[j]], histogramMin), histogramScale);
+                                _mm_store_si128(
+                                    reinterpret_cast<__m128i*>(histogramBin[j]),
+                                    _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, zero), histogramMax)));
+                            }
+                        }
+                        const __m128 y = _mm_add_ps(
+                            _mm_add_ps(_mm_mul_ps(c[0], kr), _mm_mul_ps(c[1], kg)),
+                            _mm_mul_ps(c[2], kb));
+                        const __m128 cb = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(c[2], y), kcb), half);
+                        const __m128 cr = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(c[0], y), kcr), half);
+                        _mm_store_si128(
+                            reinterpret_cast<__m128i*>(waveformBin),
+                            _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(y, waveformScale), zero), waveformMax)));
+                        _mm_store_si128(
+                            reinterpret_cast<__m128i*>(cbBin),
+                            _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(cb, vectorscopeScale), zero), vectorscopeMax)));
+                        _mm_store_si128(
+                            reinterpret_cast<__m128i*>(crBin),
+                            _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(cr, vectorscopeScale), zero), vectorscopeMax)));
+
+                        for (size_t k = 0; k < 4; ++k)
+                        {
+                            for (size_t j = 0; j < channelCount; ++j)
+                            {
+                                const size_t bin = bins.histogramLog ?
+                                    bins.getHistogramBin(p[k * 4 + channels[j]]) :
+                                    static_cast<size_t>(histogramBin[j][k]);
+                                ++histogram[j * histogramBins + bin];
+                            }
+                            ++waveform[columns[i + k] * waveformSize + waveformBin[k]];
+                            ++vectorscope[crBin[k] * vectorscopeSize + cbBin[k]];
+                        }
+                    }
+#endif // DJV_SSE2
+                    for (; i < size; ++i, p += 4)
+                    {
+                        for (size_t j = 0; j < channelCount; ++j)
+                        {
+                            ++histogram[j * histogramBins + bins.getHistogramBin(p[channels[j]])];
+                        }
+                        const float y = p[0] * lumaR + p[1] * lumaG + p[2] * lumaB;
+                        const float cb = (p[2] - y) * cbFactor + .5F;
+                        const float cr = (p[0] - y) * crFactor + .5F;
+                        ++waveform[columns[i] * waveformSize + Bins::getBin(y * waveformSize, waveformSize)];
+                        ++vectorscope[
+                            Bins::getBin(cr * vectorscopeSize, vectorscopeSize) * vectorscopeSize +
+                            Bins::getBin(cb * vectorscopeSize, vectorscopeSize)];
+                    }
+                }
+
+                //! Get the RGBA channels that have histograms.
+                std::vector<size_t> getHistogramChannels(Type type)
+                {
+                    std::vector<size_t> out;
+                    switch (getChannels(type))
+                    {
+                    case Channels::L:    out = { 0 };          break;
+                    case Channels::LA:   out = { 0, 3 };       break;
+                    case Channels::RGB:  out = { 0, 1, 2 };    break;
+                    case Channels::RGBA: out = { 0, 1, 2, 3 }; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+            } // namespace
+
+            ScopesOptions::ScopesOptions()
+            {}
+
+            bool ScopesOptions::operator == (const ScopesOptions& other) const
+            {
+                return
+                    histogramBins == other.histogramBins &&
+                    histogramScale == other.histogramScale &&
+                    histogramRange == other.histogramRange &&
+                    histogramLogRange == other.histogramLogRange &&
+                    waveformSize == other.waveformSize &&
+                    vectorscopeSize == other.vectorscopeSize &&
+                    sampleMax == other.sampleMax;
+            }
+
+            bool ScopesOptions::operator != (const ScopesOptions& other) const
+            {
+                return !(*this == other);
+            }
+
+            Scopes::Scopes()
+            {}
+
+            size_t getScopesSampleStride(const Size& size, size_t sampleMax)
+            {
+                size_t out = 1;
+                const size_t pixelCount = static_cast<size_t>(size.w) * static_cast<size_t>(size.h);
+                if (sampleMax > 0 && pixelCount > sampleMax)
+                {
+                    out = static_cast<size_t>(std::ceil(std::sqrt(pixelCount / static_cast<double>(sampleMax))));
+                }
+                return out;
+            }
+
+            std::shared_ptr<Scopes> computeScopes(
+                const Data& data,
+                const ScopesOptions& options,
+                const std::shared_ptr<ThreadPool>& threadPool,
+                ThreadPool::Priority priority)
+            {
+                auto out = std::shared_ptr<Scopes>(new Scopes);
+                out->options = options;
+                out->options.histogramBins = std::max(options.histogramBins, static_cast<size_t>(1));
+                out->options.waveformSize = std::max(options.waveformSize, static_cast<size_t>(1));
+                out->options.vectorscopeSize = std::max(options.vectorscopeSize, static_cast<size_t>(1));
+                const Info& info = data.getInfo();
+                out->info = info;
+                const std::vector<size_t> channels = getHistogramChannels(info.type);
+                out->histogramChannelCount = channels.size();
+                out->histogram.resize(channels.size() * out->options.histogramBins, 0);
+                out->waveform.resize(out->options.waveformSize * out->options.waveformSize, 0);
+                out->vectorscope.resize(out->options.vectorscopeSize * out->options.vectorscopeSize, 0);
+                if (!info.isValid() || channels.empty())
+                {
+                    return out;
+                }
+
+                Bins bins;
+                bins.histogramBins = out->options.histogramBins;
+                const bool log = isFloatType(info.type) && HistogramScale::Log == options.histogramScale;
+                const FloatRange& histogramRange = log ? options.histogramLogRange : options.histogramRange;
+                const float histogramRangeSize = histogramRange.max - histogramRange.min;
+                bins.histogramLog = log;
+                bins.histogramMin = histogramRange.min;
+                bins.histogramScale = histogramRangeSize > 0.F ? (bins.histogramBins / histogramRangeSize) : 0.F;
+                bins.waveformSize = out->options.waveformSize;
+                bins.vectorscopeSize = out->options.vectorscopeSize;
+
+                // Decimate large images by sampling every Nth pixel of every Nth
+                // scanline.
+                const size_t stride = getScopesSampleStride(info.size, options.sampleMax);
+                const uint16_t w = info.size.w;
+                const uint16_t h = info.size.h;
+                const size_t sampleW = (w + stride - 1) / stride;
+                const size_t sampleH = (h + stride - 1) / stride;
+                out->sampleStride = stride;
+                out->sampleCount = sampleW * sampleH;
+                std::vector<uint32_t> columns(sampleW);
+                for (size_t i = 0; i < sampleW; ++i)
+                {
+                    const size_t x = info.layout.mirror.x ? (w - 1 - i * stride) : (i * stride);
+                    columns[i] = static_cast<uint32_t>(x * bins.waveformSize / w);
+                }
+
+                const Type tmpType = Type::RGBA_F32;
+                ConvertFunction convert;
+                if (info.type != tmpType)
+                {
+                    convert = getConvertFunction(info.type, tmpType);
+                }
+                const size_t pixelByteCount = info.getPixelByteCount();
+
+                // Each job accumulates a range of scanlines into its own scopes,
+                // which are added together at the end.
+                const size_t jobCount = threadPool ?
+                    std::max(std::min(threadPool->getThreadCount() + 1, sampleH), static_cast<size_t>(1)) :
+                    1;
+                std::vector<Accumulator> accumulators(jobCount);
+                auto job = [&](size_t index)
+                {
+                    Accumulator& accumulator = accumulators[index];
+                    accumulator.histogram.resize(out->histogram.size(), 0);
+                    accumulator.waveform.resize(out->waveform.size(), 0);
+                    accumulator.vectorscope.resize(out->vectorscope.size(), 0);
+                    std::vector<uint8_t> samples(stride > 1 ? sampleW * pixelByteCount : 0);
+                    std::vector<float> tmp(sampleW * 4);
+                    const size_t y0 = index * sampleH / jobCount;
+                    const size_t y1 = (index + 1) * sampleH / jobCount;
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        const uint8_t* p = data.getData(static_cast<uint16_t>(y * stride));
+                        if (stride > 1)
+                        {
+                            uint8_t* samplesP = samples.data();
+                            for (size_t x = 0; x < sampleW; ++x, samplesP += pixelByteCount)
+                            {
+                                memcpy(samplesP, p + x * stride * pixelByteCount, pixelByteCount);
+                            }
+                            p = samples.data();
+                        }
+                        if (convert)
+                        {
+                            convert(p, tmp.data(), sampleW);
+                        }
+                        else
+                        {
+                            memcpy(tmp.data(), p, tmp.size() * sizeof(float));
+                        }
+                        accumulate(tmp.data(), sampleW, columns.data(), channels, bins, accumulator);
+                    }
+                };
+                if (threadPool)
+                {
+                    threadPool->parallelFor(jobCount, job, priority);
+                }
+                else
+                {
+                    job(0);
+                }
+
+                for (const auto& i : accumulators)
+                {
+                    for (size_t j = 0; j < out->histogram.size(); ++j)
+                    {
+                        out->histogram[j] += i.histogram[j];
+                    }
+                    for (size_t j = 0; j < out->waveform.size(); ++j)
+                    {
+                        out->waveform[j] += i.waveform[j];
+                    }
+                    for (size_t j = 0; j < out->vectorscope.size(); ++j)
+                    {
+                        out->vectorscope[j] += i.vectorscope[j];
+                    }
+                }
+                out->histogramMax = *std::max_element(out->histogram.begin(), out->histogram.end());
+                out->waveformMax = *std::max_element(out->waveform.begin(), out->waveform.end());
+                out->vectorscopeMax = *std::max_element(out->vectorscope.begin(), out->vectorscope.end());
+                return out;
+            }
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        HistogramScale,
+        DJV_TEXT("av_image_histogram_scale_linear"),
+        DJV_TEXT("av_image_histogram_scale_log"));
+
+} // namespace djv
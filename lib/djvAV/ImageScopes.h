@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+
+#include <djvCore/Range.h>
+#include <djvCore/ThreadPool.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This enumeration provides the histogram scales for floating
+            //! point images.
+            enum class HistogramScale
+            {
+                Linear,
+                Log,
+
+                Count,
+                First = Linear
+            };
+            DJV_ENUM_HELPERS(HistogramScale);
+
+            //! This class provides the image scopes options.
+            class ScopesOptions
+            {
+            public:
+                ScopesOptions();
+
+                //! The number of histogram bins.
+                size_t histogramBins = 256;
+
+                //! The histogram scale, integer images always use the linear
+                //! scale.
+                HistogramScale histogramScale = HistogramScale::Linear;
+
+                //! The histogram range for the linear scale.
+                Core::FloatRange histogramRange = Core::FloatRange(0.F, 1.F);
+
+                //! The histogram range in stops for the log scale.
+                Core::FloatRange histogramLogRange = Core::FloatRange(-12.F, 4.F);
+
+                //! The number of waveform columns and levels.
+                size_t waveformSize = 256;
+
+                //! The width and height of the vectorscope.
+                size_t vectorscopeSize = 256;
+
+                //! The maximum number of pixels that are sampled. Larger images
+                //! are decimated, zero samples every pixel.
+                size_t sampleMax = 512 * 512;
+
+                bool operator == (const ScopesOptions&) const;
+                bool operator != (const ScopesOptions&) const;
+            };
+
+            //! This class provides image scopes.
+            class Scopes
+            {
+            public:
+                Scopes();
+
+                ScopesOptions options;
+                Info          info;
+
+                //! The distance between the sampled pixels.
+                size_t sampleStride = 1;
+                size_t sampleCount  = 0;
+
+                //! The histograms of each channel of the image, with the bins
+                //! of each channel stored consecutively.
+                size_t                histogramChannelCount = 0;
+                std::vector<uint32_t> histogram;
+                uint32_t              histogramMax          = 0;
+
+                //! The luma waveform, with the columns of the image mapped to
+                //! the waveform columns and the levels stored consecutively for
+                //! each column, from low to high.
+                std::vector<uint32_t> waveform;
+                uint32_t              waveformMax = 0;
+
+                //! The YCbCr vectorscope, with Cb increasing from left to right
+                //! and Cr increasing from bottom to top.
+                std::vector<uint32_t> vectorscope;
+                uint32_t              vectorscopeMax = 0;
+            };
+
+            //! Get the distance between the pixels that are sampled for an
+            //! image of the given size.
+            size_t getScopesSampleStride(const Size&, size_t sampleMax);
+
+            //! Compute the scopes of an image. The pixels are converted to
+            //! floating point and accumulated in tiles of scanlines, which are
+            //! distributed across the threads of the given thread pool and
+            //! merged when they are finished. The tiles are computed with the
+            //! given priority, which should match the priority of the calling
+            //! job.
+            std::shared_ptr<Scopes> computeScopes(
+                const Data&,
+                const ScopesOptions& = ScopesOptions(),
+                const std::shared_ptr<Core::ThreadPool>& = nullptr,
+                Core::ThreadPool::Priority = Core::ThreadPool::Priority::High);
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::HistogramScale);
+
+} // namespace djv
@@ -60,17 +60,21 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const std::shared_ptr<Core::ThreadPool>&,
+                        const std::shared_ptr<FrameCache>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    bool hasProxy() const override { return true; }
+
                 protected:
                     Info _readInfo(const std::string& fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string& fileName) override;
 
                 private:
                     class File;
-                    Info _open(const std::string&, const std::shared_ptr<File>&);
+                    Info _open(const std::string&, const std::shared_ptr<File>&, size_t proxy);
                 };
                 
                 //! This class provides the JPEG file writer.
@@ -89,6 +93,7 @@ namespace djv
                         const Info&,
                         const WriteOptions&,
                         const Options&,
+                        const std::shared_ptr<Core::ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
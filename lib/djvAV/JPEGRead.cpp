@@ -66,19 +66,21 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, frameCache, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
                 Info Read::_readInfo(const std::string& fileName)
                 {
                     auto f = File::create();
-                    return _open(fileName, f);
+                    return _open(fileName, f, 0);
                 }
 
                 namespace
@@ -118,11 +120,13 @@ namespace djv
                 {
                     // Open the file.
                     auto f = File::create();
-                    const auto info = _open(fileName, f);
+                    const size_t proxy = std::min(_options.proxy, proxyMax);
+                    const auto info = _open(fileName, f, proxy);
 
                     // Read the file.
                     auto out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
+                    out->setProxy(proxy);
                     for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
                     {
                         if (!jpegScanline(&f->jpeg, out->getData(y), &f->jpegError))
@@ -179,6 +183,7 @@ namespace djv
 
                     bool jpegOpen(
                         FILE*                   f,
+                        size_t                  proxy,
                         jpeg_decompress_struct* jpeg,
                         JPEGErrorStruct*        error)
                     {
@@ -192,6 +197,10 @@ namespace djv
                         {
                             return false;
                         }
+                        // Let the decoder scale the image down in the IDCT
+                        // instead of decoding the full resolution.
+                        jpeg->scale_num = 1;
+                        jpeg->scale_denom = 1 << proxy;
                         if (!jpeg_start_decompress(jpeg))
                         {
                             return false;
@@ -201,7 +210,7 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f)
+                Info Read::_open(const std::string& fileName, const std::shared_ptr<File>& f, size_t proxy)
                 {
                     f->jpeg.err = jpeg_std_error(&f->jpegError.pub);
                     f->jpegError.pub.error_exit = djvJPEGError;
@@ -226,7 +235,7 @@ namespace djv
                             arg(fileName).
                             arg(_textSystem->getText(DJV_TEXT("error_file_open"))));
                     }
-                    if (!jpegOpen(f->f, &f->jpeg, &f->jpegError))
+                    if (!jpegOpen(f->f, proxy, &f->jpeg, &f->jpegError))
                     {
                         std::vector<std::string> messages;
                         messages.push_back(String::Format("{0}: {1}").
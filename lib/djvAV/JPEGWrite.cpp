@@ -40,13 +40,14 @@ namespace djv
                     const Info& info,
                     const WriteOptions& writeOptions,
                     const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Write>(new Write);
                     out->_p->options = options;
-                    out->_init(fileInfo, info, writeOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, info, writeOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
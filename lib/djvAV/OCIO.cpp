@@ -4,6 +4,8 @@
 
 #include <djvAV/OCIO.h>
 
+#include <djvCore/Memory.h>
+
 #include <tuple>
 
 using namespace djv::Core;
@@ -65,3 +67,15 @@ namespace djv
     } // namespace AV
 } // namespace djv
 
+namespace std
+{
+    std::size_t hash<djv::AV::OCIO::Convert>::operator() (const djv::AV::OCIO::Convert& value) const noexcept
+    {
+        size_t hash = 0;
+        djv::Core::Memory::hashCombine<std::string>(hash, value.input);
+        djv::Core::Memory::hashCombine<std::string>(hash, value.output);
+        return hash;
+    }
+
+} // namespace std
+
@@ -61,3 +61,13 @@ namespace djv
         } // namespace OCIO
     } // namespace AV
 } // namespace djv
+
+namespace std
+{
+    template<>
+    struct hash<djv::AV::OCIO::Convert>
+    {
+        std::size_t operator() (const djv::AV::OCIO::Convert&) const noexcept;
+    };
+
+} // namespace std
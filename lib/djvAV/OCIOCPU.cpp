@@ -0,0 +1,395 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/OCIOCPU.h>
+
+#include <djvCore/SIMD.h>
+#include <djvCore/ThreadPool.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+using namespace djv::Core;
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OCIO
+        {
+            namespace
+            {
+                //! The number of scanlines that are converted by each job.
+                const uint16_t scanlineTileSize = 64;
+
+                //! This struct provides the mapping from color values to lookup
+                //! table coordinates. It is derived from the allocation of the
+                //! input color space, the same way OpenColorIO maps values for
+                //! the lookup tables of the GPU path.
+                struct Shaper
+                {
+                    bool  lg2    = false;
+                    float min    = 0.F;
+                    float max    = 1.F;
+                    float offset = 0.F;
+
+                    float toLUT(float value) const
+                    {
+                        if (lg2)
+                        {
+                            value = std::log2(std::max(value + offset, FLT_MIN));
+                        }
+                        const float out = (value - min) / (max - min);
+                        // Note that NaN values are mapped to zero.
+                        return out > 0.F ? (out < 1.F ? out : 1.F) : 0.F;
+                    }
+
+                    float fromLUT(float value) const
+                    {
+                        const float out = min + value * (max - min);
+                        return lg2 ? (std::exp2(out) - offset) : out;
+                    }
+                };
+
+                Shaper getShaper(const _OCIO::ConstConfigRcPtr& config, const std::string& colorSpaceName)
+                {
+                    Shaper out;
+                    if (auto colorSpace = config->getColorSpace(colorSpaceName.c_str()))
+                    {
+                        out.lg2 = _OCIO::ALLOCATION_LG2 == colorSpace->getAllocation();
+                        if (out.lg2)
+                        {
+                            out.min = -10.F;
+                            out.max = 6.F;
+                        }
+                        const int varCount = colorSpace->getAllocationNumVars();
+                        if (varCount >= 2 && varCount <= 3)
+                        {
+                            float vars[3] = { 0.F, 0.F, 0.F };
+                            colorSpace->getAllocationVars(vars);
+                            out.min = vars[0];
+                            out.max = vars[1];
+                            out.offset = vars[2];
+                        }
+                        if (out.max <= out.min)
+                        {
+                            out = Shaper();
+                        }
+                    }
+                    return out;
+                }
+
+                //! Apply a lookup table with tetrahedral interpolation. The lookup
+                //! table entries are padded to four values so that they can be
+                //! loaded into vector registers.
+                void applyLUT(
+                    const float* lut,
+                    size_t size,
+                    const Shaper& shaper,
+                    float* p,
+                    size_t pixelCount,
+                    size_t channelCount)
+                {
+                    const float scale = static_cast<float>(size - 1);
+                    const size_t strideR = 4;
+                    const size_t strideG = 4 * size;
+                    const size_t strideB = 4 * size * size;
+                    for (size_t i = 0; i < pixelCount; ++i, p += channelCount)
+                    {
+                        const float r = shaper.toLUT(p[0]) * scale;
+                        const float g = shaper.toLUT(p[1]) * scale;
+                        const float b = shaper.toLUT(p[2]) * scale;
+                        const size_t ri = std::min(static_cast<size_t>(r), size - 2);
+                        const size_t gi = std::min(static_cast<size_t>(g), size - 2);
+                        const size_t bi = std::min(static_cast<size_t>(b), size - 2);
+                        const float fr = r - ri;
+                        const float fg = g - gi;
+                        const float fb = b - bi;
+
+                        // Find the tetrahedron that contains the value, it is
+                        // the path from the first corner of the cell to the
+                        // last corner along the axes in the order of the
+                        // largest fractions.
+                        const float* c000 = lut + ri * strideR + gi * strideG + bi * strideB;
+                        const float* c111 = c000 + strideR + strideG + strideB;
+                        const float* c1 = nullptr;
+                        const float* c2 = nullptr;
+                        float w0 = 0.F;
+                        float w1 = 0.F;
+                        float w2 = 0.F;
+                        float w3 = 0.F;
+                        if (fr > fg)
+                        {
+                            if (fg > fb)
+                            {
+                                c1 = c000 + strideR;
+                                c2 = c000 + strideR + strideG;
+                                w0 = 1.F - fr; w1 = fr - fg; w2 = fg - fb; w3 = fb;
+                            }
+                            else if (fr > fb)
+                            {
+                                c1 = c000 + strideR;
+                                c2 = c000 + strideR + strideB;
+                                w0 = 1.F - fr; w1 = fr - fb; w2 = fb - fg; w3 = fg;
+                            }
+                            else
+                            {
+                                c1 = c000 + strideB;
+                                c2 = c000 + strideR + strideB;
+                                w0 = 1.F - fb; w1 = fb - fr; w2 = fr - fg; w3 = fg;
+                            }
+                        }
+                        else
+                        {
+                            if (fb > fg)
+                            {
+                                c1 = c000 + strideB;
+                                c2 = c000 + strideG + strideB;
+                                w0 = 1.F - fb; w1 = fb - fg; w2 = fg - fr; w3 = fr;
+                            }
+                            else if (fb > fr)
+                            {
+                                c1 = c000 + strideG;
+                                c2 = c000 + strideG + strideB;
+                                w0 = 1.F - fg; w1 = fg - fb; w2 = fb - fr; w3 = fr;
+                            }
+                            else
+                            {
+                                c1 = c000 + strideG;
+                                c2 = c000 + strideR + strideG;
+                                w0 = 1.F - fg; w1 = fg - fr; w2 = fr - fb; w3 = fb;
+                            }
+                        }
+
+#if defined(DJV_SSE2)
+                        const __m128 v = _mm_add_ps(
+                            _mm_add_ps(
+                                _mm_mul_ps(_mm_loadu_ps(c000), _mm_set1_ps(w0)),
+                                _mm_mul_ps(_mm_loadu_ps(c1), _mm_set1_ps(w1))),
+                            _mm_add_ps(
+                                _mm_mul_ps(_mm_loadu_ps(c2), _mm_set1_ps(w2)),
+                                _mm_mul_ps(_mm_loadu_ps(c111), _mm_set1_ps(w3))));
+                        float tmp[4];
+                        _mm_storeu_ps(tmp, v);
+                        p[0] = tmp[0];
+                        p[1] = tmp[1];
+                        p[2] = tmp[2];
+#else // DJV_SSE2
+                        for (size_t j = 0; j < 3; ++j)
+                        {
+                            p[j] = c000[j] * w0 + c1[j] * w1 + c2[j] * w2 + c111[j] * w3;
+                        }
+#endif // DJV_SSE2
+                    }
+                }
+
+            } // namespace
+
+            struct CPUProcessor::Private
+            {
+                Convert convert;
+                CPUMethod method = CPUMethod::LUT;
+                size_t lutSize = 0;
+                std::shared_ptr<ThreadPool> threadPool;
+                _OCIO::ConstProcessorRcPtr processor;
+                Shaper shaper;
+                std::vector<float> lut;
+            };
+
+            void CPUProcessor::_init(
+                const Convert& convert,
+                CPUMethod method,
+                size_t lutSize,
+                const std::shared_ptr<ThreadPool>& threadPool)
+            {
+                DJV_PRIVATE_PTR();
+                p.convert = convert;
+                p.method = method;
+                p.lutSize = std::max(lutSize, static_cast<size_t>(2));
+                p.threadPool = threadPool;
+
+                auto config = _OCIO::GetCurrentConfig();
+                p.processor = config->getProcessor(convert.input.c_str(), convert.output.c_str());
+                if (CPUMethod::LUT == method)
+                {
+                    // Bake the lookup table by converting the lattice values, one
+                    // slice of blue values at a time.
+                    p.shaper = getShaper(config, convert.input);
+                    const size_t size = p.lutSize;
+                    p.lut.resize(4 * size * size * size);
+                    auto slice = [this, size](size_t b)
+                    {
+                        DJV_PRIVATE_PTR();
+                        float* data = p.lut.data() + 4 * size * size * b;
+                        float* d = data;
+                        for (size_t g = 0; g < size; ++g)
+                        {
+                            for (size_t r = 0; r < size; ++r, d += 4)
+                            {
+                                d[0] = p.shaper.fromLUT(r / static_cast<float>(size - 1));
+                                d[1] = p.shaper.fromLUT(g / static_cast<float>(size - 1));
+                                d[2] = p.shaper.fromLUT(b / static_cast<float>(size - 1));
+                                d[3] = 1.F;
+                            }
+                        }
+                        _OCIO::PackedImageDesc desc(data, static_cast<long>(size * size), 1, 4);
+                        p.processor->apply(desc);
+                    };
+                    if (p.threadPool)
+                    {
+                        p.threadPool->parallelFor(size, slice);
+                    }
+                    else
+                    {
+                        for (size_t b = 0; b < size; ++b)
+                        {
+                            slice(b);
+                        }
+                    }
+                }
+            }
+
+            CPUProcessor::CPUProcessor() :
+                _p(new Private)
+            {}
+
+            CPUProcessor::~CPUProcessor()
+            {}
+
+            std::shared_ptr<CPUProcessor> CPUProcessor::create(
+                const Convert& convert,
+                CPUMethod method,
+                size_t lutSize,
+                const std::shared_ptr<ThreadPool>& threadPool)
+            {
+                auto out = std::shared_ptr<CPUProcessor>(new CPUProcessor);
+                out->_init(convert, method, lutSize, threadPool);
+                return out;
+            }
+
+            const Convert& CPUProcessor::getConvert() const
+            {
+                return _p->convert;
+            }
+
+            CPUMethod CPUProcessor::getMethod() const
+            {
+                return _p->method;
+            }
+
+            size_t CPUProcessor::getLUTSize() const
+            {
+                return _p->lutSize;
+            }
+
+            void CPUProcessor::apply(float* data, size_t pixelCount, size_t channelCount) const
+            {
+                DJV_PRIVATE_PTR();
+                if (!pixelCount || channelCount < 3 || channelCount > 4)
+                {
+                    return;
+                }
+                switch (p.method)
+                {
+                case CPUMethod::Processor:
+                {
+                    _OCIO::PackedImageDesc desc(
+                        data,
+                        static_cast<long>(pixelCount),
+                        1,
+                        static_cast<long>(channelCount));
+                    p.processor->apply(desc);
+                    break;
+                }
+                case CPUMethod::LUT:
+                    applyLUT(p.lut.data(), p.lutSize, p.shaper, data, pixelCount, channelCount);
+                    break;
+                default: break;
+                }
+            }
+
+            void CPUProcessor::apply(const Image::Data& in, Image::Data& out) const
+            {
+                DJV_PRIVATE_PTR();
+                const Image::Info& inInfo = in.getInfo();
+                const Image::Info& outInfo = out.getInfo();
+                if (!inInfo.isValid() || inInfo.size != outInfo.size)
+                {
+                    return;
+                }
+
+                // The scanlines are converted to RGBA floating point values
+                // before they are processed.
+                const Image::Type tmpType = Image::Type::RGBA_F32;
+                Image::ConvertFunction inFunction;
+                Image::ConvertFunction outFunction;
+                if (inInfo.type != tmpType)
+                {
+                    inFunction = Image::getConvertFunction(inInfo.type, tmpType);
+                }
+                if (outInfo.type != tmpType)
+                {
+                    outFunction = Image::getConvertFunction(tmpType, outInfo.type);
+                }
+                const uint16_t w = inInfo.size.w;
+                const uint16_t h = inInfo.size.h;
+                auto scanlines = [this, &in, &out, &inFunction, &outFunction, w](uint16_t y0, uint16_t y1)
+                {
+                    std::vector<float> tmp(static_cast<size_t>(w) * 4);
+                    for (uint16_t y = y0; y < y1; ++y)
+                    {
+                        if (inFunction)
+                        {
+                            inFunction(in.getData(y), tmp.data(), w);
+                        }
+                        else
+                        {
+                            memcpy(tmp.data(), in.getData(y), tmp.size() * sizeof(float));
+                        }
+                        apply(tmp.data(), w, 4);
+                        if (outFunction)
+                        {
+                            outFunction(tmp.data(), out.getData(y), w);
+                        }
+                        else
+                        {
+                            memcpy(out.getData(y), tmp.data(), tmp.size() * sizeof(float));
+                        }
+                    }
+                };
+
+                const size_t tileCount = (h + scanlineTileSize - 1) / scanlineTileSize;
+                if (p.threadPool && tileCount > 1)
+                {
+                    p.threadPool->parallelFor(
+                        tileCount,
+                        [&scanlines, h](size_t i)
+                        {
+                            const size_t y = i * scanlineTileSize;
+                            scanlines(
+                                static_cast<uint16_t>(y),
+                                static_cast<uint16_t>(std::min(y + scanlineTileSize, static_cast<size_t>(h))));
+                        });
+                }
+                else
+                {
+                    scanlines(0, h);
+                }
+            }
+
+        } // namespace OCIO
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::OCIO,
+        CPUMethod,
+        DJV_TEXT("av_ocio_cpu_method_processor"),
+        DJV_TEXT("av_ocio_cpu_method_lut"));
+
+} // namespace djv
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+#include <djvAV/OCIOLUT.h>
+
+namespace djv
+{
+    namespace Core
+    {
+        class ThreadPool;
+
+    } // namespace Core
+
+    namespace AV
+    {
+        namespace OCIO
+        {
+            //! This enumeration provides the methods for applying color space
+            //! conversions on the CPU.
+            enum class CPUMethod
+            {
+                Processor,
+                LUT,
+
+                Count,
+                First = Processor
+            };
+            DJV_ENUM_HELPERS(CPUMethod);
+
+            //! This class provides color space conversions on the CPU, for
+            //! when there is no OpenGL context or the results are needed in
+            //! memory.
+            //!
+            //! The processor method applies the conversion with the OpenColorIO
+            //! CPU processor. The lookup table method bakes a 3D lookup table
+            //! over the allocation of the input color space, the same domain as
+            //! the lookup table used by Render2D, and applies it with
+            //! tetrahedral interpolation. It is faster than the processor and
+            //! matches the images drawn with OpenGL more closely.
+            //!
+            //! Images are converted in tiles of scanlines which are distributed
+            //! across the threads of the given thread pool.
+            class CPUProcessor
+            {
+                DJV_NON_COPYABLE(CPUProcessor);
+
+            protected:
+                void _init(
+                    const Convert&,
+                    CPUMethod,
+                    size_t lutSize,
+                    const std::shared_ptr<Core::ThreadPool>&);
+                CPUProcessor();
+
+            public:
+                ~CPUProcessor();
+
+                //! Create a new processor with the current configuration.
+                //! Throws:
+                //! - std::exception
+                static std::shared_ptr<CPUProcessor> create(
+                    const Convert&,
+                    CPUMethod = CPUMethod::LUT,
+                    size_t lutSize = lutSizeDefault,
+                    const std::shared_ptr<Core::ThreadPool>& = nullptr);
+
+                const Convert& getConvert() const;
+                CPUMethod getMethod() const;
+                size_t getLUTSize() const;
+
+                //! Convert pixels in place. The channel count must be three or
+                //! four, the fourth channel is not changed.
+                void apply(float*, size_t pixelCount, size_t channelCount = 3) const;
+
+                //! Convert an image. The output must be the same size as the
+                //! input, though the types may be different. The alpha channel
+                //! is passed through and the images should have the native
+                //! endian.
+                void apply(const Image::Data&, Image::Data&) const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace OCIO
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::OCIO::CPUMethod);
+
+} // namespace djv
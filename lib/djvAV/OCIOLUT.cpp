@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/OCIOLUT.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+using namespace djv::Core;
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OCIO
+        {
+            namespace
+            {
+                const uint32_t lutFileMagic   = 0x4c555433; // "LUT3"
+                const uint32_t lutFileVersion = 1;
+                const uint32_t lutSizeMax     = 256;
+
+                std::string readString(const std::shared_ptr<FileSystem::FileIO>& io)
+                {
+                    uint32_t size = 0;
+                    io->readU32(&size);
+                    if (size > io->getSize() - io->getPos())
+                    {
+                        throw FileSystem::Error(io->getFileName());
+                    }
+                    std::string out(size, 0);
+                    io->read(&out[0], size);
+                    return out;
+                }
+
+                void writeString(const std::shared_ptr<FileSystem::FileIO>& io, const std::string& value)
+                {
+                    io->writeU32(static_cast<uint32_t>(value.size()));
+                    io->write(value.data(), value.size());
+                }
+
+            } // namespace
+
+            LUT::LUT()
+            {}
+
+            std::string getCurrentConfigID()
+            {
+                return _OCIO::GetCurrentConfig()->getCacheID();
+            }
+
+            std::string getLUTKey(const std::string& configID, const Convert& convert, size_t size)
+            {
+                std::stringstream ss;
+                ss << configID << "\n" << convert.input << "\n" << convert.output << "\n" << size;
+                return ss.str();
+            }
+
+            std::string getLUTFileName(const std::string& key)
+            {
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(16) << std::hash<std::string>()(key) << ".lut";
+                return ss.str();
+            }
+
+            std::shared_ptr<LUT> bakeLUT(const Convert& convert, size_t size)
+            {
+                auto out = std::shared_ptr<LUT>(new LUT);
+                auto config = _OCIO::GetCurrentConfig();
+                out->configID = config->getCacheID();
+                out->convert = convert;
+                out->size = size;
+                auto processor = config->getProcessor(convert.input.c_str(), convert.output.c_str());
+                _OCIO::GpuShaderDesc shaderDesc;
+                shaderDesc.setLanguage(_OCIO::GPU_LANGUAGE_GLSL_1_3);
+                shaderDesc.setFunctionName(lutFunctionName.c_str());
+                shaderDesc.setLut3DEdgeLen(static_cast<int>(size));
+                out->shaderSource = processor->getGpuShaderText(shaderDesc);
+                out->data.resize(3 * size * size * size);
+                processor->getGpuLut3D(out->data.data(), shaderDesc);
+                return out;
+            }
+
+            std::shared_ptr<LUT> readLUT(const std::string& fileName, const std::string& key)
+            {
+                std::shared_ptr<LUT> out;
+                try
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    uint32_t magic = 0;
+                    uint32_t version = 0;
+                    io->readU32(&magic);
+                    io->readU32(&version);
+                    if (magic == lutFileMagic && version == lutFileVersion && readString(io) == key)
+                    {
+                        auto lut = std::shared_ptr<LUT>(new LUT);
+                        lut->configID = readString(io);
+                        lut->convert.input = readString(io);
+                        lut->convert.output = readString(io);
+                        uint32_t size = 0;
+                        io->readU32(&size);
+                        if (size <= lutSizeMax)
+                        {
+                            lut->size = size;
+                            lut->shaderSource = readString(io);
+                            lut->data.resize(3 * lut->size * lut->size * lut->size);
+                            io->readF32(lut->data.data(), lut->data.size());
+                            out = lut;
+                        }
+                    }
+                }
+                catch (const std::exception&)
+                {}
+                return out;
+            }
+
+            void writeLUT(const std::string& fileName, const std::string& key, const LUT& value)
+            {
+                // Write to a temporary file first so that a partially written file
+                // is never read.
+                const std::string tmpFileName = fileName + ".tmp";
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(tmpFileName, FileSystem::FileIO::Mode::Write);
+                    io->writeU32(lutFileMagic);
+                    io->writeU32(lutFileVersion);
+                    writeString(io, key);
+                    writeString(io, value.configID);
+                    writeString(io, value.convert.input);
+                    writeString(io, value.convert.output);
+                    io->writeU32(static_cast<uint32_t>(value.size));
+                    writeString(io, value.shaderSource);
+                    io->writeF32(value.data.data(), value.data.size());
+                }
+                std::remove(fileName.c_str());
+                if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                {
+                    std::remove(tmpFileName.c_str());
+                    throw FileSystem::Error(fileName);
+                }
+            }
+
+            void pruneLUTCache(const std::string& path, uint64_t maxByteCount)
+            {
+                FileSystem::DirectoryListOptions options;
+                options.fileExtensions.insert(".lut");
+                options.stat = true;
+                auto fileInfos = FileSystem::FileInfo::directoryList(FileSystem::Path(path), options);
+                std::stable_sort(
+                    fileInfos.begin(),
+                    fileInfos.end(),
+                    [](const FileSystem::FileInfo& a, const FileSystem::FileInfo& b)
+                    {
+                        return a.getTime() < b.getTime();
+                    });
+                uint64_t byteCount = 0;
+                for (const auto& i : fileInfos)
+                {
+                    byteCount += i.getSize();
+                }
+                for (auto i = fileInfos.begin(); i != fileInfos.end() && byteCount > maxByteCount; ++i)
+                {
+                    if (0 == std::remove(i->getFileName().c_str()))
+                    {
+                        byteCount -= i->getSize();
+                    }
+                }
+            }
+
+        } // namespace OCIO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/OCIO.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OCIO
+        {
+            //! This constant provides the default 3D lookup table size.
+            const size_t lutSizeDefault = 32;
+
+            //! This constant provides the name of the shader function in baked
+            //! lookup tables, it should be replaced with a unique name before
+            //! the shader source is used.
+            const std::string lutFunctionName = "djvOCIOLUT";
+
+            //! This class provides a 3D lookup table baked from a color space
+            //! conversion, with the GLSL shader source that applies it.
+            class LUT
+            {
+            public:
+                LUT();
+
+                std::string        configID;
+                Convert            convert;
+                size_t             size = 0;
+                std::string        shaderSource;
+
+                //! The lookup table data with RGB values and red changing
+                //! fastest.
+                std::vector<float> data;
+            };
+
+            //! Get the ID of the current configuration.
+            //! Throws:
+            //! - std::exception
+            std::string getCurrentConfigID();
+
+            //! Get the key that identifies a lookup table.
+            std::string getLUTKey(const std::string& configID, const Convert&, size_t size);
+
+            //! Get the file name used to cache a lookup table on disk.
+            std::string getLUTFileName(const std::string& key);
+
+            //! Bake a lookup table with the current configuration.
+            //! Throws:
+            //! - std::exception
+            std::shared_ptr<LUT> bakeLUT(const Convert&, size_t size);
+
+            //! Read a lookup table from a file. Returns null if the file cannot
+            //! be read or it was written for a different key.
+            std::shared_ptr<LUT> readLUT(const std::string& fileName, const std::string& key);
+
+            //! Write a lookup table to a file.
+            //! Throws:
+            //! - std::exception
+            void writeLUT(const std::string& fileName, const std::string& key, const LUT&);
+
+            //! Remove the oldest lookup table files from a cache directory until
+            //! the total size is less than or equal to the given byte count.
+            //! Files for configurations that are no longer used are not written
+            //! again, so they are removed first.
+            void pruneLUTCache(const std::string& path, uint64_t maxByteCount);
+
+        } // namespace OCIO
+    } // namespace AV
+} // namespace djv
@@ -8,6 +8,8 @@
 #include <ImfStandardAttributes.h>
 #include <ImfThreading.h>
 
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -576,6 +578,32 @@ namespace djv
                         glm::ivec2(channel.xSampling, channel.ySampling));
                 }
 
+                Imf::Compression toImf(Compression value)
+                {
+                    Imf::Compression out = Imf::NO_COMPRESSION;
+                    switch (value)
+                    {
+                    case Compression::RLE:   out = Imf::RLE_COMPRESSION;   break;
+                    case Compression::ZIPS:  out = Imf::ZIPS_COMPRESSION;  break;
+                    case Compression::ZIP:   out = Imf::ZIP_COMPRESSION;   break;
+                    case Compression::PIZ:   out = Imf::PIZ_COMPRESSION;   break;
+                    case Compression::PXR24: out = Imf::PXR24_COMPRESSION; break;
+                    case Compression::B44:   out = Imf::B44_COMPRESSION;   break;
+                    case Compression::B44A:  out = Imf::B44A_COMPRESSION;  break;
+                    case Compression::DWAA:  out = Imf::DWAA_COMPRESSION;  break;
+                    case Compression::DWAB:  out = Imf::DWAB_COMPRESSION;  break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                size_t getGlobalThreadCount(const Options& value)
+                {
+                    return value.threadCount > 0 ?
+                        value.threadCount :
+                        std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+                }
+
                 struct Plugin::Private
                 {
                     Options options;
@@ -588,7 +616,7 @@ namespace djv
                 std::shared_ptr<Plugin> Plugin::create(const std::shared_ptr<Context>& context)
                 {
                     auto out = std::shared_ptr<Plugin>(new Plugin);
-                    Imf::setGlobalThreadCount(out->_p->options.threadCount);
+                    Imf::setGlobalThreadCount(getGlobalThreadCount(out->_p->options));
                     out->_init(
                         pluginName,
                         DJV_TEXT("plugin_openexr_io"),
@@ -606,17 +634,17 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     fromJSON(value, p.options);
-                    Imf::setGlobalThreadCount(p.options.threadCount);
+                    Imf::setGlobalThreadCount(getGlobalThreadCount(p.options));
                 }
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _p->options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _threadPool, _frameCache, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
                 {
-                    return Write::create(fileInfo, info, options, _p->options, _textSystem, _resourceSystem, _logSystem);
+                    return Write::create(fileInfo, info, options, _p->options, _threadPool, _textSystem, _resourceSystem, _logSystem);
                 }
 
             } // namespace OpenEXR
@@ -660,6 +688,8 @@ namespace djv
                 out.get<picojson::object>()["Compression"] = picojson::value(ss.str());
             }
             out.get<picojson::object>()["DWACompressionLevel"] = toJSON(value.dwaCompressionLevel);
+            out.get<picojson::object>()["Tiled"] = toJSON(value.tiled);
+            out.get<picojson::object>()["TileSize"] = toJSON(value.tileSize);
         }
         return out;
     }
@@ -688,6 +718,14 @@ namespace djv
                 {
                     fromJSON(i.second, out.dwaCompressionLevel);
                 }
+                else if ("Tiled" == i.first)
+                {
+                    fromJSON(i.second, out.tiled);
+                }
+                else if ("TileSize" == i.first)
+                {
+                    fromJSON(i.second, out.tileSize);
+                }
             }
         }
         else
@@ -10,6 +10,7 @@
 
 #include <ImathBox.h>
 #include <ImfChannelList.h>
+#include <ImfCompression.h>
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
 #include <ImfPixelType.h>
@@ -119,15 +120,24 @@ namespace djv
                 //! Convert from an Imf channel.
                 Channel fromImf(const std::string& name, const Imf::Channel&);
 
+                //! Convert to an Imf compression type.
+                Imf::Compression toImf(Compression);
+
                 //! This struct provides the OpenEXR file I/O optioms.
                 struct Options
                 {
-                    size_t      threadCount         = 4;
+                    size_t      threadCount         = 0;
                     Channels    channels            = Channels::Known;
                     Compression compression         = Compression::None;
                     float       dwaCompressionLevel = 45.F;
+                    bool        tiled               = false;
+                    size_t      tileSize            = 64;
                 };
 
+                //! Get the size of the Imf global thread pool. A thread count of
+                //! zero uses the number of hardware threads.
+                size_t getGlobalThreadCount(const Options&);
+
                 //! This class provides a memory-mapped input stream.
                 class MemoryMappedIStream : public Imf::IStream
                 {
@@ -162,17 +172,29 @@ namespace djv
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
                         const Options&,
+                        const std::shared_ptr<Core::ThreadPool>&,
+                        const std::shared_ptr<FrameCache>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    bool hasProxy() const override;
+                    size_t getProxy(size_t) const override;
+                    bool hasROI() const override { return true; }
+
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    std::vector<std::shared_ptr<Image::Image> > _readLayers(
+                        const std::string & fileName,
+                        const std::vector<size_t>& layers) override;
 
                 private:
                     struct File;
+                    struct LayerImage;
                     Info _open(const std::string &, File &);
+                    void _readWindow(const std::string&, File&, std::vector<LayerImage>&);
+                    void _readLevel(const std::string&, File&, std::vector<LayerImage>&);
 
                     DJV_PRIVATE();
                 };
@@ -193,6 +215,7 @@ namespace djv
                         const Info&,
                         const WriteOptions&,
                         const Options&,
+                        const std::shared_ptr<Core::ThreadPool>&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -13,6 +13,8 @@
 #include <ImfHeader.h>
 #include <ImfInputFile.h>
 #include <ImfRgbaYca.h>
+#include <ImfTestFile.h>
+#include <ImfTiledInputFile.h>
 
 using namespace djv::Core;
 
@@ -99,11 +101,26 @@ namespace djv
                     BBox2i                               intersectedWindow;
                     std::vector<OpenEXR::Layer>          layers;
                     bool                                 fast              = false;
+                    bool                                 sampled           = false;
+
+                    std::unique_ptr<MemoryMappedIStream> ts;
+                    std::unique_ptr<Imf::TiledInputFile> tf;
+
+                    void openTiled(const std::string& fileName)
+                    {
+#if defined(DJV_MMAP)
+                        ts.reset(new MemoryMappedIStream(fileName.c_str()));
+                        tf.reset(new Imf::TiledInputFile(*ts.get()));
+#else // DJV_MMAP
+                        tf.reset(new Imf::TiledInputFile(fileName.c_str()));
+#endif // DJV_MMAP
+                    }
                 };
 
                 struct Read::Private
                 {
                     Options options;
+                    size_t proxyMax = 0;
                 };
 
                 Read::Read() :
@@ -119,96 +136,292 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
                     const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+
+                    // Proxies are read from the mipmap or ripmap levels, which
+                    // are taken from the first file of the sequence.
+                    try
+                    {
+                        const auto& sequence = fileInfo.getSequence();
+                        const std::string fileName = fileInfo.getFileName(
+                            sequence.getSize() ? sequence.getFrame(0) : Frame::invalid);
+                        if (Imf::isTiledOpenExrFile(fileName.c_str()))
+                        {
+                            // Files without mipmap or ripmap levels only have
+                            // a single level.
+                            Imf::TiledInputFile tf(fileName.c_str());
+                            out->_p->proxyMax = static_cast<size_t>(std::min(tf.numXLevels(), tf.numYLevels()) - 1);
+                        }
+                    }
+                    catch (const std::exception&)
+                    {
+                        // The error is reported when the file information is read.
+                    }
+
+                    out->_init(fileInfo, readOptions, threadPool, frameCache, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
+                bool Read::hasProxy() const
+                {
+                    return _p->proxyMax > 0;
+                }
+
+                size_t Read::getProxy(size_t value) const
+                {
+                    return std::min(std::min(value, proxyMax), _p->proxyMax);
+                }
+
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     File f;
                     return _open(fileName, f);
                 }
 
-                std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
+                struct Read::LayerImage
                 {
-                    File f;
-                    Info info = _open(fileName, f);
-                    Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)].info;
-                    std::shared_ptr<Image::Image> out = Image::Image::create(imageInfo);
-                    out->setPluginName(pluginName);
-                    out->setTags(info.tags);
-                    const size_t channels = Image::getChannelCount(imageInfo.type);
-                    const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
-                    const size_t cb = channels * channelByteCount;
-                    const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                    if (f.fast)
+                    size_t                        index            = 0;
+                    const Layer*                  layer            = nullptr;
+                    Image::Info                   info;
+                    std::shared_ptr<Image::Image> image;
+                    size_t                        channelByteCount = 0;
+                    size_t                        cb               = 0;
+                    size_t                        scb              = 0;
+
+                    void create()
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        for (size_t c = 0; c < channels; ++c)
+                        image = Image::Image::create(info);
+                        channelByteCount = Image::getByteCount(Image::getDataType(info.type));
+                        cb = Image::getChannelCount(info.type) * channelByteCount;
+                        scb = info.size.w * cb;
+                    }
+
+                    //! Add the channels to a frame buffer. The pixel (x, y) is
+                    //! stored at base + x * cb + y * yStride.
+                    void insert(Imf::FrameBuffer& frameBuffer, char* base, size_t yStride, bool sampling) const
+                    {
+                        const Image::Type type = image->getType();
+                        for (size_t c = 0; c < Image::getChannelCount(type); ++c)
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
+                            const auto& channel = layer->channels[c];
                             frameBuffer.insert(
-                                name.c_str(),
+                                channel.name.c_str(),
                                 Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    (char*)out->getData() + (c * channelByteCount),
+                                    toImf(Image::getDataType(type)),
+                                    base + (c * channelByteCount),
                                     cb,
-                                    scb,
-                                    sampling.x,
-                                    sampling.y,
+                                    yStride,
+                                    sampling ? channel.sampling.x : 1,
+                                    sampling ? channel.sampling.y : 1,
                                     0.F));
                         }
-                        f.f->setFrameBuffer(frameBuffer);
-                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
+                    }
+                };
+
+                std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
+                {
+                    return _readLayers(fileName, { _options.layer })[0];
+                }
+
+                std::vector<std::shared_ptr<Image::Image> > Read::_readLayers(
+                    const std::string& fileName,
+                    const std::vector<size_t>& layers)
+                {
+                    File f;
+                    Info info = _open(fileName, f);
+
+                    // Get the layers to read. The first layer is the current
+                    // layer, any other layers that do not exist are skipped.
+                    std::vector<LayerImage> layerImages;
+                    for (size_t i = 0; i < layers.size(); ++i)
+                    {
+                        size_t layer = layers[i];
+                        if (0 == i)
+                        {
+                            layer = std::min(layer, info.video.size() - 1);
+                        }
+                        else if (layer >= info.video.size())
+                        {
+                            continue;
+                        }
+                        LayerImage layerImage;
+                        layerImage.index = i;
+                        layerImage.layer = &f.layers[layer];
+                        layerImage.info = info.video[layer].info;
+                        layerImages.push_back(layerImage);
+                    }
+
+                    // Read all of the layers in one pass.
+                    const bool tiled = f.f->header().hasTileDescription();
+                    bool level = false;
+                    if (_options.proxy > 0 && f.fast && tiled)
+                    {
+                        const Imf::LevelMode levelMode = f.f->header().tileDescription().mode;
+                        level = Imf::MIPMAP_LEVELS == levelMode || Imf::RIPMAP_LEVELS == levelMode;
+                    }
+                    if (level)
+                    {
+                        _readLevel(fileName, f, layerImages);
                     }
                     else
+                    {
+                        _readWindow(fileName, f, layerImages);
+                    }
+
+                    std::vector<std::shared_ptr<Image::Image> > out(layers.size());
+                    for (const auto& i : layerImages)
+                    {
+                        i.image->setPluginName(pluginName);
+                        i.image->setTags(info.tags);
+                        out[i.index] = i.image;
+                    }
+                    return out;
+                }
+
+                void Read::_readWindow(const std::string& fileName, File& f, std::vector<LayerImage>& layerImages)
+                {
+                    // Only the pixels inside the data window and the region of
+                    // interest are read, the rest of the image is zero.
+                    BBox2i readWindow = f.intersectedWindow;
+                    if (_options.roi.isValid())
+                    {
+                        readWindow = readWindow.intersect(BBox2i(
+                            f.displayWindow.min + _options.roi.min,
+                            f.displayWindow.min + _options.roi.max));
+                    }
+                    if (readWindow.min.x > readWindow.max.x || readWindow.min.y > readWindow.max.y)
+                    {
+                        for (auto& i : layerImages)
+                        {
+                            i.create();
+                            i.image->zero();
+                        }
+                        return;
+                    }
+                    for (auto& i : layerImages)
+                    {
+                        i.create();
+                        for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
+                        {
+                            uint8_t* p = i.image->getData() + ((y - f.displayWindow.min.y) * i.scb);
+                            if (y >= readWindow.min.y && y <= readWindow.max.y)
+                            {
+                                const size_t left = (readWindow.min.x - f.displayWindow.min.x) * i.cb;
+                                const size_t right = (readWindow.max.x - f.displayWindow.min.x + 1) * i.cb;
+                                memset(p, 0, left);
+                                memset(p + right, 0, i.scb - right);
+                            }
+                            else
+                            {
+                                memset(p, 0, i.scb);
+                            }
+                        }
+                    }
+
+                    // The pixels can be decoded directly into the images when
+                    // the data window does not extend past the display window.
+                    const bool direct =
+                        !f.sampled &&
+                        f.dataWindow.min.x >= f.displayWindow.min.x &&
+                        f.dataWindow.max.x <= f.displayWindow.max.x;
+                    const bool directTiles =
+                        direct &&
+                        f.f->header().hasTileDescription() &&
+                        f.dataWindow.min.y >= f.displayWindow.min.y &&
+                        f.dataWindow.max.y <= f.displayWindow.max.y;
+                    if (direct)
                     {
                         Imf::FrameBuffer frameBuffer;
-                        std::vector<char> buf(f.dataWindow.w() * cb);
-                        for (int c = 0; c < channels; ++c)
+                        for (const auto& i : layerImages)
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    buf.data() - (f.dataWindow.min.x * cb) + (c * channelByteCount),
-                                    cb,
-                                    0,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
+                            i.insert(
+                                frameBuffer,
+                                (char*)i.image->getData() - (f.displayWindow.min.x * i.cb) - (f.displayWindow.min.y * i.scb),
+                                i.scb,
+                                false);
+                        }
+                        if (directTiles)
+                        {
+                            // Only read the tiles that intersect the read window.
+                            f.openTiled(fileName);
+                            const int tileW = f.tf->tileXSize();
+                            const int tileH = f.tf->tileYSize();
+                            f.tf->setFrameBuffer(frameBuffer);
+                            f.tf->readTiles(
+                                (readWindow.min.x - f.dataWindow.min.x) / tileW,
+                                (readWindow.max.x - f.dataWindow.min.x) / tileW,
+                                (readWindow.min.y - f.dataWindow.min.y) / tileH,
+                                (readWindow.max.y - f.dataWindow.min.y) / tileH);
+                        }
+                        else
+                        {
+                            f.f->setFrameBuffer(frameBuffer);
+                            f.f->readPixels(readWindow.min.y, readWindow.max.y);
+                        }
+                    }
+                    else
+                    {
+                        Imf::FrameBuffer frameBuffer;
+                        std::vector<std::vector<char> > bufs(layerImages.size());
+                        for (size_t i = 0; i < layerImages.size(); ++i)
+                        {
+                            const auto& layerImage = layerImages[i];
+                            bufs[i].resize(f.dataWindow.w() * layerImage.cb);
+                            layerImage.insert(
+                                frameBuffer,
+                                bufs[i].data() - (f.dataWindow.min.x * layerImage.cb),
+                                0,
+                                true);
                         }
                         f.f->setFrameBuffer(frameBuffer);
-                        for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
+                        for (int y = readWindow.min.y; y <= readWindow.max.y; ++y)
                         {
-                            uint8_t* p = out->getData() + ((y - f.displayWindow.min.y) * scb);
-                            uint8_t* end = p + scb;
-                            if (y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
+                            f.f->readPixels(y, y);
+                            for (size_t i = 0; i < layerImages.size(); ++i)
                             {
-                                size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * cb;
-                                memset(p, 0, size);
-                                p += size;
-                                size = f.intersectedWindow.w() * cb;
-                                f.f->readPixels(y, y);
+                                const auto& layerImage = layerImages[i];
                                 memcpy(
-                                    p,
-                                    buf.data() + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * cb,
-                                    size);
-                                p += size;
+                                    layerImage.image->getData() +
+                                        ((y - f.displayWindow.min.y) * layerImage.scb) +
+                                        ((readWindow.min.x - f.displayWindow.min.x) * layerImage.cb),
+                                    bufs[i].data() + (readWindow.min.x - f.dataWindow.min.x) * layerImage.cb,
+                                    readWindow.w() * layerImage.cb);
                             }
-                            memset(p, 0, end - p);
                         }
                     }
-                    return out;
+                }
+
+                void Read::_readLevel(const std::string& fileName, File& f, std::vector<LayerImage>& layerImages)
+                {
+                    // Read the mipmap or ripmap level that matches the proxy.
+                    f.openTiled(fileName);
+                    Imf::TiledInputFile& tf = *f.tf;
+                    const int level = std::min(
+                        static_cast<int>(std::min(_options.proxy, proxyMax)),
+                        std::min(tf.numXLevels(), tf.numYLevels()) - 1);
+                    const BBox2i dataWindow = fromImath(tf.dataWindowForLevel(level, level));
+                    Imf::FrameBuffer frameBuffer;
+                    for (auto& i : layerImages)
+                    {
+                        i.info.size.w = dataWindow.w();
+                        i.info.size.h = dataWindow.h();
+                        i.create();
+                        i.image->setProxy(level);
+                        i.insert(
+                            frameBuffer,
+                            (char*)i.image->getData() - (dataWindow.min.x * i.cb) - (dataWindow.min.y * i.scb),
+                            i.scb,
+                            false);
+                    }
+                    tf.setFrameBuffer(frameBuffer);
+                    tf.readTiles(0, tf.numXTiles(level) - 1, 0, tf.numYTiles(level) - 1, level, level);
                 }
 
                 Info Read::_open(const std::string & fileName, File & f)
@@ -243,7 +456,10 @@ namespace djv
                         const auto& layer = f.layers[i];
                         const glm::ivec2 sampling(layer.channels[0].sampling.x, layer.channels[0].sampling.y);
                         if (sampling.x != 1 || sampling.y != 1)
+                        {
                             f.fast = false;
+                            f.sampled = true;
+                        }
                         auto& info = out.video[i].info;
                         info.name = layer.name;
                         info.size.w = f.displayWindow.w();
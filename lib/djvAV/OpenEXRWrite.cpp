@@ -4,6 +4,10 @@
 
 #include <djvAV/OpenEXR.h>
 
+#include <ImfOutputFile.h>
+#include <ImfStandardAttributes.h>
+#include <ImfTiledOutputFile.h>
+
 using namespace djv::Core;
 
 namespace djv
@@ -33,25 +37,34 @@ namespace djv
                     const Info & info,
                     const WriteOptions& writeOptions,
                     const Options& options,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Write>(new Write);
                     out->_p->options = options;
-                    out->_init(fileInfo, info, writeOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, info, writeOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
                 namespace
                 {
-                    struct File
+                    std::vector<std::string> getChannelNames(size_t channelCount)
                     {
-                        ~File()
+                        std::vector<std::string> out;
+                        switch (channelCount)
                         {
+                        case 1: out = { "Y" }; break;
+                        case 2: out = { "Y", "A" }; break;
+                        case 3: out = { "R", "G", "B" }; break;
+                        case 4: out = { "R", "G", "B", "A" }; break;
+                        default: break;
                         }
-                    };
-                }
+                        return out;
+                    }
+
+                } // namespace
 
                 Image::Type Write::_getImageType(Image::Type value) const
                 {
@@ -65,15 +78,18 @@ namespace djv
                     case Image::Type::L_F32:    out = value; break;
                     case Image::Type::LA_U8:    out = Image::Type::LA_F16; break;
                     case Image::Type::LA_U16:
+                    case Image::Type::LA_F16:
                     case Image::Type::LA_U32:
                     case Image::Type::LA_F32:   out = value; break;
                     case Image::Type::RGB_U8:
                     case Image::Type::RGB_U10:
                     case Image::Type::RGB_U16:  out = Image::Type::RGB_F16; break;
+                    case Image::Type::RGB_F16:
                     case Image::Type::RGB_U32:
                     case Image::Type::RGB_F32:  out = value; break;
                     case Image::Type::RGBA_U8:
                     case Image::Type::RGBA_U16: out = Image::Type::RGBA_F16; break;
+                    case Image::Type::RGBA_F16:
                     case Image::Type::RGBA_U32:
                     case Image::Type::RGBA_F32: out = value; break;
                     default: break;
@@ -89,9 +105,69 @@ namespace djv
 
                 void Write::_write(const std::string & fileName, const std::shared_ptr<Image::Image> & image)
                 {
+                    DJV_PRIVATE_PTR();
+                    const auto& info = image->getInfo();
+                    const Image::DataType dataType = Image::getDataType(info.type);
+                    const size_t channelCount = Image::getChannelCount(info.type);
+                    const size_t channelByteCount = Image::getByteCount(dataType);
+                    const size_t cb = channelCount * channelByteCount;
+                    const size_t scb = info.size.w * cb;
+
+                    // Set the header.
+                    Imf::Header header(
+                        info.size.w,
+                        info.size.h,
+                        info.pixelAspectRatio,
+                        Imath::V2f(0.F, 0.F),
+                        1.F,
+                        Imf::INCREASING_Y,
+                        toImf(p.options.compression));
+                    if (Compression::DWAA == p.options.compression ||
+                        Compression::DWAB == p.options.compression)
+                    {
+                        Imf::addDwaCompressionLevel(header, p.options.dwaCompressionLevel);
+                    }
+                    writeTags(
+                        _info.tags,
+                        !_info.video.empty() ? _info.video[0].speed : Time::Speed(),
+                        header);
+
+                    // Set the channels. The image data is stored top to bottom
+                    // which matches the INCREASING_Y line order.
+                    const auto channelNames = getChannelNames(channelCount);
+                    const Imf::PixelType pixelType = toImf(dataType);
+                    Imf::FrameBuffer frameBuffer;
+                    for (size_t c = 0; c < channelNames.size(); ++c)
+                    {
+                        header.channels().insert(channelNames[c], Imf::Channel(pixelType));
+                        frameBuffer.insert(
+                            channelNames[c],
+                            Imf::Slice(
+                                pixelType,
+                                reinterpret_cast<char*>(image->getData()) + c * channelByteCount,
+                                cb,
+                                scb));
+                    }
+
+                    // Write the file. The Imf global thread pool compresses
+                    // the line buffers or tiles of the file in parallel.
+                    if (p.options.tiled)
+                    {
+                        const int tileSize = static_cast<int>(std::max(p.options.tileSize, static_cast<size_t>(1)));
+                        header.setTileDescription(Imf::TileDescription(tileSize, tileSize, Imf::ONE_LEVEL));
+                        Imf::TiledOutputFile f(fileName.c_str(), header);
+                        f.setFrameBuffer(frameBuffer);
+                        f.writeTiles(0, f.numXTiles() - 1, 0, f.numYTiles() - 1);
+                    }
+                    else
+                    {
+                        Imf::OutputFile f(fileName.c_str(), header);
+                        f.setFrameBuffer(frameBuffer);
+                        f.writePixels(info.size.h);
+                    }
                 }
 
-            } // namespace TIFF
+            } // namespace OpenEXR
         } // namespace IO
     } // namespace AV
 } // namespace djv
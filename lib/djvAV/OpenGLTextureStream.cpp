@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/OpenGLTextureStream.h>
+
+#include <djvCore/Memory.h>
+#include <djvCore/ThreadPool.h>
+
+#include <cstring>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OpenGL
+        {
+#if !defined(DJV_OPENGL_ES2)
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const GLuint64 clearTimeout = 1000000000;
+
+            } // namespace
+
+            struct TextureStream::Buffer
+            {
+                enum class State
+                {
+                    Free,
+                    Copying,
+                    Uploading
+                };
+
+                GLuint                             pbo     = 0;
+                size_t                             size    = 0;
+                State                              state   = State::Free;
+                std::shared_ptr<const Image::Data> data;
+                std::shared_ptr<Texture>           texture;
+                std::future<void>                  copy;
+                GLsync                             fence   = nullptr;
+            };
+
+            struct TextureStream::Private
+            {
+                std::vector<Buffer> buffers;
+                size_t next = 0;
+                std::shared_ptr<ThreadPool> threadPool;
+            };
+
+            TextureStream::TextureStream(size_t bufferCount) :
+                _p(new Private)
+            {
+                DJV_PRIVATE_PTR();
+                p.buffers.resize(std::max(bufferCount, static_cast<size_t>(1)));
+                for (auto& i : p.buffers)
+                {
+                    glGenBuffers(1, &i.pbo);
+                }
+                p.threadPool = ThreadPool::create(1);
+            }
+
+            TextureStream::~TextureStream()
+            {
+                DJV_PRIVATE_PTR();
+                clear();
+                for (auto& i : p.buffers)
+                {
+                    glDeleteBuffers(1, &i.pbo);
+                }
+            }
+
+            size_t TextureStream::getBufferCount() const
+            {
+                return _p->buffers.size();
+            }
+
+            size_t TextureStream::getBusyCount() const
+            {
+                size_t out = 0;
+                for (const auto& i : _p->buffers)
+                {
+                    if (i.state != Buffer::State::Free)
+                    {
+                        ++out;
+                    }
+                }
+                return out;
+            }
+
+            bool TextureStream::isStaged(UID uid) const
+            {
+                for (const auto& i : _p->buffers)
+                {
+                    if (i.texture && i.data->getUID() == uid)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool TextureStream::stage(const std::shared_ptr<const Image::Data>& data, const std::shared_ptr<Texture>& texture)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Use the buffers in ring order so that the buffer used last
+                // has the most time for its upload to complete.
+                const size_t count = p.buffers.size();
+                Buffer* buffer = nullptr;
+                size_t index = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    index = (p.next + i) % count;
+                    if (Buffer::State::Free == p.buffers[index].state)
+                    {
+                        buffer = &p.buffers[index];
+                        break;
+                    }
+                }
+                if (!buffer)
+                {
+                    return false;
+                }
+
+                // The buffer is only free once its last upload has completed, so
+                // it can be mapped without synchronizing.
+                const size_t byteCount = data->getDataByteCount();
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->pbo);
+                if (byteCount > buffer->size)
+                {
+                    glBufferData(GL_PIXEL_UNPACK_BUFFER, byteCount, nullptr, GL_STREAM_DRAW);
+                    buffer->size = byteCount;
+                }
+                void* ptr = glMapBufferRange(
+                    GL_PIXEL_UNPACK_BUFFER,
+                    0,
+                    byteCount,
+                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                if (!ptr)
+                {
+                    return false;
+                }
+
+                buffer->state = Buffer::State::Copying;
+                buffer->data = data;
+                buffer->texture = texture;
+                buffer->copy = p.threadPool->push(
+                    [data, ptr, byteCount]
+                    {
+                        memcpy(ptr, data->getData(), byteCount);
+                    });
+                p.next = (index + 1) % count;
+                return true;
+            }
+
+            std::vector<std::pair<UID, std::shared_ptr<Texture> > > TextureStream::update()
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<std::pair<UID, std::shared_ptr<Texture> > > out;
+                bool flush = false;
+                for (auto& i : p.buffers)
+                {
+                    switch (i.state)
+                    {
+                    case Buffer::State::Copying:
+                        if (i.copy.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            _upload(i);
+                            flush = true;
+                        }
+                        break;
+                    case Buffer::State::Uploading:
+                    {
+                        const GLenum result = glClientWaitSync(i.fence, 0, 0);
+                        if (GL_ALREADY_SIGNALED == result || GL_CONDITION_SATISFIED == result)
+                        {
+                            glDeleteSync(i.fence);
+                            i.fence = nullptr;
+                            if (i.texture)
+                            {
+                                out.push_back(std::make_pair(i.data->getUID(), i.texture));
+                            }
+                            i.data.reset();
+                            i.texture.reset();
+                            i.state = Buffer::State::Free;
+                        }
+                        break;
+                    }
+                    default: break;
+                    }
+                }
+                if (flush)
+                {
+                    // Flush so that the fences are signaled without waiting for
+                    // the next frame.
+                    glFlush();
+                }
+                return out;
+            }
+
+            std::shared_ptr<Texture> TextureStream::finish(UID uid)
+            {
+                DJV_PRIVATE_PTR();
+                std::shared_ptr<Texture> out;
+                for (auto& i : p.buffers)
+                {
+                    if (i.texture && i.data->getUID() == uid)
+                    {
+                        if (Buffer::State::Copying == i.state)
+                        {
+                            i.copy.wait();
+                            _upload(i);
+                        }
+
+                        // Commands are executed in order so the texture can be
+                        // drawn before the fence is signaled. The buffer is
+                        // released when the fence is signaled but the texture
+                        // is not returned again by update().
+                        out = i.texture;
+                        i.texture.reset();
+                        break;
+                    }
+                }
+                return out;
+            }
+
+            void TextureStream::clear()
+            {
+                DJV_PRIVATE_PTR();
+                for (auto& i : p.buffers)
+                {
+                    switch (i.state)
+                    {
+                    case Buffer::State::Copying:
+                        i.copy.wait();
+                        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, i.pbo);
+                        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                        break;
+                    case Buffer::State::Uploading:
+                    {
+                        // Wait for the upload to complete so that the buffer is
+                        // not mapped again while it is still being read. If the
+                        // wait times out the buffer storage is orphaned instead.
+                        const GLenum result = glClientWaitSync(i.fence, GL_SYNC_FLUSH_COMMANDS_BIT, clearTimeout);
+                        glDeleteSync(i.fence);
+                        i.fence = nullptr;
+                        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+                        {
+                            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, i.pbo);
+                            glBufferData(GL_PIXEL_UNPACK_BUFFER, i.size, nullptr, GL_STREAM_DRAW);
+                            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                        }
+                        break;
+                    }
+                    default: break;
+                    }
+                    i.state = Buffer::State::Free;
+                    i.data.reset();
+                    i.texture.reset();
+                }
+            }
+
+            void TextureStream::_upload(Buffer& buffer)
+            {
+                buffer.copy.get();
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                if (buffer.texture)
+                {
+                    const auto& info = buffer.data->getInfo();
+                    buffer.texture->bind();
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+                    glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
+                    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+                    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+                    glTexSubImage2D(
+                        GL_TEXTURE_2D,
+                        0,
+                        0,
+                        0,
+                        info.size.w,
+                        info.size.h,
+                        info.getGLFormat(),
+                        info.getGLType(),
+                        0);
+                }
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                buffer.state = Buffer::State::Uploading;
+            }
+#endif // DJV_OPENGL_ES2
+
+        } // namespace OpenGL
+    } // namespace AV
+} // namespace djv
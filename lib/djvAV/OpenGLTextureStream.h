@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/OpenGLTexture.h>
+
+#include <djvCore/UID.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OpenGL
+        {
+#if !defined(DJV_OPENGL_ES2)
+            //! This class provides asynchronous texture uploads with a ring of
+            //! pixel buffer objects.
+            //!
+            //! Staging an image maps the next free buffer and copies the image
+            //! data into it with a job on a worker thread. When the copy is
+            //! finished the buffer is unmapped and the texture upload is started
+            //! from it, and a fence is used to check when the upload has
+            //! completed without stalling. The functions must be called from
+            //! the thread with the OpenGL context, only the copies run on the
+            //! worker thread.
+            class TextureStream
+            {
+                DJV_NON_COPYABLE(TextureStream);
+
+            public:
+                explicit TextureStream(size_t bufferCount);
+                ~TextureStream();
+
+                size_t getBufferCount() const;
+
+                //! Get the number of buffers that are in use.
+                size_t getBusyCount() const;
+
+                //! Get whether an image is being copied or uploaded.
+                bool isStaged(Core::UID) const;
+
+                //! Stage an image for upload. The texture should already have
+                //! the image information set. Returns false if there are no
+                //! free buffers.
+                bool stage(const std::shared_ptr<const Image::Data>&, const std::shared_ptr<Texture>&);
+
+                //! Advance the uploads and return the textures that have
+                //! completed.
+                std::vector<std::pair<Core::UID, std::shared_ptr<Texture> > > update();
+
+                //! Finish the upload of an image now, for when it needs to be
+                //! drawn before the upload has completed. Returns null if the
+                //! image is not staged.
+                std::shared_ptr<Texture> finish(Core::UID);
+
+                //! Cancel the uploads. This waits for uploads that have already
+                //! started to complete.
+                void clear();
+
+            private:
+                struct Buffer;
+                void _upload(Buffer&);
+
+                DJV_PRIVATE();
+            };
+#endif // DJV_OPENGL_ES2
+
+        } // namespace OpenGL
+    } // namespace AV
+} // namespace djv
@@ -37,12 +37,13 @@ namespace djv
                     const FileSystem::FileInfo& fileInfo,
                     const Info & info,
                     const WriteOptions& writeOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Write>(new Write);
-                    out->_init(fileInfo, info, writeOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, info, writeOptions, threadPool, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
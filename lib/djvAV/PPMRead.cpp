@@ -30,12 +30,14 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const std::shared_ptr<ThreadPool>& threadPool,
+                    const std::shared_ptr<FrameCache>& frameCache,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
-                    out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
+                    out->_init(fileInfo, readOptions, threadPool, frameCache, textSystem, resourceSystem, logSystem);
                     return out;
                 }
 
@@ -57,10 +59,37 @@ namespace djv
                     {
                     case Data::ASCII:
                     {
-                        out = Image::Image::create(imageInfo);
-                        out->setPluginName(pluginName);
                         const size_t channelCount = Image::getChannelCount(imageInfo.type);
                         const size_t bitDepth = Image::getBitDepth(imageInfo.type);
+                        if (_options.proxy > 0)
+                        {
+                            // The ASCII data must be parsed in full, only every
+                            // step'th scanline and pixel is kept.
+                            const size_t step = static_cast<size_t>(1) << std::min(_options.proxy, proxyMax);
+                            auto proxyInfo = imageInfo;
+                            proxyInfo.size = getProxySize(imageInfo.size, _options.proxy);
+                            out = Image::Image::create(proxyInfo);
+                            out->setPluginName(pluginName);
+                            out->setProxy(_options.proxy);
+                            const size_t pixelByteCount = imageInfo.getPixelByteCount();
+                            std::vector<uint8_t> scanline(imageInfo.getScanlineByteCount());
+                            for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                            {
+                                readASCII(io, scanline.data(), imageInfo.size.w * channelCount, bitDepth);
+                                if (0 == y % step)
+                                {
+                                    const uint8_t* inP = scanline.data();
+                                    uint8_t* outP = out->getData(static_cast<uint16_t>(y / step));
+                                    for (uint16_t x = 0; x < proxyInfo.size.w; ++x, inP += step * pixelByteCount, outP += pixelByteCount)
+                                    {
+                                        memcpy(outP, inP, pixelByteCount);
+                                    }
+                                }
+                            }
+                            break;
+                        }
+                        out = Image::Image::create(imageInfo);
+                        out->setPluginName(pluginName);
                         for (uint16_t y = 0; y < imageInfo.size.h; ++y)
                         {
                             readASCII(io, out->getData(y), imageInfo.size.w * channelCount, bitDepth);
@@ -69,8 +98,15 @@ namespace djv
                     }
                     case Data::Binary:
                     {
+                        if (_options.proxy > 0)
+                        {
+                            out = readProxy(imageInfo, _options.proxy, io);
+                            out->setPluginName(pluginName);
+                            break;
+                        }
 #if defined(DJV_MMAP)
                         out = Image::Image::create(imageInfo, io);
+                        out->setPluginName(pluginName);
 #else // DJV_MMAP
                         bool convertEndian = false;
                         if (imageInfo.layout.endian != Memory::getEndian())
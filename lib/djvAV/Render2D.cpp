@@ -6,10 +6,12 @@
 
 #include <djvAV/Color.h>
 #include <djvAV/GLFWSystem.h>
+#include <djvAV/OCIOLUT.h>
 #include <djvAV/OpenGLMesh.h>
 #include <djvAV/OpenGLShader.h>
 #include <djvAV/OpenGLTexture.h>
 #include <djvAV/OpenGLTextureAtlas.h>
+#include <djvAV/OpenGLTextureStream.h>
 #include <djvAV/Shader.h>
 #include <djvAV/Shape.h>
 #include <djvAV/TriangleMesh.h>
@@ -17,9 +19,12 @@
 #include <djvCore/Cache.h>
 #include <djvCore/Context.h>
 #include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/Range.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Timer.h>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -28,6 +33,10 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/perpendicular.hpp>
 
+#include <limits>
+#include <set>
+#include <tuple>
+
 using namespace djv::Core;
 namespace _OCIO = OCIO_NAMESPACE;
 
@@ -42,11 +51,11 @@ namespace djv
                 //! \todo Should this be configurable?
                 const uint8_t  textureAtlasCount      = 4;
                 const uint16_t textureAtlasSize       = 8192;
-                const size_t   dynamicTextureCount    = 16;
-                const size_t   dynamicTextureCacheMax = 16;
+                const size_t   dynamicTexturePoolMax  = 2;
 #if !defined(DJV_OPENGL_ES2)
-                const size_t   lut3DSize              = 32;
+                const size_t   textureStreamCount     = 4;
                 const size_t   colorSpaceCacheMax     = 32;
+                const uint64_t lutCacheByteCountMax   = 64 * Memory::megabyte;
 #endif // DJV_OPENGL_ES2
 
                 // This enumeration provides how the color is used to draw the render primitive.
@@ -259,7 +268,7 @@ namespace djv
                     DJV_NON_COPYABLE(LUT3D);
 
                 public:
-                    explicit LUT3D(size_t edgeLen = lut3DSize) :
+                    explicit LUT3D(size_t edgeLen) :
                         _edgeLen(edgeLen),
                         _size(3 * edgeLen * edgeLen * edgeLen),
                         _data(new float[_size])
@@ -335,9 +344,6 @@ namespace djv
                     GLuint _id = 0;
                 };
 
-                //! This variable provides color space conversion ids.
-                size_t colorSpaceID = 1;
-
                 //! This struct provides data for color space conversions.
                 struct ColorSpaceData
                 {
@@ -346,8 +352,35 @@ namespace djv
                     std::shared_ptr<LUT3D>  lut3D;
                 };
 
+                //! This struct provides the result of preparing a color space
+                //! conversion on the worker thread.
+                struct ColorSpaceResult
+                {
+                    std::shared_ptr<OCIO::LUT>  lut;
+                    std::string                 error;
+                };
+
+                //! This struct provides a color space conversion that is being
+                //! prepared.
+                struct ColorSpaceRequest
+                {
+                    std::string                     configID;
+                    size_t                          lutSize = 0;
+                    std::future<ColorSpaceResult>   future;
+                };
+
 #endif // DJV_OPENGL_ES2
 
+                //! This typedef provides the format used to pool dynamic textures,
+                //! textures with the same format can be re-used without
+                //! re-allocating them.
+                typedef std::tuple<uint16_t, uint16_t, Image::Type> DynamicTextureFormat;
+
+                DynamicTextureFormat getDynamicTextureFormat(const Image::Info& info)
+                {
+                    return DynamicTextureFormat(info.size.w, info.size.h, info.type);
+                }
+
                 // Utility function to flip the y-coordinate.
                 BBox2f flip(const BBox2f& value, const Image::Size& size)
                 {
@@ -467,10 +500,21 @@ namespace djv
                 std::shared_ptr<OpenGL::TextureAtlas>               textureAtlas;
                 std::map<UID, uint64_t>                             textureIDs;
                 std::map<UID, uint64_t>                             glyphTextureIDs;
-                std::vector<std::shared_ptr<OpenGL::Texture> >      dynamicTextures;
-                std::map<UID, std::shared_ptr<OpenGL::Texture> >    dynamicTextureCache;
+                Memory::Cache<UID, std::shared_ptr<OpenGL::Texture> > dynamicTextureCache;
+                size_t                                              dynamicTextureCacheMax = textureCacheSizeDefault;
+                std::map<DynamicTextureFormat, std::vector<std::shared_ptr<OpenGL::Texture> > > dynamicTexturePool;
+                size_t                                              dynamicTextureHits = 0;
+                size_t                                              dynamicTextureMisses = 0;
+                uint64_t                                            dynamicTextureUploadByteCount = 0;
 #if !defined(DJV_OPENGL_ES2)
-                std::map<OCIO::Convert, ColorSpaceData>             colorSpaceCache;
+                std::shared_ptr<OpenGL::TextureStream>              textureStream;
+                size_t                                              lutSize             = OCIO::lutSizeDefault;
+                std::string                                         lutCachePath;
+                std::string                                         configID;
+                Memory::Cache<OCIO::Convert, ColorSpaceData>        colorSpaceCache;
+                std::map<OCIO::Convert, ColorSpaceRequest>          colorSpaceRequests;
+                std::set<OCIO::Convert>                             colorSpaceErrors;
+                std::shared_ptr<ThreadPool>                         colorSpaceThreadPool;
 #endif // DJV_OPENGL_ES2
                 std::vector<uint8_t>                                vboData;
                 size_t                                              vboDataSize         = 0;
@@ -487,6 +531,17 @@ namespace djv
 
                 void updateVBODataSize(size_t);
 
+                std::shared_ptr<OpenGL::Texture> getDynamicTexture(const Image::Info&);
+                void releaseDynamicTexture(const std::shared_ptr<OpenGL::Texture>&);
+                void addDynamicTexture(UID, const std::shared_ptr<OpenGL::Texture>&);
+                size_t getDynamicTexturePoolCount() const;
+#if !defined(DJV_OPENGL_ES2)
+                void textureStreamUpdate();
+                void colorSpaceUpdate();
+                void colorSpaceRequest(const OCIO::Convert&);
+                void colorSpaceClear();
+#endif // DJV_OPENGL_ES2
+
                 void drawImage(
                     const std::shared_ptr<Image::Image>&,
                     const glm::vec2& pos,
@@ -535,9 +590,20 @@ namespace djv
                     0));
                 p.primitiveData.textureAtlasCount = _textureAtlasCount;
 
+                // The dynamic texture cache is trimmed to the budget at the end
+                // of each frame, not when textures are added.
+                p.dynamicTextureCache.setMax(std::numeric_limits<size_t>::max());
+#if !defined(DJV_OPENGL_ES2)
+                p.textureStream.reset(new OpenGL::TextureStream(textureStreamCount));
+                p.colorSpaceCache.setMax(colorSpaceCacheMax);
+                p.colorSpaceThreadPool = ThreadPool::create(1);
+#endif // DJV_OPENGL_ES2
                 _updateImageFilter();
 
                 auto resourceSystem = context->getSystemT<ResourceSystem>();
+#if !defined(DJV_OPENGL_ES2)
+                p.lutCachePath = FileSystem::Path(resourceSystem->getPath(FileSystem::ResourcePath::Cache), "OCIO").get();
+#endif // DJV_OPENGL_ES2
                 const FileSystem::Path shaderPath = resourceSystem->getPath(FileSystem::ResourcePath::Shaders);
                 try
                 {
@@ -566,10 +632,19 @@ namespace djv
                         ss << "Texture atlas: " << p.textureAtlas->getPercentageUsed() << "%\n";
                         ss << "Texture IDs: " << p.textureIDs.size() << "%\n";
                         ss << "Glyph texture IDs: " << p.glyphTextureIDs.size() << "\n";
-                        ss << "Dynamic textures: " << p.dynamicTextures.size() << "\n";
-                        ss << "Dynamic texture cache: " << p.dynamicTextureCache.size() << "\n";
+                        ss << "Dynamic texture cache: " << p.dynamicTextureCache.getSize() << ", " <<
+                            Memory::getSizeLabel(p.dynamicTextureCache.getCost()) << "/" <<
+                            Memory::getSizeLabel(p.dynamicTextureCacheMax) << "\n";
+                        ss << "Dynamic texture pool: " << p.getDynamicTexturePoolCount() << "\n";
+                        ss << "Dynamic texture hits/misses: " << p.dynamicTextureHits << "/" <<
+                            p.dynamicTextureMisses << "\n";
+                        ss << "Dynamic texture uploads: " <<
+                            Memory::getSizeLabel(p.dynamicTextureUploadByteCount) << "\n";
 #if !defined(DJV_OPENGL_ES2)
-                        ss << "Color space cache: " << p.colorSpaceCache.size() << "\n";
+                        ss << "Texture stream: " << p.textureStream->getBusyCount() << "/" <<
+                            p.textureStream->getBufferCount() << "\n";
+                        ss << "Color space cache: " << p.colorSpaceCache.getSize() << "\n";
+                        ss << "Color space requests: " << p.colorSpaceRequests.size() << "\n";
 #endif // DJV_OPENGL_ES2
                         ss << "VBO size: " << (p.vbo ? p.vbo->getSize() : 0);
                         _log(ss.str());
@@ -596,6 +671,10 @@ namespace djv
                 _size = size;
                 _currentClipRect = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
                 p.viewport = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+#if !defined(DJV_OPENGL_ES2)
+                p.textureStreamUpdate();
+                p.colorSpaceUpdate();
+#endif // DJV_OPENGL_ES2
             }
 
             void Render::endFrame()
@@ -745,23 +824,25 @@ namespace djv
                 }
                 p.primitives.clear();
                 p.vboDataSize = 0;
-                while (p.dynamicTextureCache.size() > dynamicTextureCacheMax)
-                {
-                    auto texture = p.dynamicTextureCache.begin();
-                    p.dynamicTextures.emplace_back(texture->second);
-                    p.dynamicTextureCache.erase(texture);
-                }
-                while (p.dynamicTextures.size() > dynamicTextureCount)
-                {
-                    p.dynamicTextures.pop_back();
-                }
-#if !defined(DJV_OPENGL_ES2)
-                while (p.colorSpaceCache.size() > colorSpaceCacheMax)
+
+                // Move the least recently used textures to the pool until the
+                // cache fits in the budget. This is done at the end of the frame
+                // so that textures are not recycled while they are still
+                // referenced by primitives.
+                if (p.dynamicTextureCache.getCost() > p.dynamicTextureCacheMax)
                 {
-                    p.colorSpaceCache.erase(p.colorSpaceCache.begin());
-                    p.shader.reset();
+                    for (const auto& i : p.dynamicTextureCache.getKeys())
+                    {
+                        std::shared_ptr<OpenGL::Texture> texture;
+                        p.dynamicTextureCache.get(i, texture);
+                        p.dynamicTextureCache.remove(i);
+                        p.releaseDynamicTexture(texture);
+                        if (p.dynamicTextureCache.getCost() <= p.dynamicTextureCacheMax)
+                        {
+                            break;
+                        }
+                    }
                 }
-#endif // DJV_OPENGL_ES2
             }
             
             void Render::drawPolyline(const std::vector<glm::vec2>& value)
@@ -1009,6 +1090,29 @@ namespace djv
                 p.drawImage(image, pos, options, ColorMode::ColorAndTexture, _getCurrentTransform(), _currentClipRect, _finalColor);
             }
 
+            void Render::stageImages(const std::vector<std::shared_ptr<Image::Image> >& images)
+            {
+#if !defined(DJV_OPENGL_ES2)
+                DJV_PRIVATE_PTR();
+                p.textureStreamUpdate();
+                for (const auto& image : images)
+                {
+                    if (!image)
+                        continue;
+                    const UID uid = image->getUID();
+                    if (p.dynamicTextureCache.contains(uid) || p.textureStream->isStaged(uid))
+                        continue;
+                    auto texture = p.getDynamicTexture(image->getInfo());
+                    if (!p.textureStream->stage(image, texture))
+                    {
+                        p.releaseDynamicTexture(texture);
+                        break;
+                    }
+                    p.dynamicTextureUploadByteCount += image->getDataByteCount();
+                }
+#endif // DJV_OPENGL_ES2
+            }
+
             void Render::drawFilledImage(
                 const std::shared_ptr<Image::Image> & image,
                 const glm::vec2& pos,
@@ -1018,6 +1122,45 @@ namespace djv
                 p.drawImage(image, pos, options, ColorMode::ColorWithTextureAlpha, _getCurrentTransform(), _currentClipRect, _finalColor);
             }
 
+            size_t Render::getTextureCacheSize() const
+            {
+                return _p->dynamicTextureCacheMax;
+            }
+
+            void Render::setTextureCacheSize(size_t value)
+            {
+                _p->dynamicTextureCacheMax = value;
+            }
+
+            size_t Render::getLUTSize() const
+            {
+#if !defined(DJV_OPENGL_ES2)
+                return _p->lutSize;
+#else // DJV_OPENGL_ES2
+                return 0;
+#endif // DJV_OPENGL_ES2
+            }
+
+            void Render::setLUTSize(size_t value)
+            {
+#if !defined(DJV_OPENGL_ES2)
+                DJV_PRIVATE_PTR();
+                if (value == p.lutSize)
+                    return;
+                p.lutSize = value;
+                p.colorSpaceClear();
+#endif // DJV_OPENGL_ES2
+            }
+
+            bool Render::hasPendingColorSpaces() const
+            {
+#if !defined(DJV_OPENGL_ES2)
+                return _p->colorSpaceRequests.size() > 0;
+#else // DJV_OPENGL_ES2
+                return false;
+#endif // DJV_OPENGL_ES2
+            }
+
             void Render::setLCDText(bool value)
             {
                 _p->lcdText = value;
@@ -1452,7 +1595,27 @@ namespace djv
 
             size_t Render::getDynamicTextureCount() const
             {
-                return _p->dynamicTextureCache.size();
+                return _p->dynamicTextureCache.getSize();
+            }
+
+            size_t Render::getDynamicTextureByteCount() const
+            {
+                return _p->dynamicTextureCache.getCost();
+            }
+
+            size_t Render::getDynamicTextureHits() const
+            {
+                return _p->dynamicTextureHits;
+            }
+
+            size_t Render::getDynamicTextureMisses() const
+            {
+                return _p->dynamicTextureMisses;
+            }
+
+            uint64_t Render::getDynamicTextureUploadByteCount() const
+            {
+                return _p->dynamicTextureUploadByteCount;
             }
 
             size_t Render::getVBOSize() const
@@ -1463,16 +1626,14 @@ namespace djv
             void Render::_updateImageFilter()
             {
                 DJV_PRIVATE_PTR();
-                p.dynamicTextures.clear();
-                p.dynamicTextureCache.clear();
-                for (size_t i = 0; i < dynamicTextureCount; ++i)
+#if !defined(DJV_OPENGL_ES2)
+                if (p.textureStream)
                 {
-                    p.dynamicTextures.emplace_back(
-                        AV::OpenGL::Texture::create(
-                            AV::Image::Info(),
-                            toGL(p.imageFilterOptions.min),
-                            toGL(p.imageFilterOptions.mag)));
+                    p.textureStream->clear();
                 }
+#endif // DJV_OPENGL_ES2
+                p.dynamicTextureCache.clear();
+                p.dynamicTexturePool.clear();
             }
 
             void Render::Private::updateVBODataSize(size_t value)
@@ -1485,6 +1646,203 @@ namespace djv
                 }
             }
 
+            std::shared_ptr<OpenGL::Texture> Render::Private::getDynamicTexture(const Image::Info& info)
+            {
+                std::shared_ptr<OpenGL::Texture> out;
+                const auto i = dynamicTexturePool.find(getDynamicTextureFormat(info));
+                if (i != dynamicTexturePool.end() && i->second.size())
+                {
+                    out = i->second.back();
+                    i->second.pop_back();
+                    out->set(info);
+                }
+                else
+                {
+                    out = OpenGL::Texture::create(info, toGL(imageFilterOptions.min), toGL(imageFilterOptions.mag));
+                }
+                return out;
+            }
+
+            void Render::Private::releaseDynamicTexture(const std::shared_ptr<OpenGL::Texture>& value)
+            {
+                auto& pool = dynamicTexturePool[getDynamicTextureFormat(value->getInfo())];
+                if (pool.size() < dynamicTexturePoolMax)
+                {
+                    pool.push_back(value);
+                }
+            }
+
+            void Render::Private::addDynamicTexture(UID uid, const std::shared_ptr<OpenGL::Texture>& value)
+            {
+                dynamicTextureCache.add(uid, value, value->getInfo().getDataByteCount());
+            }
+
+            size_t Render::Private::getDynamicTexturePoolCount() const
+            {
+                size_t out = 0;
+                for (const auto& i : dynamicTexturePool)
+                {
+                    out += i.second.size();
+                }
+                return out;
+            }
+
+#if !defined(DJV_OPENGL_ES2)
+            void Render::Private::textureStreamUpdate()
+            {
+                for (const auto& i : textureStream->update())
+                {
+                    addDynamicTexture(i.first, i.second);
+                }
+            }
+
+            void Render::Private::colorSpaceUpdate()
+            {
+                // Discard the conversions when the configuration changes.
+                std::string currentConfigID;
+                try
+                {
+                    currentConfigID = OCIO::getCurrentConfigID();
+                }
+                catch (const std::exception& e)
+                {
+                    system->_log(e.what(), LogLevel::Error);
+                }
+                if (currentConfigID != configID)
+                {
+                    configID = currentConfigID;
+                    colorSpaceClear();
+                }
+
+                auto i = colorSpaceRequests.begin();
+                while (i != colorSpaceRequests.end())
+                {
+                    if (i->second.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    {
+                        ++i;
+                        continue;
+                    }
+                    try
+                    {
+                        const auto result = i->second.future.get();
+                        if (!result.error.empty())
+                        {
+                            system->_log(result.error, LogLevel::Error);
+                        }
+                        if (i->second.configID == configID &&
+                            i->second.lutSize == lutSize &&
+                            result.lut->configID == configID)
+                        {
+                            // Find an ID that is not used by the other conversions.
+                            ColorSpaceData colorSpaceData;
+                            colorSpaceData.id = 1;
+                            const auto values = colorSpaceCache.getValues();
+                            while (std::find_if(
+                                values.begin(),
+                                values.end(),
+                                [&colorSpaceData](const ColorSpaceData& value)
+                                {
+                                    return value.id == colorSpaceData.id;
+                                }) != values.end())
+                            {
+                                ++colorSpaceData.id;
+                            }
+
+                            std::stringstream ss;
+                            ss << "colorSpace" << colorSpaceData.id;
+                            colorSpaceData.shaderSource = result.lut->shaderSource;
+                            size_t index = colorSpaceData.shaderSource.find(OCIO::lutFunctionName);
+                            if (index != std::string::npos)
+                            {
+                                colorSpaceData.shaderSource.replace(index, OCIO::lutFunctionName.size(), ss.str());
+                            }
+                            index = colorSpaceData.shaderSource.find("texture3D");
+                            if (index != std::string::npos)
+                            {
+                                colorSpaceData.shaderSource.replace(index, std::string("texture3D").size(), "texture");
+                            }
+                            colorSpaceData.lut3D.reset(new LUT3D(result.lut->size));
+                            memcpy(
+                                colorSpaceData.lut3D->getData(),
+                                result.lut->data.data(),
+                                colorSpaceData.lut3D->getSize() * sizeof(float));
+                            colorSpaceData.lut3D->copy();
+
+                            // Adding the conversion may remove the least
+                            // recently used one from the cache.
+                            colorSpaceCache.add(i->first, colorSpaceData);
+                            shader.reset();
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        colorSpaceErrors.insert(i->first);
+                        system->_log(e.what(), LogLevel::Error);
+                    }
+                    i = colorSpaceRequests.erase(i);
+                }
+            }
+
+            void Render::Private::colorSpaceRequest(const OCIO::Convert& value)
+            {
+                if (colorSpaceRequests.find(value) != colorSpaceRequests.end() ||
+                    colorSpaceErrors.find(value) != colorSpaceErrors.end())
+                    return;
+
+                // Prepare the conversion on the worker thread. The lookup table is
+                // read from the disk cache if it exists, otherwise it is baked
+                // and written to the disk cache.
+                ColorSpaceRequest request;
+                request.configID = configID;
+                request.lutSize = lutSize;
+                const std::string key = OCIO::getLUTKey(configID, value, lutSize);
+                const std::string cachePath = lutCachePath;
+                const size_t size = lutSize;
+                request.future = colorSpaceThreadPool->push(
+                    [value, key, cachePath, size]
+                    {
+                        ColorSpaceResult out;
+                        const FileSystem::Path path(cachePath, OCIO::getLUTFileName(key));
+                        out.lut = OCIO::readLUT(path.get(), key);
+                        if (!out.lut)
+                        {
+                            out.lut = OCIO::bakeLUT(value, size);
+                            if (OCIO::getLUTKey(out.lut->configID, value, size) == key)
+                            {
+                                try
+                                {
+                                    const FileSystem::Path cacheDir(cachePath);
+                                    for (const auto& dir : { cacheDir.getDirectoryName(), cacheDir.get() })
+                                    {
+                                        if (!FileSystem::FileInfo(dir).doesExist())
+                                        {
+                                            FileSystem::Path::mkdir(FileSystem::Path(dir));
+                                        }
+                                    }
+                                    OCIO::writeLUT(path.get(), key, *out.lut);
+                                    OCIO::pruneLUTCache(cachePath, lutCacheByteCountMax);
+                                }
+                                catch (const std::exception& e)
+                                {
+                                    out.error = e.what();
+                                }
+                            }
+                        }
+                        return out;
+                    });
+                colorSpaceRequests[value] = std::move(request);
+            }
+
+            void Render::Private::colorSpaceClear()
+            {
+                // The requests that are still running are discarded when they
+                // finish.
+                colorSpaceCache.clear();
+                colorSpaceErrors.clear();
+                shader.reset();
+            }
+#endif // DJV_OPENGL_ES2
+
             void Render::Private::drawImage(
                 const std::shared_ptr<Image::Image>& image,
                 const glm::vec2& pos,
@@ -1604,26 +1962,27 @@ namespace djv
                     }
                     case ImageCache::Dynamic:
                     {
-                        const auto i = dynamicTextureCache.find(uid);
-                        if (i != dynamicTextureCache.end())
+                        std::shared_ptr<OpenGL::Texture> texture;
+                        if (dynamicTextureCache.get(uid, texture))
                         {
-                            primitive->textureID = i->second->getID();
+                            ++dynamicTextureHits;
+                            primitive->textureID = texture->getID();
                         }
                         else
                         {
-                            std::shared_ptr<OpenGL::Texture> texture;
-                            if (dynamicTextures.size())
-                            {
-                                texture = dynamicTextures.back();
-                                dynamicTextures.pop_back();
-                                texture->set(image->getInfo());
-                            }
-                            else
+                            ++dynamicTextureMisses;
+#if !defined(DJV_OPENGL_ES2)
+                            // Use the staged upload if there is one, otherwise
+                            // copy the image now.
+                            texture = textureStream->finish(uid);
+#endif // DJV_OPENGL_ES2
+                            if (!texture)
                             {
-                                texture = OpenGL::Texture::create(image->getInfo(), GL_LINEAR, GL_NEAREST);
+                                texture = getDynamicTexture(image->getInfo());
+                                texture->copy(*image);
+                                dynamicTextureUploadByteCount += image->getDataByteCount();
                             }
-                            texture->copy(*image);
-                            dynamicTextureCache[uid] = texture;
+                            addDynamicTexture(uid, texture);
                             primitive->textureID = texture->getID();
                         }
                         if (info.layout.mirror.x)
@@ -1664,44 +2023,17 @@ namespace djv
                     if (options.colorSpace.isValid())
                     {
                         ColorSpaceData colorSpaceData;
-                        const auto i = colorSpaceCache.find(options.colorSpace);
-                        if (i != colorSpaceCache.end())
+                        if (colorSpaceCache.get(options.colorSpace, colorSpaceData))
                         {
-                            colorSpaceData = i->second;
+                            primitive->colorSpace = colorSpaceData.id;
+                            primitive->colorSpaceTextureID = colorSpaceData.lut3D->getID();
                         }
                         else
                         {
-                            try
-                            {
-                                colorSpaceData.id = colorSpaceID++;
-                                colorSpaceData.lut3D.reset(new LUT3D);
-                                auto config = _OCIO::GetCurrentConfig();
-                                auto processor = config->getProcessor(options.colorSpace.input.c_str(), options.colorSpace.output.c_str());
-                                _OCIO::GpuShaderDesc shaderDesc;
-                                shaderDesc.setLanguage(_OCIO::GPU_LANGUAGE_GLSL_1_3);
-                                std::stringstream ss;
-                                ss << "colorSpace" << colorSpaceData.id;
-                                shaderDesc.setFunctionName(ss.str().c_str());
-                                shaderDesc.setLut3DEdgeLen(colorSpaceData.lut3D->getEdgeLen());
-                                colorSpaceData.shaderSource = processor->getGpuShaderText(shaderDesc);
-                                size_t index = colorSpaceData.shaderSource.find("texture3D");
-                                if (index != std::string::npos)
-                                {
-                                    colorSpaceData.shaderSource.replace(index, std::string("texture3D").size(), "texture");
-                                }
-                                auto data = colorSpaceData.lut3D->getData();
-                                processor->getGpuLut3D(data, shaderDesc);
-                                colorSpaceData.lut3D->copy();
-                                colorSpaceCache[options.colorSpace] = colorSpaceData;
-                                shader.reset();
-                            }
-                            catch (const std::exception& e)
-                            {
-                                system->_log(e.what());
-                            }
+                            // The image is drawn without the conversion until
+                            // it is ready.
+                            colorSpaceRequest(options.colorSpace);
                         }
-                        primitive->colorSpace = colorSpaceData.id;
-                        primitive->colorSpaceTextureID = colorSpaceData.lut3D ? colorSpaceData.lut3D->getID() : 0;
                     }
 #endif // DJV_OPENGL_ES2
                     primitive->type = GL_TRIANGLE_STRIP;
@@ -1741,21 +2073,21 @@ namespace djv
                 std::string body;
 #if !defined(DJV_OPENGL_ES2)
                 size_t i = 0;
-                for (const auto& j : colorSpaceCache)
+                for (const auto& j : colorSpaceCache.getValues())
                 {
-                    functions += j.second.shaderSource;
+                    functions += j.shaderSource;
                     {
                         std::stringstream ss;
                         if (0 == i)
                         {
-                            ss << "    if (" << j.second.id << " == colorSpace)\n";
+                            ss << "    if (" << j.id << " == colorSpace)\n";
                         }
                         else
                         {
-                            ss << "    else if (" << j.second.id << " == colorSpace)\n";
+                            ss << "    else if (" << j.id << " == colorSpace)\n";
                         }
                         ss << "    {\n";
-                        ss << "        t = colorSpace" << j.second.id << "(t, colorSpaceSampler);\n";
+                        ss << "        t = colorSpace" << j.id << "(t, colorSpaceSampler);\n";
                         ss << "    }\n";
                         body += ss.str();
                     }
@@ -161,6 +161,10 @@ namespace djv
                 bool operator != (const ImageFilterOptions&) const;
             };
 
+            //! This constant provides the default size of the dynamic image cache
+            //! in bytes.
+            const size_t textureCacheSizeDefault = 1024 * 1024 * 1024;
+
             //! This class provides a 2D render system.
             class Render : public Core::ISystem
             {
@@ -244,6 +248,33 @@ namespace djv
                     const glm::vec2& pos,
                     const ImageOptions & = ImageOptions());
 
+                //! Get the size of the dynamic image cache in bytes.
+                size_t getTextureCacheSize() const;
+
+                //! Set the size of the dynamic image cache in bytes. When the
+                //! cache is full the least recently used textures are recycled.
+                void setTextureCacheSize(size_t);
+
+                //! Get the size of the 3D lookup tables used for color space
+                //! conversions.
+                size_t getLUTSize() const;
+
+                //! Set the size of the 3D lookup tables used for color space
+                //! conversions.
+                void setLUTSize(size_t);
+
+                //! Get whether there are color space conversions being prepared.
+                //! Images are drawn without the conversion until it is ready, so
+                //! the frame should be drawn again.
+                bool hasPendingColorSpaces() const;
+
+                //! Stage images for upload ahead of drawing them with the
+                //! dynamic image cache, for example the next frames in the
+                //! playback direction. The uploads run asynchronously and
+                //! images that are still being uploaded when they are drawn
+                //! are finished then.
+                void stageImages(const std::vector<std::shared_ptr<Image::Image> >&);
+
                 ///@}
 
                 //! \name Text
@@ -275,6 +306,10 @@ namespace djv
 
                 float getTextureAtlasPercentage() const;
                 size_t getDynamicTextureCount() const;
+                size_t getDynamicTextureByteCount() const;
+                size_t getDynamicTextureHits() const;
+                size_t getDynamicTextureMisses() const;
+                uint64_t getDynamicTextureUploadByteCount() const;
                 size_t getVBOSize() const;
 
                 ///@}
@@ -4,23 +4,24 @@
 
 #include <djvAV/SequenceIO.h>
 
+#include <djvAV/FrameCache.h>
 #include <djvAV/ImageConvert.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/LogSystem.h>
-#include <djvCore/OS.h>
+#include <djvCore/Memory.h>
 #include <djvCore/Path.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
+#include <deque>
 #include <future>
+#include <thread>
 
 using namespace djv::Core;
 
@@ -41,12 +42,19 @@ namespace djv
             {
                 Frame::Number frame = Frame::invalid;
                 std::shared_ptr<Image::Image> image;
+                std::vector<std::pair<size_t, std::shared_ptr<Image::Image> > > layerImages;
             };
 
             struct ISequenceRead::Private
             {
                 Frame::Number frame = Frame::invalid;
                 std::promise<Info> infoPromise;
+                std::shared_ptr<ThreadPool> threadPool;
+                std::shared_ptr<FrameCache> frameCache;
+                FrameCache::Key cacheKey;
+                std::vector<size_t> cacheLayers;
+                UID cacheUID = 0;
+                size_t frameByteCount = 0;
                 std::vector<std::future<Future> > cacheFutures;
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
@@ -59,12 +67,39 @@ namespace djv
             void ISequenceRead::_init(
                 const FileSystem::FileInfo & fileInfo,
                 const ReadOptions& options,
+                const std::shared_ptr<ThreadPool>& threadPool,
+                const std::shared_ptr<FrameCache>& frameCache,
                 const std::shared_ptr<TextSystem>& textSystem,
                 const std::shared_ptr<ResourceSystem>& resourceSystem,
                 const std::shared_ptr<LogSystem>& logSystem)
             {
                 IRead::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
+
+                // Options that the reader does not support are cleared so that
+                // they do not change the cache key.
+                _options.proxy = getProxy(_options.proxy);
+                if (!hasROI())
+                {
+                    _options.roi = BBox2i();
+                }
+
                 _speed = Time::Speed();
+                _p->threadPool = threadPool;
+                _p->frameCache = frameCache;
+                _p->cacheKey = FrameCache::Key(fileInfo.getFileName(), _options.layer, _options.proxy, _options.roi);
+                for (auto i : options.cacheLayers)
+                {
+                    if (i != options.layer)
+                    {
+                        _p->cacheLayers.push_back(i);
+                    }
+                }
+                _p->cacheUID = createUID();
+                _videoQueue.setPopCallback(
+                    [this]
+                    {
+                        _p->queueCV.notify_one();
+                    });
                 _p->running = true;
                 _p->thread = std::thread(
                     [this]
@@ -137,13 +172,12 @@ namespace djv
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
                         }
-                        if (!cacheEnabled)
-                        {
-                            _cache.clear();
-                        }
                         if (info.video.size() && _options.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
+                            auto videoInfo = info.video[_options.layer].info;
+                            videoInfo.size = getProxySize(videoInfo.size, _options.proxy);
+                            const size_t dataByteCount = videoInfo.getDataByteCount();
+                            p.frameByteCount = dataByteCount;
                             _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
                             _cache.setSequenceSize(info.video[_options.layer].sequence.getSize());
                             _cache.setInOutPoints(inOutPoints);
@@ -211,9 +245,9 @@ namespace djv
                         if (delta.count() > infoTimeout)
                         {
                             p.infoTimer = now;
-                            size_t cacheByteCount = _cache.getTotalByteCount();
+                            size_t cacheByteCount = p.frameCache->getByteCount(p.cacheKey);
                             auto cacheSequence = _cache.getSequence();
-                            auto cachedFrames = _cache.getFrames();
+                            auto cachedFrames = p.frameCache->getFrames(p.cacheKey);
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 _cacheByteCount = cacheByteCount;
@@ -223,6 +257,18 @@ namespace djv
                         }
                     }
 
+                    // Wait for any jobs still in the thread pool since they
+                    // reference this reader.
+                    for (auto& i : p.cacheFutures)
+                    {
+                        if (i.valid())
+                        {
+                            i.wait();
+                        }
+                    }
+                    p.cacheFutures.clear();
+                    p.frameCache->removePlayhead(p.cacheUID);
+
                     p.running = false;
                 });
             }
@@ -249,6 +295,7 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
+                    _videoQueue.invalidateFrames();
                     p.seek = value;
                     _direction = direction;
                 }
@@ -276,21 +323,63 @@ namespace djv
 
             size_t ISequenceRead::_getQueueCount(size_t threadCount) const
             {
-                const size_t queueMax = _videoQueue.getMax() - _videoQueue.getCount();
+                const size_t max = _videoQueue.getMax();
+                const size_t count = _videoQueue.getCount();
+                const size_t queueMax = count < max ? (max - count) : 0;
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName)
+            std::vector<std::shared_ptr<Image::Image> > ISequenceRead::_readLayers(
+                const std::string& fileName,
+                const std::vector<size_t>& layers)
             {
-                return std::async(
-                    std::launch::async,
-                    [this, i, fileName]
+                std::vector<std::shared_ptr<Image::Image> > out(layers.size());
+                if (out.size())
+                {
+                    out[0] = _readImage(fileName);
+                }
+                return out;
+            }
+
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(
+                Frame::Number i,
+                std::string fileName,
+                ThreadPool::Priority priority,
+                bool cacheLayers)
+            {
+                std::vector<size_t> layers;
+                if (cacheLayers && _p->cacheLayers.size())
+                {
+                    layers.push_back(_options.layer);
+                    layers.insert(layers.end(), _p->cacheLayers.begin(), _p->cacheLayers.end());
+                }
+                return _p->threadPool->push(
+                    [this, i, fileName, layers]
                     {
                         Future out;
                         out.frame = i;
+                        if (!_p->running)
+                        {
+                            return out;
+                        }
                         try
                         {
-                            out.image = _readImage(fileName);
+                            if (layers.size())
+                            {
+                                const auto images = _readLayers(fileName, layers);
+                                out.image = images[0];
+                                for (size_t j = 1; j < images.size(); ++j)
+                                {
+                                    if (images[j])
+                                    {
+                                        out.layerImages.push_back(std::make_pair(layers[j], images[j]));
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                out.image = _readImage(fileName);
+                            }
                         }
                         catch (const std::exception& e)
                         {
@@ -300,7 +389,8 @@ namespace djv
                                 LogLevel::Error);
                         }
                         return out;
-                    });
+                    },
+                    priority);
             }
 
             size_t ISequenceRead::_readQueue(size_t count, bool loop, bool cacheEnabled)
@@ -314,7 +404,7 @@ namespace djv
                 for (size_t i = 0; i < count; ++i)
                 {
                     std::shared_ptr<Image::Image> cachedImage;
-                    if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    if (cacheEnabled && p.frameCache->get(p.cacheKey, p.frame, cachedImage))
                     {
                         images.push_back(std::make_pair(p.frame, cachedImage));
                     }
@@ -326,13 +416,13 @@ namespace djv
                             {
                                 const Frame::Number frameNumber = _sequence.getFrame(p.frame);
                                 const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                futures.push_back(_getFuture(p.frame, fileName, ThreadPool::Priority::High, cacheEnabled));
                             }
                         }
                         else
                         {
                             const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            futures.push_back(_getFuture(p.frame, fileName, ThreadPool::Priority::High, cacheEnabled));
                         }
                     }
 
@@ -366,10 +456,9 @@ namespace djv
                     images.push_back(std::make_pair(result.frame, result.image));
                     if (cacheEnabled)
                     {
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        // Memory mapped images are cached without copying, the
+                        // pages are shared with the operating system file cache.
+                        _cacheAdd(result);
                     }
                 }
 
@@ -400,14 +489,7 @@ namespace djv
                 DJV_PRIVATE_PTR();
 
                 // Get frames to be added to the cache.
-                Frame::Number frame = Frame::invalid;
-                {
-                    std::lock_guard<std::mutex> lock(_mutex);
-                    if (_videoQueue.getCount())
-                    {
-                        frame = _videoQueue.getFrame().frame;
-                    }
-                }
+                Frame::Number frame = _videoQueue.getFrameNumber();
                 if (count > 0 && frame != Frame::invalid)
                 {
                     const size_t sequenceSize = _sequence.getSize();
@@ -415,6 +497,14 @@ namespace djv
                     _cache.setDirection(p.direction);
                     _cache.setCurrentFrame(frame);
                     const size_t readBehind = _cache.getReadBehind();
+                    FrameCache::Playhead playhead;
+                    playhead.key = p.cacheKey;
+                    playhead.frame = frame;
+                    playhead.direction = p.direction;
+                    playhead.range = range;
+                    playhead.readBehind = readBehind;
+                    playhead.layers.insert(p.cacheLayers.begin(), p.cacheLayers.end());
+                    p.frameCache->setPlayhead(p.cacheUID, playhead);
                     switch (p.direction)
                     {
                     case Direction::Forward:
@@ -430,10 +520,16 @@ namespace djv
                         const size_t max = std::min(_cache.getMax(), sequenceSize);
                         for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (!p.frameCache->contains(p.cacheKey, frame))
                             {
+                                // Stop when the cache has no more room for
+                                // frames this far from the playhead.
+                                if (!p.frameCache->canAdd(p.cacheKey, frame, p.frameByteCount))
+                                {
+                                    break;
+                                }
                                 const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, fileName, ThreadPool::Priority::Low, true));
                             }
                             ++frame;
                             if (frame > range.max)
@@ -456,10 +552,16 @@ namespace djv
                         const size_t max = std::min(_cache.getMax(), sequenceSize);
                         for (Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
                         {
-                            if (!_cache.contains(frame))
+                            if (!p.frameCache->contains(p.cacheKey, frame))
                             {
+                                // Stop when the cache has no more room for
+                                // frames this far from the playhead.
+                                if (!p.frameCache->canAdd(p.cacheKey, frame, p.frameByteCount))
+                                {
+                                    break;
+                                }
                                 const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, fileName, ThreadPool::Priority::Low, true));
                             }
                             --frame;
                             if (frame < range.min)
@@ -480,11 +582,7 @@ namespace djv
                     if (i->valid() &&
                         i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        const auto result = i->get();
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        _cacheAdd(i->get());
                         i = p.cacheFutures.erase(i);
                     }
                     else
@@ -494,12 +592,32 @@ namespace djv
                 }
             }
 
+            void ISequenceRead::_cacheAdd(const Future& value)
+            {
+                DJV_PRIVATE_PTR();
+                p.frameCache->add(p.cacheKey, value.frame, value.image);
+                for (const auto& i : value.layerImages)
+                {
+                    FrameCache::Key key = p.cacheKey;
+                    key.layer = i.first;
+                    p.frameCache->add(key, value.frame, i.second);
+                }
+            }
+
+            struct ISequenceWrite::Future
+            {
+                std::string fileName;
+                bool error = false;
+                std::string errorString;
+            };
+
             struct ISequenceWrite::Private
             {
                 FileSystem::FileInfo fileInfo;
                 Frame::Number frameNumber = Frame::invalid;
-                GLFWwindow * glfwWindow = nullptr;
+                std::shared_ptr<ThreadPool> threadPool;
                 std::shared_ptr<Image::Convert> convert;
+                std::deque<std::future<Future> > futures;
                 std::thread thread;
                 std::atomic<bool> running;
             };
@@ -508,6 +626,7 @@ namespace djv
                 const FileSystem::FileInfo& fileInfo,
                 const Info& info,
                 const WriteOptions& options,
+                const std::shared_ptr<ThreadPool>& threadPool,
                 const std::shared_ptr<TextSystem>& textSystem,
                 const std::shared_ptr<ResourceSystem>& resourceSystem,
                 const std::shared_ptr<LogSystem>& logSystem)
@@ -533,148 +652,92 @@ namespace djv
                     }
                 }
 
-#if defined(DJV_OPENGL_ES2)
-                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-#else // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
-                {
-                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-                }
-                p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
-                if (!p.glfwWindow)
-                {
-                    throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
-                }
+                // The images are converted on the CPU so that writing does not
+                // require an OpenGL context, and each file is converted and
+                // written by a job on the I/O system thread pool.
+                p.threadPool = threadPool;
+                p.convert = Image::Convert::create(_resourceSystem, Image::ConvertBackend::CPU);
 
                 p.running = true;
                 p.thread = std::thread(
                     [this]
                 {
                     DJV_PRIVATE_PTR();
-                    try
+                    const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                    while (p.running)
                     {
-                        glfwMakeContextCurrent(p.glfwWindow);
-#if defined(DJV_OPENGL_ES2)
-                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
-#else
-                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-#endif
-                        {
-                            throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
-                        }
-
-                        p.convert = Image::Convert::create(_resourceSystem);
-
-                        const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
-                        while (p.running)
+                        // Start jobs for the queued frames. Frames are only
+                        // removed from the queue when a job is available, so a
+                        // full queue applies backpressure to the producer.
+                        bool queued = false;
+                        bool finished = false;
                         {
-                            std::vector<std::shared_ptr<Image::Image> > images;
-                            {
-                                std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
-                                if (lock.owns_lock())
-                                {
-                                    while (!_videoQueue.isEmpty() && images.size() < _threadCount)
-                                    {
-                                        auto frame = _videoQueue.popFrame();
-                                        images.push_back(frame.image);
-                                    }
-                                    if (_videoQueue.isEmpty() && _videoQueue.isFinished())
-                                    {
-                                        p.running = false;
-                                    }
-                                }
-                            }
-                            if (images.size())
+                            std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+                            if (lock.owns_lock())
                             {
-                                struct Future
-                                {
-                                    std::string fileName;
-                                    bool error = false;
-                                    std::string errorString;
-                                };
-                                std::vector<std::future<Future> > futures;
-                                for (size_t i = 0; i < images.size(); ++i)
+                                const size_t threadCount = std::max(_threadCount, static_cast<size_t>(1));
+                                while (!_videoQueue.isEmpty() && p.futures.size() < threadCount)
                                 {
+                                    const auto frame = _videoQueue.popFrame();
                                     const auto fileName = p.fileInfo.getFileName(p.frameNumber);
-                                    /*{
-                                        std::stringstream ss;
-                                        ss << "Writing: " << fileName;
-                                        _logSystem->log("djv::AV::IO::ISequenceWrite", ss.str());
-                                    }*/
                                     if (p.frameNumber != Frame::invalid)
                                     {
                                         ++p.frameNumber;
                                     }
-                                    auto image = images[i];
-                                    const Image::Type imageType = _getImageType(image->getType());
-                                    if (Image::Type::None == imageType)
-                                    {
-                                        throw FileSystem::Error(String::Format("{0}: {1}").
-                                            arg(fileName).
-                                            arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
-                                    }
-                                    const Image::Layout imageLayout = _getImageLayout();
-                                    if (imageType != image->getType() || imageLayout != image->getLayout())
-                                    {
-                                        const Image::Info imageInfo(image->getSize(), imageType, imageLayout);
-                                        auto tmp = Image::Image::create(imageInfo);
-                                        tmp->setTags(image->getTags());
-                                        p.convert->process(*image, imageInfo, *tmp);
-                                        image = tmp;
-                                    }
-                                    futures.push_back(std::async(
-                                        std::launch::async,
-                                        [this, fileName, image]
-                                        {
-                                            Future out;
-                                            out.fileName = fileName;
-                                            try
-                                            {
-                                                _write(fileName, image);
-                                            }
-                                            catch (const std::exception& e)
-                                            {
-                                                out.error = true;
-                                                out.errorString = e.what();
-                                            }
-                                            return out;
-                                        }));
-                                }
-                                for (auto& future : futures)
-                                {
-                                    const auto result = future.get();
-                                    if (result.error)
-                                    {
-                                        _logSystem->log(
-                                            "djv::AV::ISequenceWrite",
-                                            String::Format("{0}: {1}").arg(result.fileName).arg(result.errorString),
-                                            LogLevel::Error);
-                                        p.running = false;
-                                    }
+                                    p.futures.push_back(_getFuture(fileName, frame.image));
                                 }
+                                queued = !_videoQueue.isEmpty();
+                                finished = _videoQueue.isEmpty() && _videoQueue.isFinished();
+                            }
+                        }
+
+                        // Complete the jobs in the order that the frames were
+                        // queued. Writing stops at the first error.
+                        bool completed = false;
+                        while (p.running &&
+                            p.futures.size() &&
+                            p.futures.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            const auto result = p.futures.front().get();
+                            p.futures.pop_front();
+                            completed = true;
+                            if (result.error)
+                            {
+                                _logSystem->log(
+                                    "djv::AV::ISequenceWrite",
+                                    String::Format("{0}: {1}").arg(result.fileName).arg(result.errorString),
+                                    LogLevel::Error);
+                                p.running = false;
+                            }
+                        }
+
+                        if (finished && p.futures.empty())
+                        {
+                            p.running = false;
+                        }
+                        else if (!completed && !queued)
+                        {
+                            if (p.futures.size())
+                            {
+                                p.futures.front().wait_for(std::chrono::milliseconds(timeout));
                             }
                             else
                             {
                                 std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
                             }
                         }
-
-                        p.convert.reset();
                     }
-                    catch (const std::exception & e)
+
+                    // Wait for any jobs still in the thread pool since they
+                    // reference this writer.
+                    for (auto& i : p.futures)
                     {
-                        _logSystem->log("djv::AV::ISequenceWrite", e.what(), LogLevel::Error);
+                        if (i.valid())
+                        {
+                            i.wait();
+                        }
                     }
-
-                    p.running = false;
+                    p.futures.clear();
                 });
             }
 
@@ -700,6 +763,45 @@ namespace djv
                 return Image::Layout();
             }
 
+            std::future<ISequenceWrite::Future> ISequenceWrite::_getFuture(
+                const std::string& fileName,
+                const std::shared_ptr<Image::Image>& image)
+            {
+                return _p->threadPool->push(
+                    [this, fileName, image]
+                    {
+                        DJV_PRIVATE_PTR();
+                        Future out;
+                        out.fileName = fileName;
+                        try
+                        {
+                            const Image::Type imageType = _getImageType(image->getType());
+                            if (Image::Type::None == imageType)
+                            {
+                                throw FileSystem::Error(String::Format("{0}: {1}").
+                                    arg(fileName).
+                                    arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                            }
+                            const Image::Layout imageLayout = _getImageLayout();
+                            auto tmp = image;
+                            if (imageType != image->getType() || imageLayout != image->getLayout())
+                            {
+                                const Image::Info imageInfo(image->getSize(), imageType, imageLayout);
+                                tmp = Image::Image::create(imageInfo);
+                                tmp->setTags(image->getTags());
+                                p.convert->process(*image, imageInfo, *tmp);
+                            }
+                            _write(fileName, tmp);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            out.error = true;
+                            out.errorString = e.what();
+                        }
+                        return out;
+                    });
+            }
+
             void ISequenceWrite::_finish()
             {
                 DJV_PRIVATE_PTR();
@@ -709,10 +811,52 @@ namespace djv
                     //! \todo How do we safely detach the thread here so we don't block?
                     p.thread.join();
                 }
-                if (p.glfwWindow)
+            }
+
+            std::shared_ptr<Image::Image> readProxy(
+                const Image::Info& info,
+                size_t proxy,
+                const std::shared_ptr<FileSystem::FileIO>& io)
+            {
+                const size_t step = static_cast<size_t>(1) << std::min(proxy, proxyMax);
+                auto proxyInfo = info;
+                proxyInfo.size = getProxySize(info.size, proxy);
+                proxyInfo.layout.endian = Memory::getEndian();
+                auto out = Image::Image::create(proxyInfo);
+                out->setProxy(proxy);
+
+                // Read every step'th scanline and keep every step'th pixel.
+                const size_t pixelByteCount = info.getPixelByteCount();
+                const size_t scanlineByteCount = info.getScanlineByteCount();
+                std::vector<uint8_t> scanline(scanlineByteCount);
+                const size_t pos = io->getPos();
+                for (uint16_t y = 0; y < proxyInfo.size.h; ++y)
+                {
+                    io->setPos(pos + y * step * scanlineByteCount);
+                    io->read(scanline.data(), scanlineByteCount);
+                    const uint8_t* inP = scanline.data();
+                    uint8_t* outP = out->getData(y);
+                    for (uint16_t x = 0; x < proxyInfo.size.w; ++x, inP += step * pixelByteCount, outP += pixelByteCount)
+                    {
+                        memcpy(outP, inP, pixelByteCount);
+                    }
+                }
+
+                if (info.layout.endian != proxyInfo.layout.endian)
                 {
-                    glfwDestroyWindow(p.glfwWindow);
+                    const size_t dataByteCount = out->getDataByteCount();
+                    switch (Image::getDataType(info.type))
+                    {
+                        case Image::DataType::U10:
+                            Memory::endian(out->getData(), dataByteCount / 4, 4);
+                            break;
+                        case Image::DataType::U16:
+                            Memory::endian(out->getData(), dataByteCount / 2, 2);
+                            break;
+                        default: break;
+                    }
                 }
+                return out;
             }
 
             ISequencePlugin::~ISequencePlugin()
@@ -7,6 +7,7 @@
 #include <djvAV/IO.h>
 
 #include <djvCore/Frame.h>
+#include <djvCore/ThreadPool.h>
 
 namespace djv
 {
@@ -23,6 +24,8 @@ namespace djv
                 void _init(
                     const Core::FileSystem::FileInfo&,
                     const ReadOptions&,
+                    const std::shared_ptr<Core::ThreadPool>&,
+                    const std::shared_ptr<FrameCache>&,
                     const std::shared_ptr<Core::TextSystem>&,
                     const std::shared_ptr<Core::ResourceSystem>&,
                     const std::shared_ptr<Core::LogSystem>&);
@@ -39,6 +42,14 @@ namespace djv
             protected:
                 virtual Info _readInfo(const std::string & fileName) = 0;
                 virtual std::shared_ptr<Image::Image> _readImage(const std::string & fileName) = 0;
+
+                //! Read several layers in one pass, the first layer is the
+                //! current layer. Layers that are not read are returned as null
+                //! images. The default implementation only reads the current
+                //! layer.
+                virtual std::vector<std::shared_ptr<Image::Image> > _readLayers(
+                    const std::string & fileName,
+                    const std::vector<size_t>& layers);
                 void _finish();
 
                 Core::Time::Speed _speed;
@@ -48,7 +59,8 @@ namespace djv
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName);
+                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName, Core::ThreadPool::Priority, bool cacheLayers);
+                void _cacheAdd(const Future&);
                 size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
                 void _readCache(size_t count, const AV::IO::InOutPoints&);
 
@@ -65,6 +77,7 @@ namespace djv
                     const Core::FileSystem::FileInfo&,
                     const Info &,
                     const WriteOptions&,
+                    const std::shared_ptr<Core::ThreadPool>&,
                     const std::shared_ptr<Core::TextSystem>&,
                     const std::shared_ptr<Core::ResourceSystem>&,
                     const std::shared_ptr<Core::LogSystem>&);
@@ -78,6 +91,10 @@ namespace djv
             protected:
                 virtual Image::Type _getImageType(Image::Type) const;
                 virtual Image::Layout _getImageLayout() const;
+                //! Write an image to a file. This function is called
+                //! concurrently from jobs on the I/O system thread pool, one
+                //! job per file, so implementations must not modify shared
+                //! state without synchronization.
                 virtual void _write(const std::string & fileName, const std::shared_ptr<Image::Image> &) = 0;
                 void _finish();
 
@@ -85,9 +102,20 @@ namespace djv
                 Image::Info _imageInfo;
 
             private:
+                struct Future;
+                std::future<Future> _getFuture(const std::string& fileName, const std::shared_ptr<Image::Image>&);
+
                 DJV_PRIVATE();
             };
 
+            //! Read a reduced resolution image from uncompressed image data
+            //! starting at the current file position. Each proxy level skips
+            //! every other scanline and pixel.
+            std::shared_ptr<Image::Image> readProxy(
+                const Image::Info&,
+                size_t proxy,
+                const std::shared_ptr<Core::FileSystem::FileIO>&);
+
             //! This class provides an interface for sequence I/O plugins.
             class ISequencePlugin : public IPlugin
             {
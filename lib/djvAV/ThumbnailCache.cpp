@@ -0,0 +1,479 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ThumbnailCache.h>
+
+#include <djvAV/Image.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <list>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace
+        {
+            const std::string indexFileName = "index.txt";
+            const std::string fileExtension = ".thumb";
+            const uint32_t    fileVersion   = 1;
+            const uint32_t    stringMax     = 4096;
+
+            //! The minimum time between writes of the index file.
+            const std::chrono::seconds indexWriteInterval(1);
+
+            size_t getKey(
+                const FileSystem::FileInfo& fileInfo,
+                const Image::Size& size,
+                Image::Type type,
+                size_t optionsHash)
+            {
+                size_t out = optionsHash;
+                Memory::hashCombine(out, fileInfo.getFileName());
+                Memory::hashCombine(out, static_cast<int64_t>(fileInfo.getTime()));
+                Memory::hashCombine(out, fileInfo.getSize());
+                Memory::hashCombine(out, size.w);
+                Memory::hashCombine(out, size.h);
+                Memory::hashCombine(out, type);
+                return out;
+            }
+
+            std::string getKeyString(size_t value)
+            {
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(sizeof(size_t) * 2) << value;
+                return ss.str();
+            }
+
+            void writeString(const std::shared_ptr<FileSystem::FileIO>& io, const std::string& value)
+            {
+                io->writeU32(static_cast<uint32_t>(value.size()));
+                io->write(value.data(), value.size());
+            }
+
+            //! Replace a file with a temporary file that has been completely
+            //! written, so that readers never see a partially written file.
+            void replaceFile(const std::string& tmpFileName, const std::string& fileName)
+            {
+                if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                {
+                    // Windows does not allow renaming over an existing file.
+                    std::remove(fileName.c_str());
+                    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                    {
+                        std::remove(tmpFileName.c_str());
+                        throw FileSystem::Error(fileName);
+                    }
+                }
+            }
+
+            std::string readString(const std::shared_ptr<FileSystem::FileIO>& io)
+            {
+                uint32_t size = 0;
+                io->readU32(&size);
+                if (size > stringMax)
+                {
+                    throw std::runtime_error(io->getFileName());
+                }
+                std::string out(size, 0);
+                io->read(&out[0], size);
+                return out;
+            }
+
+        } // namespace
+
+        struct ThumbnailCache::Private
+        {
+            FileSystem::Path path;
+            size_t maxByteCount = 0;
+            size_t byteCount = 0;
+            struct Entry
+            {
+                size_t key;
+                size_t byteCount;
+            };
+            typedef std::list<Entry> List;
+            List list;
+            std::unordered_map<size_t, List::iterator> map;
+            std::mutex mutex;
+
+            std::atomic<size_t> tmpCount;
+            bool indexChanged = false;
+            std::chrono::steady_clock::time_point indexTime;
+            std::mutex indexMutex;
+
+            FileSystem::Path getFilePath(size_t key) const;
+            std::string getTmpFileName(const std::string&);
+            void remove(size_t key);
+            void removeOrphans();
+            void prune();
+        };
+
+        void ThumbnailCache::_init(const FileSystem::Path& path, size_t maxByteCount)
+        {
+            DJV_PRIVATE_PTR();
+            p.path = path;
+            p.maxByteCount = maxByteCount;
+            p.tmpCount = 0;
+            if (!FileSystem::FileInfo(path).doesExist())
+            {
+                FileSystem::Path::mkdir(path);
+            }
+            std::vector<std::string> lines;
+            try
+            {
+                lines = FileSystem::FileIO::readLines(FileSystem::Path(path, indexFileName).get());
+            }
+            catch (const std::exception&)
+            {}
+            for (const auto& line : lines)
+            {
+                std::stringstream ss(line);
+                size_t key = 0;
+                size_t byteCount = 0;
+                ss >> std::hex >> key >> std::dec >> byteCount;
+                if (ss && p.map.find(key) == p.map.end())
+                {
+                    p.list.push_back({ key, byteCount });
+                    p.map[key] = std::prev(p.list.end());
+                    p.byteCount += byteCount;
+                }
+            }
+            p.removeOrphans();
+            p.prune();
+        }
+
+        ThumbnailCache::ThumbnailCache() :
+            _p(new Private)
+        {}
+
+        ThumbnailCache::~ThumbnailCache()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.indexChanged)
+            {
+                try
+                {
+                    writeIndex();
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
+        std::shared_ptr<ThumbnailCache> ThumbnailCache::create(const FileSystem::Path& path, size_t maxByteCount)
+        {
+            auto out = std::shared_ptr<ThumbnailCache>(new ThumbnailCache);
+            out->_init(path, maxByteCount);
+            return out;
+        }
+
+        const FileSystem::Path& ThumbnailCache::getPath() const
+        {
+            return _p->path;
+        }
+
+        size_t ThumbnailCache::getMaxByteCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.maxByteCount;
+        }
+
+        void ThumbnailCache::setMaxByteCount(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.maxByteCount = value;
+            p.prune();
+        }
+
+        size_t ThumbnailCache::getByteCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.byteCount;
+        }
+
+        size_t ThumbnailCache::getCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.map.size();
+        }
+
+        std::shared_ptr<Image::Image> ThumbnailCache::get(
+            const FileSystem::FileInfo& fileInfo,
+            const Image::Size& size,
+            Image::Type type,
+            size_t optionsHash)
+        {
+            DJV_PRIVATE_PTR();
+            std::shared_ptr<Image::Image> out;
+            const size_t key = getKey(fileInfo, size, type, optionsHash);
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.map.find(key);
+                if (i == p.map.end())
+                {
+                    return out;
+                }
+                p.list.splice(p.list.end(), p.list, i->second);
+            }
+            try
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(p.getFilePath(key).get(), FileSystem::FileIO::Mode::Read);
+                uint32_t version = 0;
+                io->readU32(&version);
+                if (version != fileVersion)
+                {
+                    throw std::runtime_error(io->getFileName());
+                }
+                const std::string fileName = readString(io);
+                int64_t time = 0;
+                io->read(&time, 1, sizeof(int64_t));
+                uint64_t fileSize = 0;
+                io->read(&fileSize, 1, sizeof(uint64_t));
+                // Check that the key was not a hash collision.
+                if (fileName == fileInfo.getFileName() &&
+                    time == static_cast<int64_t>(fileInfo.getTime()) &&
+                    fileSize == fileInfo.getSize())
+                {
+                    Image::Info info;
+                    info.name = readString(io);
+                    io->readU16(&info.size.w);
+                    io->readU16(&info.size.h);
+                    uint32_t u32 = 0;
+                    io->readU32(&u32);
+                    if (u32 >= static_cast<uint32_t>(Image::Type::Count))
+                    {
+                        throw std::runtime_error(io->getFileName());
+                    }
+                    info.type = static_cast<Image::Type>(u32);
+                    io->readF32(&info.pixelAspectRatio);
+                    uint8_t u8 = 0;
+                    io->readU8(&u8);
+                    info.layout.mirror.x = u8 != 0;
+                    io->readU8(&u8);
+                    info.layout.mirror.y = u8 != 0;
+                    io->readU8(&u8);
+                    info.layout.alignment = u8;
+                    io->readU8(&u8);
+                    info.layout.endian = static_cast<Memory::Endian>(u8);
+                    const std::string pluginName = readString(io);
+                    auto image = Image::Image::create(info);
+                    io->read(image->getData(), image->getDataByteCount());
+                    image->setPluginName(pluginName);
+                    out = image;
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.remove(key);
+            }
+            return out;
+        }
+
+        void ThumbnailCache::add(
+            const FileSystem::FileInfo& fileInfo,
+            const Image::Size& size,
+            Image::Type type,
+            const std::shared_ptr<Image::Image>& image,
+            size_t optionsHash)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t key = getKey(fileInfo, size, type, optionsHash);
+            size_t byteCount = 0;
+            // Other threads may be reading or writing the same thumbnail, so
+            // write it to a temporary file first.
+            const std::string fileName = p.getFilePath(key).get();
+            const std::string tmpFileName = p.getTmpFileName(fileName);
+            try
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(tmpFileName, FileSystem::FileIO::Mode::Write);
+                io->writeU32(fileVersion);
+                writeString(io, fileInfo.getFileName());
+                const int64_t time = static_cast<int64_t>(fileInfo.getTime());
+                io->write(&time, 1, sizeof(int64_t));
+                const uint64_t fileSize = fileInfo.getSize();
+                io->write(&fileSize, 1, sizeof(uint64_t));
+                const auto& info = image->getInfo();
+                writeString(io, info.name);
+                io->writeU16(info.size.w);
+                io->writeU16(info.size.h);
+                io->writeU32(static_cast<uint32_t>(info.type));
+                io->writeF32(info.pixelAspectRatio);
+                io->writeU8(info.layout.mirror.x);
+                io->writeU8(info.layout.mirror.y);
+                io->writeU8(static_cast<uint8_t>(info.layout.alignment));
+                io->writeU8(static_cast<uint8_t>(info.layout.endian));
+                writeString(io, image->getPluginName());
+                io->write(image->getData(), image->getDataByteCount());
+                byteCount = io->getSize();
+                std::string error;
+                if (!io->close(&error))
+                {
+                    throw FileSystem::Error(error);
+                }
+                replaceFile(tmpFileName, fileName);
+            }
+            catch (const std::exception&)
+            {
+                std::remove(tmpFileName.c_str());
+                return;
+            }
+            bool writeIndex = false;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                const auto i = p.map.find(key);
+                if (i != p.map.end())
+                {
+                    p.byteCount -= i->second->byteCount;
+                    i->second->byteCount = byteCount;
+                    p.list.splice(p.list.end(), p.list, i->second);
+                }
+                else
+                {
+                    p.list.push_back({ key, byteCount });
+                    p.map[key] = std::prev(p.list.end());
+                }
+                p.byteCount += byteCount;
+                p.prune();
+
+                // Write the index periodically so that the thumbnails are
+                // not lost if the application does not exit cleanly.
+                p.indexChanged = true;
+                const auto now = std::chrono::steady_clock::now();
+                if (now - p.indexTime >= indexWriteInterval)
+                {
+                    p.indexTime = now;
+                    writeIndex = true;
+                }
+            }
+            if (writeIndex)
+            {
+                try
+                {
+                    this->writeIndex();
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
+        void ThumbnailCache::clear()
+        {
+            DJV_PRIVATE_PTR();
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                while (!p.list.empty())
+                {
+                    p.remove(p.list.front().key);
+                }
+            }
+            writeIndex();
+        }
+
+        void ThumbnailCache::writeIndex()
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> indexLock(p.indexMutex);
+            std::vector<std::string> lines;
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                for (const auto& i : p.list)
+                {
+                    std::stringstream ss;
+                    ss << getKeyString(i.key) << " " << i.byteCount;
+                    lines.push_back(ss.str());
+                }
+                p.indexChanged = false;
+            }
+            const std::string fileName = FileSystem::Path(p.path, indexFileName).get();
+            const std::string tmpFileName = p.getTmpFileName(fileName);
+            FileSystem::FileIO::writeLines(tmpFileName, lines);
+            replaceFile(tmpFileName, fileName);
+        }
+
+        FileSystem::Path ThumbnailCache::Private::getFilePath(size_t key) const
+        {
+            return FileSystem::Path(path, getKeyString(key) + fileExtension);
+        }
+
+        std::string ThumbnailCache::Private::getTmpFileName(const std::string& fileName)
+        {
+            std::stringstream ss;
+            ss << fileName << "." << tmpCount++ << ".tmp";
+            return ss.str();
+        }
+
+        void ThumbnailCache::Private::remove(size_t key)
+        {
+            const auto i = map.find(key);
+            if (i != map.end())
+            {
+                try
+                {
+                    FileSystem::Path::rm(getFilePath(key));
+                }
+                catch (const std::exception&)
+                {}
+                byteCount -= i->second->byteCount;
+                list.erase(i->second);
+                map.erase(i);
+                indexChanged = true;
+            }
+        }
+
+        void ThumbnailCache::Private::removeOrphans()
+        {
+            // Remove the temporary files left by interrupted writes and the
+            // thumbnails that are not in the index, which are not counted
+            // towards the maximum size.
+            std::set<std::string> fileNames;
+            for (const auto& i : list)
+            {
+                fileNames.insert(getKeyString(i.key) + fileExtension);
+            }
+            for (const auto& i : FileSystem::FileInfo::directoryList(path))
+            {
+                if (i.getType() != FileSystem::FileType::File)
+                    continue;
+                const std::string fileName = i.getFileName(Frame::invalid, false);
+                const std::string extension = i.getPath().getExtension();
+                if (".tmp" == extension ||
+                    (fileExtension == extension && fileNames.find(fileName) == fileNames.end()))
+                {
+                    std::remove(i.getFileName().c_str());
+                }
+            }
+        }
+
+        void ThumbnailCache::Private::prune()
+        {
+            while (byteCount > maxByteCount && !list.empty())
+            {
+                remove(list.front().key);
+            }
+        }
+
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/Pixel.h>
+
+#include <djvCore/Core.h>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            class FileInfo;
+            class Path;
+
+        } // namespace FileSystem
+    } // namespace Core
+
+    namespace AV
+    {
+        namespace Image
+        {
+            class Size;
+            class Image;
+
+        } // namespace Image
+
+        //! This class provides a persistent cache of thumbnail images.
+        //!
+        //! Each thumbnail is stored in its own file in the cache directory. The
+        //! thumbnails are keyed by the file name, modification time, and size of
+        //! the source file, the requested thumbnail size and type, and a hash of
+        //! the I/O options, so thumbnails are regenerated when the source file
+        //! or the options used to read it change.
+        //!
+        //! The cache directory also contains an index file that lists the
+        //! thumbnails from the least to the most recently used. The index is
+        //! read when the cache is created, and written periodically as
+        //! thumbnails are added and when the cache is destroyed. Files are
+        //! written to a temporary file and renamed so that they are never
+        //! read partially written. When the cache is created, temporary files
+        //! and thumbnails that are not in the index are removed.
+        //! When the total size of the thumbnails exceeds the maximum, the least
+        //! recently used thumbnails are removed.
+        //!
+        //! This class is thread safe.
+        class ThumbnailCache : public std::enable_shared_from_this<ThumbnailCache>
+        {
+            DJV_NON_COPYABLE(ThumbnailCache);
+            void _init(const Core::FileSystem::Path&, size_t maxByteCount);
+            ThumbnailCache();
+
+        public:
+            ~ThumbnailCache();
+
+            //! Create a new thumbnail cache. The directory is created if it
+            //! does not exist.
+            static std::shared_ptr<ThumbnailCache> create(const Core::FileSystem::Path&, size_t maxByteCount);
+
+            const Core::FileSystem::Path& getPath() const;
+
+            size_t getMaxByteCount() const;
+            void setMaxByteCount(size_t);
+
+            size_t getByteCount() const;
+            size_t getCount() const;
+
+            //! Get a thumbnail, returns nullptr if the thumbnail is not in the cache.
+            std::shared_ptr<Image::Image> get(
+                const Core::FileSystem::FileInfo&,
+                const Image::Size&,
+                Image::Type,
+                size_t optionsHash = 0);
+
+            //! Add a thumbnail to the cache.
+            void add(
+                const Core::FileSystem::FileInfo&,
+                const Image::Size&,
+                Image::Type,
+                const std::shared_ptr<Image::Image>&,
+                size_t optionsHash = 0);
+
+            //! Remove all of the thumbnails.
+            void clear();
+
+            //! Write the index file.
+            void writeIndex();
+
+        private:
+            DJV_PRIVATE();
+        };
+
+    } // namespace AV
+} // namespace djv
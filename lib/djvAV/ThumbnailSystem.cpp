@@ -4,9 +4,11 @@
 
 #include <djvAV/ThumbnailSystem.h>
 
+#include <djvAV/GLFWSystem.h>
 #include <djvAV/Image.h>
 #include <djvAV/ImageConvert.h>
 #include <djvAV/IO.h>
+#include <djvAV/ThumbnailCache.h>
 
 #include <djvCore/Cache.h>
 #include <djvCore/Context.h>
@@ -19,7 +21,11 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <list>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -31,23 +37,32 @@ namespace djv
     {
         namespace
         {
-            //! \todo Should this be configurable?
-            const size_t infoProcessMax  = 4;
-            const size_t imageProcessMax = 4;
             const size_t infoCacheMax    = 1000;
             const size_t imageCacheMax   = 1000;
+            const size_t diskCacheMax    = 1024 * Memory::megabyte;
+
+            size_t getThreadCountDefault()
+            {
+                const int env = OS::getIntEnv("DJV_THUMBNAIL_THREAD_COUNT");
+                if (env > 0)
+                {
+                    return static_cast<size_t>(env);
+                }
+                return std::max(static_cast<size_t>(std::thread::hardware_concurrency() / 2), static_cast<size_t>(2));
+            }
 
             struct InfoRequest
             {
                 InfoRequest() :
-                    uid(createUID())
+                    uid(createUID()),
+                    canceled(new std::atomic<bool>(false))
                 {}
 
                 InfoRequest(InfoRequest&& other) noexcept :
                     uid(other.uid),
                     fileInfo(other.fileInfo),
-                    read(std::move(other.read)),
-                    infoFuture(std::move(other.infoFuture)),
+                    priority(other.priority),
+                    canceled(std::move(other.canceled)),
                     promise(std::move(other.promise))
                 {}
 
@@ -60,8 +75,8 @@ namespace djv
                     {
                         uid = other.uid;
                         fileInfo = other.fileInfo;
-                        read = std::move(other.read);
-                        infoFuture = std::move(other.infoFuture);
+                        priority = other.priority;
+                        canceled = std::move(other.canceled);
                         promise = std::move(other.promise);
                     }
                     return *this;
@@ -69,15 +84,16 @@ namespace djv
 
                 UID uid = 0;
                 FileSystem::FileInfo fileInfo;
-                std::shared_ptr<IO::IRead> read;
-                std::future<IO::Info> infoFuture;
+                size_t priority = 0;
+                std::shared_ptr<std::atomic<bool> > canceled;
                 std::promise<IO::Info> promise;
             };
 
             struct ImageRequest
             {
                 ImageRequest() :
-                    uid(createUID())
+                    uid(createUID()),
+                    canceled(new std::atomic<bool>(false))
                 {}
 
                 ImageRequest(ImageRequest && other) noexcept :
@@ -85,7 +101,8 @@ namespace djv
                     fileInfo(other.fileInfo),
                     size(std::move(other.size)),
                     type(std::move(other.type)),
-                    read(std::move(other.read)),
+                    priority(other.priority),
+                    canceled(std::move(other.canceled)),
                     promise(std::move(other.promise))
                 {}
 
@@ -100,7 +117,8 @@ namespace djv
                         fileInfo = other.fileInfo;
                         size = std::move(other.size);
                         type = std::move(other.type);
-                        read = std::move(other.read);
+                        priority = other.priority;
+                        canceled = std::move(other.canceled);
                         promise = std::move(other.promise);
                     }
                     return *this;
@@ -110,10 +128,33 @@ namespace djv
                 FileSystem::FileInfo fileInfo;
                 Image::Size size;
                 Image::Type type = Image::Type::None;
-                std::shared_ptr<IO::IRead> read;
+                size_t priority = 0;
+                std::shared_ptr<std::atomic<bool> > canceled;
                 std::promise<std::shared_ptr<Image::Image> > promise;
             };
 
+            //! This struct provides an image waiting to be converted with OpenGL.
+            struct ConvertRequest
+            {
+                ImageRequest request;
+                std::shared_ptr<Image::Image> image;
+                Image::Info info;
+            };
+
+            //! Get the next request to handle, which is the oldest request with
+            //! the lowest priority value.
+            template<typename T>
+            typename std::list<T>::iterator getNextRequest(std::list<T>& value)
+            {
+                return std::min_element(
+                    value.begin(),
+                    value.end(),
+                    [](const T& a, const T& b)
+                    {
+                        return a.priority < b.priority;
+                    });
+            }
+
             size_t getInfoCacheKey(const FileSystem::FileInfo & fileInfo)
             {
                 size_t out = 0;
@@ -131,6 +172,46 @@ namespace djv
                 return out;
             }
 
+            size_t getOptionsHash(const std::shared_ptr<IO::System>& io)
+            {
+                size_t out = 0;
+                for (const auto& i : io->getPluginNames())
+                {
+                    Memory::hashCombine(out, i);
+                    Memory::hashCombine(out, io->getOptions(i).serialize());
+                }
+                return out;
+            }
+
+            //! Get the information for converting an image to a thumbnail. Returns
+            //! false if the image does not need to be converted.
+            bool getConvertInfo(
+                const Image::Image& image,
+                const Image::Size& size,
+                Image::Type type,
+                Image::Info& out)
+            {
+                Image::Size imageSize = image.getSize();
+                imageSize.w *= image.getInfo().pixelAspectRatio;
+                if (size != imageSize || type != Image::Type::None)
+                {
+                    Image::Size convertSize = size;
+                    const float aspect = convertSize.h != 0 ? (convertSize.w / static_cast<float>(convertSize.h)) : 1.F;
+                    const float imageAspect = imageSize.h != 0 ? (imageSize.w / static_cast<float>(imageSize.h)) : 1.F;
+                    if (imageAspect < aspect)
+                    {
+                        convertSize.w = static_cast<uint16_t>(convertSize.h * imageAspect);
+                    }
+                    else
+                    {
+                        convertSize.h = static_cast<int>(convertSize.w / imageAspect);
+                    }
+                    out = Image::Info(convertSize, type != Image::Type::None ? type : image.getType());
+                    return true;
+                }
+                return false;
+            }
+
         } // namespace
         
         ThumbnailSystem::InfoFuture::InfoFuture()
@@ -156,26 +237,48 @@ namespace djv
         struct ThumbnailSystem::Private
         {
             std::shared_ptr<TextSystem> textSystem;
+            std::shared_ptr<LogSystem> logSystem;
             std::shared_ptr<IO::System> io;
 
             std::list<InfoRequest> infoRequests;
             std::list<ImageRequest> imageRequests;
+            std::map<UID, std::shared_ptr<std::atomic<bool> > > activeRequests;
             std::condition_variable requestCV;
             std::mutex requestMutex;
-            std::list<InfoRequest> pendingInfoRequests;
-            std::list<ImageRequest> pendingImageRequests;
+
+            std::list<ConvertRequest> convertRequests;
+            std::condition_variable convertCV;
+            std::mutex convertMutex;
 
             Memory::Cache<size_t, IO::Info> infoCache;
             std::atomic<float> infoCachePercentage;
             Memory::Cache<size_t, std::shared_ptr<Image::Image> > imageCache;
             std::atomic<float> imageCachePercentage;
-            std::atomic<bool> clearCache;
+            std::mutex cacheMutex;
+            std::shared_ptr<ThumbnailCache> diskCache;
+            std::atomic<size_t> optionsHash;
             std::shared_ptr<ValueObserver<bool> > ioOptionsObserver;
 
+            Image::ConvertBackend convertBackend = Image::ConvertBackend::OpenGL;
             GLFWwindow * glfwWindow = nullptr;
             std::shared_ptr<Time::Timer> statsTimer;
-            std::thread thread;
+            size_t threadCount = 0;
+            std::vector<std::thread> threads;
+            std::thread convertThread;
             std::atomic<bool> running;
+
+            void log(const std::string&, LogLevel = LogLevel::Information);
+
+            bool isCanceled(const std::shared_ptr<std::atomic<bool> >&) const;
+            std::shared_ptr<IO::IRead> read(
+                const FileSystem::FileInfo&,
+                const std::shared_ptr<std::atomic<bool> >& canceled,
+                IO::Info&);
+
+            void handleInfoRequest(InfoRequest&);
+            void handleImageRequest(ImageRequest&, const std::shared_ptr<Image::Convert>&);
+            void convertImage(ImageRequest&, std::shared_ptr<Image::Image>, const Image::Info&, const std::shared_ptr<Image::Convert>&);
+            void finishImageRequest(ImageRequest&, const std::shared_ptr<Image::Image>&);
         };
 
         void ThumbnailSystem::_init(const std::shared_ptr<Core::Context>& context)
@@ -185,34 +288,56 @@ namespace djv
             DJV_PRIVATE_PTR();
 
             p.textSystem = context->getSystemT<TextSystem>();
+            p.logSystem = context->getSystemT<LogSystem>();
             p.io = context->getSystemT<IO::System>();
             addDependency(p.io);
+            auto glfwSystem = context->getSystemT<GLFW::System>();
+            if (glfwSystem)
+            {
+                addDependency(glfwSystem);
+            }
 
             p.infoCache.setMax(infoCacheMax);
             p.infoCachePercentage = 0.F;
             p.imageCache.setMax(imageCacheMax);
             p.imageCachePercentage = 0.F;
-            p.clearCache = false;
-
+            p.optionsHash = getOptionsHash(p.io);
+
+            // Thumbnails are converted with OpenGL when a context can be
+            // created, otherwise they are converted on the CPU which does not
+            // require a display. The DJV_CPU_IMAGE_CONVERT environment variable
+            // forces the CPU conversion.
+            p.convertBackend = OS::getIntEnv("DJV_CPU_IMAGE_CONVERT") != 0 || !glfwSystem ?
+                Image::ConvertBackend::CPU :
+                Image::ConvertBackend::OpenGL;
+            if (Image::ConvertBackend::OpenGL == p.convertBackend)
+            {
 #if defined(DJV_OPENGL_ES2)
-            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_OPENGL_ES2
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_OPENGL_ES2
-            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-            if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
-            {
-                glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
+                {
+                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                }
+                p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
+                if (!p.glfwWindow)
+                {
+                    _log(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")), LogLevel::Warning);
+                    p.convertBackend = Image::ConvertBackend::CPU;
+                }
             }
-            p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
-            if (!p.glfwWindow)
             {
-                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                std::stringstream ss;
+                ss << "Convert backend: " << (Image::ConvertBackend::CPU == p.convertBackend ? "CPU" : "OpenGL");
+                _log(ss.str());
             }
 
             p.statsTimer = Time::Timer::create(context);
@@ -226,75 +351,162 @@ namespace djv
                 {
                     ss << "Info cache: " << p.infoCachePercentage << "%\n";
                     ss << "Image cache: " << p.imageCachePercentage << '%';
+                    if (p.diskCache)
+                    {
+                        ss << "\nDisk cache: " << p.diskCache->getCount() << " thumbnails, " <<
+                            p.diskCache->getByteCount() / Memory::megabyte << "MB";
+                    }
                 }
                 _log(ss.str());
             });
 
-            auto logSystem = context->getSystemT<LogSystem>();
             auto resourceSystem = context->getSystemT<ResourceSystem>();
+            try
+            {
+                p.diskCache = ThumbnailCache::create(
+                    FileSystem::Path(resourceSystem->getPath(FileSystem::ResourcePath::Documents), "ThumbnailCache"),
+                    diskCacheMax);
+            }
+            catch (const std::exception& e)
+            {
+                _log(e.what(), LogLevel::Error);
+            }
+
             p.running = true;
-            p.thread = std::thread(
-                [this, resourceSystem, logSystem]
+            if (p.glfwWindow)
             {
-                DJV_PRIVATE_PTR();
-                try
+                // All of the OpenGL conversions are done on one thread that
+                // owns the context.
+                p.convertThread = std::thread(
+                    [this, resourceSystem]
                 {
-                    glfwMakeContextCurrent(p.glfwWindow);
+                    DJV_PRIVATE_PTR();
+                    try
+                    {
+                        glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_OPENGL_ES2)
-                    if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else // DJV_OPENGL_ES2
-                    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif // DJV_OPENGL_ES2
-                    {
-                        throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
-                    }
-
-                    auto convert = Image::Convert::create(resourceSystem);
-
-                    const auto timeout = Time::getValue(Time::TimerValue::Medium);
-                    while (p.running)
-                    {
-                        if (p.clearCache)
                         {
-                            p.clearCache = false;
-                            p.infoCache.clear();
-                            p.infoCachePercentage = 0.F;
-                            p.imageCache.clear();
-                            p.imageCachePercentage = 0.F;
+                            throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
                         }
 
-                        bool infoRequests  = p.pendingInfoRequests.size();
-                        bool imageRequests = p.pendingImageRequests.size();
+                        auto convert = Image::Convert::create(resourceSystem);
+
+                        const auto timeout = Time::getValue(Time::TimerValue::Medium);
+                        while (p.running)
                         {
-                            std::unique_lock<std::mutex> lock(p.requestMutex);
-                            if (p.requestCV.wait_for(
-                                lock,
-                                std::chrono::milliseconds(timeout),
-                                [this]
+                            std::list<ConvertRequest> requests;
                             {
-                                DJV_PRIVATE_PTR();
-                                return p.infoRequests.size() || p.imageRequests.size();
-                            }))
+                                std::unique_lock<std::mutex> lock(p.convertMutex);
+                                if (p.convertCV.wait_for(
+                                    lock,
+                                    std::chrono::milliseconds(timeout),
+                                    [this]
+                                {
+                                    DJV_PRIVATE_PTR();
+                                    return p.convertRequests.size() > 0;
+                                }))
+                                {
+                                    std::swap(requests, p.convertRequests);
+                                }
+                            }
+                            for (auto& i : requests)
                             {
-                                infoRequests  |= p.infoRequests.size () > 0;
-                                imageRequests |= p.imageRequests.size() > 0;
+                                if (!p.isCanceled(i.request.canceled))
+                                {
+                                    p.convertImage(i.request, i.image, i.info, convert);
+                                }
                             }
                         }
-                        if (infoRequests)
+                    }
+                    catch (const std::exception & e)
+                    {
+                        p.log(e.what(), LogLevel::Error);
+                    }
+                });
+            }
+
+            p.threadCount = getThreadCountDefault();
+            for (size_t i = 0; i < p.threadCount; ++i)
+            {
+                p.threads.push_back(std::thread(
+                    [this, resourceSystem]
+                {
+                    DJV_PRIVATE_PTR();
+                    try
+                    {
+                        // With the CPU backend each thread converts its own
+                        // thumbnails, otherwise the images are passed to the
+                        // OpenGL thread.
+                        std::shared_ptr<Image::Convert> convert;
+                        if (Image::ConvertBackend::CPU == p.convertBackend)
                         {
-                            _handleInfoRequests();
+                            convert = Image::Convert::create(resourceSystem, Image::ConvertBackend::CPU);
                         }
-                        if (imageRequests)
+
+                        const auto timeout = Time::getValue(Time::TimerValue::Medium);
+                        while (p.running)
                         {
-                            _handleImageRequests(convert);
+                            InfoRequest infoRequest;
+                            ImageRequest imageRequest;
+                            bool info = false;
+                            bool image = false;
+                            {
+                                std::unique_lock<std::mutex> lock(p.requestMutex);
+                                if (p.requestCV.wait_for(
+                                    lock,
+                                    std::chrono::milliseconds(timeout),
+                                    [this]
+                                {
+                                    DJV_PRIVATE_PTR();
+                                    return p.infoRequests.size() || p.imageRequests.size();
+                                }))
+                                {
+                                    // Information requests are handled first since
+                                    // they are less expensive.
+                                    const auto i = getNextRequest(p.infoRequests);
+                                    const auto j = getNextRequest(p.imageRequests);
+                                    if (i != p.infoRequests.end() &&
+                                        (j == p.imageRequests.end() || i->priority <= j->priority))
+                                    {
+                                        infoRequest = std::move(*i);
+                                        p.infoRequests.erase(i);
+                                        p.activeRequests[infoRequest.uid] = infoRequest.canceled;
+                                        info = true;
+                                    }
+                                    else if (j != p.imageRequests.end())
+                                    {
+                                        imageRequest = std::move(*j);
+                                        p.imageRequests.erase(j);
+                                        p.activeRequests[imageRequest.uid] = imageRequest.canceled;
+                                        image = true;
+                                    }
+                                }
+                            }
+                            if (info)
+                            {
+                                p.handleInfoRequest(infoRequest);
+                            }
+                            else if (image)
+                            {
+                                p.handleImageRequest(imageRequest, convert);
+                            }
+                            if (info || image)
+                            {
+                                std::unique_lock<std::mutex> lock(p.requestMutex);
+                                p.activeRequests.erase(info ? infoRequest.uid : imageRequest.uid);
+                            }
                         }
                     }
-                }
-                catch (const std::exception & e)
-                {
-                    logSystem->log("djv::AV::ThumbnailSystem", e.what(), LogLevel::Error);
-                }
-            });
+                    catch (const std::exception & e)
+                    {
+                        p.log(e.what(), LogLevel::Error);
+                    }
+                }));
+            }
 
             auto weak = std::weak_ptr<ThumbnailSystem>(std::dynamic_pointer_cast<ThumbnailSystem>(shared_from_this()));
             p.ioOptionsObserver = ValueObserver<bool>::create(
@@ -305,6 +517,7 @@ namespace djv
                     {
                         if (auto system = weak.lock())
                         {
+                            system->_p->optionsHash = getOptionsHash(system->_p->io);
                             system->clearCache();
                         }
                     }
@@ -319,9 +532,25 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             p.running = false;
-            if (p.thread.joinable())
             {
-                p.thread.join();
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                for (auto& i : p.activeRequests)
+                {
+                    *i.second = true;
+                }
+            }
+            p.requestCV.notify_all();
+            p.convertCV.notify_all();
+            for (auto& i : p.threads)
+            {
+                if (i.joinable())
+                {
+                    i.join();
+                }
+            }
+            if (p.convertThread.joinable())
+            {
+                p.convertThread.join();
             }
             if (p.glfwWindow)
             {
@@ -336,18 +565,20 @@ namespace djv
             return out;
         }
 
-        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const FileSystem::FileInfo & fileInfo)
+        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const FileSystem::FileInfo & fileInfo, size_t priority)
         {
             DJV_PRIVATE_PTR();
             InfoRequest request;
             request.fileInfo = fileInfo;
+            request.priority = priority;
             auto future = request.promise.get_future();
+            const UID uid = request.uid;
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
                 p.infoRequests.push_back(std::move(request));
             }
             p.requestCV.notify_one();
-            return InfoFuture(future, request.uid);
+            return InfoFuture(future, uid);
         }
         
         void ThumbnailSystem::cancelInfo(UID uid)
@@ -366,26 +597,37 @@ namespace djv
                 {
                     p.infoRequests.erase(--(i.base()));
                 }
+                else
+                {
+                    const auto j = p.activeRequests.find(uid);
+                    if (j != p.activeRequests.end())
+                    {
+                        *j->second = true;
+                    }
+                }
             }
         }
 
         ThumbnailSystem::ImageFuture ThumbnailSystem::getImage(
             const FileSystem::FileInfo& fileInfo,
             const Image::Size&          size,
-            Image::Type                 type)
+            Image::Type                 type,
+            size_t                      priority)
         {
             DJV_PRIVATE_PTR();
             ImageRequest request;
             request.fileInfo = fileInfo;
             request.size = size;
             request.type = type;
+            request.priority = priority;
             auto future = request.promise.get_future();
+            const UID uid = request.uid;
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
                 p.imageRequests.push_back(std::move(request));
             }
             p.requestCV.notify_one();
-            return ImageFuture(future, request.uid);
+            return ImageFuture(future, uid);
         }
         
         void ThumbnailSystem::cancelImage(UID uid)
@@ -404,9 +646,22 @@ namespace djv
                 {
                     p.imageRequests.erase(--(i.base()));
                 }
+                else
+                {
+                    const auto j = p.activeRequests.find(uid);
+                    if (j != p.activeRequests.end())
+                    {
+                        *j->second = true;
+                    }
+                }
             }
         }
 
+        size_t ThumbnailSystem::getThreadCount() const
+        {
+            return _p->threadCount;
+        }
+
         float ThumbnailSystem::getInfoCachePercentage() const
         {
             return _p->infoCachePercentage;
@@ -419,223 +674,220 @@ namespace djv
 
         void ThumbnailSystem::clearCache()
         {
-            _p->clearCache = true;
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.cacheMutex);
+            p.infoCache.clear();
+            p.infoCachePercentage = 0.F;
+            p.imageCache.clear();
+            p.imageCachePercentage = 0.F;
         }
 
-        void ThumbnailSystem::_handleInfoRequests()
+        void ThumbnailSystem::Private::log(const std::string& value, LogLevel level)
         {
-            DJV_PRIVATE_PTR();
+            logSystem->log("djv::AV::ThumbnailSystem", value, level);
+        }
+
+        bool ThumbnailSystem::Private::isCanceled(const std::shared_ptr<std::atomic<bool> >& value) const
+        {
+            return !running || *value;
+        }
 
-            // Process new requests.
-            while (p.pendingInfoRequests.size() < infoProcessMax)
+        std::shared_ptr<IO::IRead> ThumbnailSystem::Private::read(
+            const FileSystem::FileInfo& fileInfo,
+            const std::shared_ptr<std::atomic<bool> >& canceled,
+            IO::Info& info)
+        {
+            // Wait for the information while checking whether the request
+            // has been canceled. Destroying the reader stops decoding.
+            auto out = io->read(fileInfo);
+            auto future = out->getInfo();
+            const auto timeout = std::chrono::milliseconds(Time::getValue(Time::TimerValue::Fast));
+            while (future.wait_for(timeout) != std::future_status::ready)
             {
-                InfoRequest i;
+                if (isCanceled(canceled))
                 {
-                    std::unique_lock<std::mutex> lock(p.requestMutex);
-                    if (p.infoRequests.size())
-                    {
-                        i = std::move(p.infoRequests.front());
-                        p.infoRequests.pop_front();
-                    }
-                    else
-                    {
-                        break;
-                    }
+                    return nullptr;
                 }
-                const auto key = getInfoCacheKey(i.fileInfo);
-                IO::Info info;
-                const bool cached = p.infoCache.get(key, info);
-                if (cached)
-                {
-                    i.promise.set_value(info);
-                }
-                else
+            }
+            info = future.get();
+            return out;
+        }
+
+        void ThumbnailSystem::Private::handleInfoRequest(InfoRequest& request)
+        {
+            const auto key = getInfoCacheKey(request.fileInfo);
+            IO::Info info;
+            bool cached = false;
+            {
+                std::unique_lock<std::mutex> lock(cacheMutex);
+                cached = infoCache.get(key, info);
+            }
+            try
+            {
+                if (!cached)
                 {
-                    try
-                    {
-                        i.read = p.io->read(i.fileInfo);
-                        i.infoFuture = i.read->getInfo();
-                        p.pendingInfoRequests.push_back(std::move(i));
-                    }
-                    catch (const std::exception &)
+                    if (!read(request.fileInfo, request.canceled, info))
                     {
-                        try
-                        {
-                            i.promise.set_exception(std::current_exception());
-                        }
-                        catch (const std::exception & e)
-                        {
-                            _log(e.what(), LogLevel::Error);
-                        }
+                        return;
                     }
+                    std::unique_lock<std::mutex> lock(cacheMutex);
+                    infoCache.add(key, info);
+                    infoCachePercentage = infoCache.getPercentageUsed();
                 }
+                request.promise.set_value(info);
             }
-
-            // Process pending requests.
-            auto i = p.pendingInfoRequests.begin();
-            while (i != p.pendingInfoRequests.end())
+            catch (const std::exception&)
             {
-                if (i->infoFuture.valid() &&
-                    i->infoFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                try
                 {
-                    try
-                    {
-                        const auto info = i->infoFuture.get();
-                        p.infoCache.add(getInfoCacheKey(i->fileInfo), info);
-                        p.infoCachePercentage = p.infoCache.getPercentageUsed();
-                        i->promise.set_value(info);
-                    }
-                    catch (const std::exception &)
-                    {
-                        try
-                        {
-                            i->promise.set_exception(std::current_exception());
-                        }
-                        catch (const std::exception & e)
-                        {
-                            _log(e.what(), LogLevel::Error);
-                        }
-                    }
-                    i = p.pendingInfoRequests.erase(i);
+                    request.promise.set_exception(std::current_exception());
                 }
-                else
+                catch (const std::exception& e)
                 {
-                    ++i;
+                    log(e.what(), LogLevel::Error);
                 }
             }
         }
 
-        void ThumbnailSystem::_handleImageRequests(const std::shared_ptr<Image::Convert> & convert)
+        void ThumbnailSystem::Private::handleImageRequest(
+            ImageRequest& request,
+            const std::shared_ptr<Image::Convert>& convert)
         {
-            DJV_PRIVATE_PTR();
+            const auto key = getImageCacheKey(request.fileInfo, request.size, request.type);
+            std::shared_ptr<Image::Image> image;
+            {
+                std::unique_lock<std::mutex> lock(cacheMutex);
+                imageCache.get(key, image);
+            }
+            if (!image && diskCache && request.fileInfo.doesExist())
+            {
+                image = diskCache->get(request.fileInfo, request.size, request.type, optionsHash);
+                if (image)
+                {
+                    std::unique_lock<std::mutex> lock(cacheMutex);
+                    imageCache.add(key, image);
+                    imageCachePercentage = imageCache.getPercentageUsed();
+                }
+            }
+            if (image)
+            {
+                request.promise.set_value(image);
+                return;
+            }
 
-            // Process new requests.
-            while (p.pendingImageRequests.size() < imageProcessMax)
+            try
             {
-                ImageRequest i;
+                IO::Info info;
+                auto read = this->read(request.fileInfo, request.canceled, info);
+                if (!read)
                 {
-                    std::unique_lock<std::mutex> lock(p.requestMutex);
-                    if (p.imageRequests.size())
-                    {
-                        i = std::move(p.imageRequests.front());
-                        p.imageRequests.pop_front();
-                    }
-                    else
-                    {
-                        break;
-                    }
+                    return;
                 }
-                const auto key = getImageCacheKey(i.fileInfo, i.size, i.type);
-                std::shared_ptr<Image::Image> image;
-                p.imageCache.get(key, image);
-                if (image)
+                if (0 == info.video.size())
                 {
-                    i.promise.set_value(image);
+                    request.promise.set_value(nullptr);
+                    return;
                 }
-                else
+
+                // Wait for the first frame.
+                const auto timeout = std::chrono::milliseconds(Time::getValue(Time::TimerValue::Fast));
+                bool finished = false;
+                while (!image && !finished)
                 {
-                    try
                     {
-                        i.read = p.io->read(i.fileInfo);
-                        const auto info = i.read->getInfo().get();
-                        if (info.video.size() > 0)
-                        {
-                            p.pendingImageRequests.push_back(std::move(i));
-                        }
-                        else
+                        auto& queue = read->getVideoQueue();
+                        if (!queue.isEmpty())
                         {
-                            i.promise.set_value(nullptr);
+                            image = queue.getFrame().image;
                         }
+                        finished = queue.isFinished();
                     }
-                    catch (const std::exception&)
+                    if (!image && !finished)
                     {
-                        try
+                        if (isCanceled(request.canceled))
                         {
-                            i.promise.set_exception(std::current_exception());
-                        }
-                        catch (const std::exception &e)
-                        {
-                            _log(e.what(), LogLevel::Error);
+                            return;
                         }
+                        std::this_thread::sleep_for(timeout);
                     }
                 }
-            }
+                read.reset();
 
-            // Process pending requests.
-            auto i = p.pendingImageRequests.begin();
-            while (i != p.pendingImageRequests.end())
-            {
-                std::shared_ptr<Image::Image> image;
-                bool finished = false;
+                Image::Info convertInfo;
+                if (!image)
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
-                    auto& queue = i->read->getVideoQueue();
-                    if (!queue.isEmpty())
-                    {
-                        image = queue.getFrame().image;
-                    }
-                    if (queue.isFinished())
-                    {
-                        finished = true;
-                    }
+                    request.promise.set_value(nullptr);
                 }
-                if (image)
+                else if (!getConvertInfo(*image, request.size, request.type, convertInfo))
+                {
+                    finishImageRequest(request, image);
+                }
+                else if (convert)
+                {
+                    convertImage(request, image, convertInfo, convert);
+                }
+                else
                 {
-                    try
-                    {
-                        Image::Size imageSize = image->getSize();
-                        imageSize.w *= image->getInfo().pixelAspectRatio;
-                        if (i->size != imageSize || i->type != Image::Type::None)
-                        {
-                            Image::Size size = i->size;
-                            const float aspect = size.h != 0 ? (size.w / static_cast<float>(size.h)) : 1.F;
-                            const float imageAspect = imageSize.h != 0 ? (imageSize.w / static_cast<float>(imageSize.h)) : 1.F;
-                            if (imageAspect < aspect)
-                            {
-                                size.w = static_cast<uint16_t>(size.h * imageAspect);
-                            }
-                            else
-                            {
-                                size.h = static_cast<int>(size.w / imageAspect);
-                            }
-                            const auto type = i->type != Image::Type::None ? i->type : image->getType();
-                            const auto info = Image::Info(size, type);
-                            auto tmp = Image::Image::create(info);
-                            tmp->setPluginName(image->getPluginName());
-                            tmp->setTags(image->getTags());
-                            convert->process(*image, info, *tmp);
-                            image = tmp;
-                        }
-                        p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image);
-                        p.imageCachePercentage = p.imageCache.getPercentageUsed();
-                        i->promise.set_value(image);
-                    }
-                    catch (const std::exception&)
                     {
-                        try
-                        {
-                            i->promise.set_exception(std::current_exception());
-                        }
-                        catch (const std::exception& e)
-                        {
-                            _log(e.what(), LogLevel::Error);
-                        }
+                        std::unique_lock<std::mutex> lock(convertMutex);
+                        convertRequests.push_back({ std::move(request), image, convertInfo });
                     }
+                    convertCV.notify_one();
                 }
-                else if (finished)
+            }
+            catch (const std::exception&)
+            {
+                try
                 {
-                    i->promise.set_value(nullptr);
+                    request.promise.set_exception(std::current_exception());
                 }
-                if (image || finished)
+                catch (const std::exception& e)
                 {
-                    i = p.pendingImageRequests.erase(i);
+                    log(e.what(), LogLevel::Error);
                 }
-                else
+            }
+        }
+
+        void ThumbnailSystem::Private::convertImage(
+            ImageRequest& request,
+            std::shared_ptr<Image::Image> image,
+            const Image::Info& info,
+            const std::shared_ptr<Image::Convert>& convert)
+        {
+            try
+            {
+                auto tmp = Image::Image::create(info);
+                tmp->setPluginName(image->getPluginName());
+                tmp->setTags(image->getTags());
+                convert->process(*image, info, *tmp);
+                finishImageRequest(request, tmp);
+            }
+            catch (const std::exception&)
+            {
+                try
+                {
+                    request.promise.set_exception(std::current_exception());
+                }
+                catch (const std::exception& e)
                 {
-                    ++i;
+                    log(e.what(), LogLevel::Error);
                 }
             }
         }
 
+        void ThumbnailSystem::Private::finishImageRequest(ImageRequest& request, const std::shared_ptr<Image::Image>& image)
+        {
+            {
+                std::unique_lock<std::mutex> lock(cacheMutex);
+                imageCache.add(getImageCacheKey(request.fileInfo, request.size, request.type), image);
+                imageCachePercentage = imageCache.getPercentageUsed();
+            }
+            if (diskCache && request.fileInfo.doesExist())
+            {
+                diskCache->add(request.fileInfo, request.size, request.type, image, optionsHash);
+            }
+            request.promise.set_value(image);
+        }
+
     } // namespace AV
 } // namespace djv
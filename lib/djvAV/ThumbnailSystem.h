@@ -35,7 +35,6 @@ namespace djv
         {
             class Size;
             class Info;
-            class Convert;
             class Image;
             
         } // namespace Image
@@ -48,6 +47,11 @@ namespace djv
         };
         
         //! This class provides a system for generating thumbnail images from files.
+        //!
+        //! Requests are handled concurrently by a pool of worker threads. The
+        //! number of threads can be set with the DJV_THUMBNAIL_THREAD_COUNT
+        //! environment variable. When thumbnails are converted with OpenGL the
+        //! conversion is serialized on a single thread that owns the context.
         class ThumbnailSystem : public Core::ISystem
         {
             DJV_NON_COPYABLE(ThumbnailSystem);
@@ -73,10 +77,12 @@ namespace djv
                 Core::UID uid = 0;
             };
             
-            //! Get information about a file.
-            InfoFuture getInfo(const Core::FileSystem::FileInfo&);
+            //! Get information about a file. Requests with lower priority
+            //! values are handled first.
+            InfoFuture getInfo(const Core::FileSystem::FileInfo&, size_t priority = 0);
 
-            //! Cancel information about a file.
+            //! Cancel information about a file. If the request is already being
+            //! handled the file is closed.
             void cancelInfo(Core::UID);
 
             //! This structure provides a thumbnail image for a file.
@@ -88,15 +94,21 @@ namespace djv
                 Core::UID uid = 0;
             };
 
-            //! Get a thumbnail image for the given file.
+            //! Get a thumbnail image for the given file. Requests with lower
+            //! priority values are handled first.
             ImageFuture getImage(
                 const Core::FileSystem::FileInfo& path,
                 const Image::Size&                size,
-                Image::Type                       type = Image::Type::None);
+                Image::Type                       type     = Image::Type::None,
+                size_t                            priority = 0);
 
-            //! Cancel a thumbnail image.
+            //! Cancel a thumbnail image. If the request is already being handled
+            //! the file is closed.
             void cancelImage(Core::UID);
 
+            //! Get the number of threads used to handle requests.
+            size_t getThreadCount() const;
+
             //! Get the infromation cache percentage used.
             float getInfoCachePercentage() const;
 
@@ -107,9 +119,6 @@ namespace djv
             void clearCache();
 
         private:
-            void _handleInfoRequests();
-            void _handleImageRequests(const std::shared_ptr<Image::Convert> &);
-
             DJV_PRIVATE();
         };
 
@@ -43,7 +43,7 @@ namespace djv
             int exit = 0;
         };
 
-        void Application::_init(std::list<std::string>& args)
+        void Application::_init(std::list<std::string>& args, bool gl)
         {
             std::string argv0;
             if (args.size())
@@ -76,8 +76,15 @@ namespace djv
             }
 
             // Create the systems.
-            auto avSystem = AV::AVSystem::create(shared_from_this());
-            auto sceneSystem = Scene::SceneSystem::create(shared_from_this());
+            if (gl)
+            {
+                auto avSystem = AV::AVSystem::create(shared_from_this());
+                auto sceneSystem = Scene::SceneSystem::create(shared_from_this());
+            }
+            else
+            {
+                auto ioSystem = AV::IO::System::create(shared_from_this());
+            }
         }
 
         Application::Application() :
@@ -143,7 +150,7 @@ namespace djv
             auto arg = args.begin();
             while (arg != args.end())
             {
-                if ("-time_units" == *arg)
+                if ("-time_units" == *arg && getSystemT<AV::AVSystem>())
                 {
                     arg = args.erase(arg);
                     if (args.end() == arg)
@@ -179,8 +186,9 @@ namespace djv
             auto textSystem = getSystemT<Core::TextSystem>();
             std::cout << " " << textSystem->getText(DJV_TEXT("cli_general_options")) << std::endl;
             std::cout << std::endl;
-            std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_time_units")) << std::endl;
+            if (auto avSystem = getSystemT<AV::AVSystem>())
             {
+                std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_time_units")) << std::endl;
                 std::vector<std::string> options;
                 std::string value;
                 for (auto i : Time::getUnitsEnums())
@@ -191,7 +199,6 @@ namespace djv
                 }
                 {
                     std::stringstream ss;
-                    auto avSystem = getSystemT<AV::AVSystem>();
                     ss << avSystem->observeTimeUnits()->get();
                     value = "\"" + textSystem->getText(ss.str()) + "\"";
                 }
@@ -199,8 +206,8 @@ namespace djv
                     arg(String::join(options, ", ")).
                     arg(value);
                 std::cout << "   " << s << std::endl;
+                std::cout << std::endl;
             }
-            std::cout << std::endl;
             std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_log_console")) << std::endl;
             std::cout << "   " << textSystem->getText(DJV_TEXT("cli_option_log_console_description")) << std::endl;
             std::cout << std::endl;
@@ -26,7 +26,9 @@ namespace djv
             DJV_NON_COPYABLE(Application);
 
         protected:
-            void _init(std::list<std::string>&);
+            //! Set gl to false to only create the systems that do not require
+            //! a display (i.e., no OpenGL, rendering, or audio).
+            void _init(std::list<std::string>&, bool gl = true);
             Application();
 
         public:
@@ -6,7 +6,9 @@
 
 #include <djvCore/Core.h>
 
-#include <map>
+#include <functional>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace djv
@@ -15,10 +17,20 @@ namespace djv
     {
         namespace Memory
         {
-            //! This class provides a cache.
+            //! This class provides a least recently used cache.
+            //!
+            //! The entries are stored in a hash table and a recency list so
+            //! that get(), add(), and evicting the least recently used entry
+            //! are constant time operations. The key type requires a hash
+            //! function, by default std::hash.
+            //!
+            //! Each entry has a cost which by default is one, in which case
+            //! the maximum is the number of entries. Passing a cost to add()
+            //! allows the maximum to be used as a budget, for example a number
+            //! of bytes.
             //!
             //! \todo Return an iterator from get() instead of a value.
-            template<typename T, typename U>
+            template<typename T, typename U, typename H = std::hash<T> >
             class Cache
             {
             public:
@@ -26,24 +38,36 @@ namespace djv
                 void setMax(size_t);
 
                 size_t getSize() const;
+                size_t getCost() const;
                 bool contains(const T & key) const;
                 bool get(const T & key, U &) const;
-                void add(const T & key, const U & value);
+                void add(const T & key, const U & value, size_t cost = 1);
                 void remove(const T& key);
                 void clear();
 
                 float getPercentageUsed() const;
 
+                //! Get the keys, ordered from the least to the most recently used.
                 std::vector<T> getKeys() const;
+
+                //! Get the values, ordered from the least to the most recently used.
                 std::vector<U> getValues() const;
 
             private:
                 void _updateMax();
 
+                struct Entry
+                {
+                    T      key;
+                    U      value;
+                    size_t cost;
+                };
+                typedef std::list<Entry> List;
+
                 size_t _max = 10000;
-                std::map<T, U> _map;
-                mutable std::map<T, int64_t> _counts;
-                mutable int64_t _counter = 0;
+                size_t _cost = 0;
+                mutable List _list;
+                std::unordered_map<T, typename List::iterator, H> _map;
             };
 
         } // namespace Memory
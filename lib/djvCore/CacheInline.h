@@ -2,145 +2,138 @@
 // Copyright (c) 2004-2020 Darby Johnston
 // All rights reserved.
 
-#include <algorithm>
-
 namespace djv
 {
     namespace Core
     {
         namespace Memory
         {
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getMax() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getMax() const
             {
                 return _max;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::setMax(size_t value)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::setMax(size_t value)
             {
                 _max = value;
                 _updateMax();
             }
 
-            template<typename T, typename U>
-            inline size_t Cache<T, U>::getSize() const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getSize() const
             {
                 return _map.size();
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::contains(const T & key) const
+            template<typename T, typename U, typename H>
+            inline size_t Cache<T, U, H>::getCost() const
+            {
+                return _cost;
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::contains(const T & key) const
             {
                 return _map.find(key) != _map.end();
             }
 
-            template<typename T, typename U>
-            inline bool Cache<T, U>::get(const T & key, U & value) const
+            template<typename T, typename U, typename H>
+            inline bool Cache<T, U, H>::get(const T & key, U & value) const
             {
-                auto i = _map.find(key);
+                const auto i = _map.find(key);
                 if (i != _map.end())
                 {
-                    value = i->second;
-                    auto j = _counts.find(key);
-                    if (j != _counts.end())
-                    {
-                        ++_counter;
-                        j->second = _counter;
-                    }
+                    value = i->second->value;
+                    _list.splice(_list.end(), _list, i->second);
                     return true;
                 }
-                return i != _map.end();
+                return false;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::add(const T & key, const U & value)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::add(const T & key, const U & value, size_t cost)
             {
-                _map[key] = value;
-                ++_counter;
-                _counts[key] = _counter;
+                const auto i = _map.find(key);
+                if (i != _map.end())
+                {
+                    _cost -= i->second->cost;
+                    i->second->value = value;
+                    i->second->cost = cost;
+                    _list.splice(_list.end(), _list, i->second);
+                }
+                else
+                {
+                    _list.push_back({ key, value, cost });
+                    _map[key] = std::prev(_list.end());
+                }
+                _cost += cost;
                 _updateMax();
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::remove(const T& key)
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::remove(const T& key)
             {
                 const auto i = _map.find(key);
                 if (i != _map.end())
                 {
+                    _cost -= i->second->cost;
+                    _list.erase(i->second);
                     _map.erase(i);
                 }
-                const auto j = _counts.find(key);
-                if (j != _counts.end())
-                {
-                    _counts.erase(j);
-                }
-                _updateMax();
             }
             
-            template<typename T, typename U>
-            inline void Cache<T, U>::clear()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::clear()
             {
                 _map.clear();
+                _list.clear();
+                _cost = 0;
             }
 
-            template<typename T, typename U>
-            inline float Cache<T, U>::getPercentageUsed() const
+            template<typename T, typename U, typename H>
+            inline float Cache<T, U, H>::getPercentageUsed() const
             {
-                return _map.size() / static_cast<float>(_max) * 100.F;
+                return _max ? (_cost / static_cast<float>(_max) * 100.F) : 0.F;
             }
 
-            template<typename T, typename U>
-            inline std::vector<T> Cache<T, U>::getKeys() const
+            template<typename T, typename U, typename H>
+            inline std::vector<T> Cache<T, U, H>::getKeys() const
             {
                 std::vector<T> out;
-                for (const auto & i : _map)
+                out.reserve(_list.size());
+                for (const auto & i : _list)
                 {
-                    out.push_back(i.first);
+                    out.push_back(i.key);
                 }
                 return out;
             }
 
-            template<typename T, typename U>
-            inline std::vector<U> Cache<T, U>::getValues() const
+            template<typename T, typename U, typename H>
+            inline std::vector<U> Cache<T, U, H>::getValues() const
             {
                 std::vector<U> out;
-                for (const auto & i : _map)
+                out.reserve(_list.size());
+                for (const auto & i : _list)
                 {
-                    out.push_back(i.second);
+                    out.push_back(i.value);
                 }
                 return out;
             }
 
-            template<typename T, typename U>
-            inline void Cache<T, U>::_updateMax()
+            template<typename T, typename U, typename H>
+            inline void Cache<T, U, H>::_updateMax()
             {
-                if (_map.size() > _max)
+                while (_cost > _max && !_list.empty())
                 {
-                    std::map<int64_t, T> sorted;
-                    for (const auto& i : _counts)
-                    {
-                        sorted[i.second] = i.first;
-                    }
-                    while (_map.size() > _max)
-                    {
-                        auto begin = sorted.begin();
-                        auto i = _map.find(begin->second);
-                        if (i != _map.end())
-                        {
-                            _map.erase(i);
-                        }
-                        auto j = _counts.find(begin->second);
-                        if (j != _counts.end())
-                        {
-                            _counts.erase(j);
-                        }
-                        sorted.erase(begin);
-                    }
+                    const auto& entry = _list.front();
+                    _cost -= entry.cost;
+                    _map.erase(entry.key);
+                    _list.pop_front();
                 }
             }
 
         } // namespace Memory
     } // namespace Core
 } // namespace djv
-
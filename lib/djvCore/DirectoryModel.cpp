@@ -342,6 +342,7 @@ namespace djv
                 options.reverseSort = p.reverseSort->get();
                 options.sortDirectoriesFirst = p.sortDirectoriesFirst->get();
                 options.filter = p.filter->get();
+                options.stat = true;
                 p.future = std::async(
                     std::launch::async,
                     [path, options]
@@ -137,6 +137,14 @@ namespace djv
 
                 //! Get a pointer to the end of the memory-map.
                 const uint8_t * mmapEnd() const;
+
+                //! Advise the operating system that the memory-map will be
+                //! needed soon so that it can start reading the pages.
+                void mmapWillNeed();
+
+                //! Advise the operating system that the memory-map is no longer
+                //! needed so that the pages can be released.
+                void mmapDontNeed();
 #endif // DJV_MMAP
 
                 ///@}
@@ -13,14 +13,20 @@ namespace djv
 
             inline bool FileIO::isOpen() const
             {
+                // Note that memory mapped files are closed after they are
+                // mapped.
 #if defined(DJV_PLATFORM_WINDOWS)
 #if defined(DJV_MMAP)
-                return _f != INVALID_HANDLE_VALUE;
+                return _f != INVALID_HANDLE_VALUE || _mmapStart != nullptr;
 #else // DJV_MMAP
                 return _f != nullptr;
 #endif // DJV_MMAP
 #else // DJV_PLATFORM_WINDOWS
+#if defined(DJV_MMAP)
+                return _f != -1 || _mmapStart != nullptr;
+#else // DJV_MMAP
                 return _f != -1;
+#endif // DJV_MMAP
 #endif //DJV_PLATFORM_WINDOWS
             }
 
@@ -43,7 +49,7 @@ namespace djv
             {
 #if defined(DJV_PLATFORM_WINDOWS)
                 return
-                    _f == INVALID_HANDLE_VALUE ||
+                    !isOpen() ||
                     (_size ? _pos >= _size : true);
 #else // DJV_PLATFORM_WINDOWS
                 return
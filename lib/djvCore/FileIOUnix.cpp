@@ -164,14 +164,20 @@ namespace djv
                 if (Mode::Read == _mode && _size > 0)
                 {
                     _mmap = mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
-                    madvise(_mmap, _size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
                     if (_mmap == (void *) - 1)
                     {
                         throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
                     }
+                    madvise(_mmap, _size, MADV_SEQUENTIAL);
                     _mmapStart = reinterpret_cast<const uint8_t *>(_mmap);
                     _mmapEnd   = _mmapStart + _size;
                     _mmapP     = _mmapStart;
+
+                    // The mapping stays valid after the file is closed. Closing it
+                    // keeps long lived mappings, like images in the frame cache,
+                    // from using up the file descriptors.
+                    ::close(_f);
+                    _f = -1;
                 }
 #endif // DJV_MMAP
             }
@@ -248,6 +254,24 @@ namespace djv
                 return out;
             }
             
+#if defined(DJV_MMAP)
+            void FileIO::mmapWillNeed()
+            {
+                if (_mmap != (void *) - 1)
+                {
+                    madvise(_mmap, _size, MADV_WILLNEED);
+                }
+            }
+
+            void FileIO::mmapDontNeed()
+            {
+                if (_mmap != (void *) - 1)
+                {
+                    madvise(_mmap, _size, MADV_DONTNEED);
+                }
+            }
+#endif // DJV_MMAP
+
             void FileIO::read(void* in, size_t size, size_t wordSize)
             {
                 switch (_mode)
@@ -162,6 +162,14 @@ namespace djv
 
                     _mmapEnd = _mmapStart + _size;
                     _mmapP = _mmapStart;
+
+                    // The view stays valid after the handles are closed. Closing
+                    // them keeps long lived views, like images in the frame cache,
+                    // from using up handles.
+                    CloseHandle(_mmap);
+                    _mmap = 0;
+                    CloseHandle(_f);
+                    _f = INVALID_HANDLE_VALUE;
                 }
 #else // DJV_MMAP
                 std::string modeStr;
@@ -284,6 +292,31 @@ namespace djv
                 return out;
             }
 
+#if defined(DJV_MMAP)
+            void FileIO::mmapWillNeed()
+            {
+#if _WIN32_WINNT >= _WIN32_WINNT_WIN8
+                if (_mmapStart)
+                {
+                    WIN32_MEMORY_RANGE_ENTRY entry;
+                    entry.VirtualAddress = (PVOID)_mmapStart;
+                    entry.NumberOfBytes  = _size;
+                    PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0);
+                }
+#endif // _WIN32_WINNT_WIN8
+            }
+
+            void FileIO::mmapDontNeed()
+            {
+                if (_mmapStart)
+                {
+                    // Unlocking pages that are not locked removes them from the
+                    // working set.
+                    VirtualUnlock((LPVOID)_mmapStart, _size);
+                }
+            }
+#endif // DJV_MMAP
+
             void FileIO::read(void * in, size_t size, size_t wordSize)
             {
                 switch (_mode)
@@ -4,6 +4,10 @@
 
 #include <djvCore/FileInfo.h>
 
+#include <regex>
+#include <unordered_map>
+#include <unordered_set>
+
 //#pragma optimize("", off)
 
 namespace djv
@@ -12,6 +16,138 @@ namespace djv
     {
         namespace FileSystem
         {
+            namespace
+            {
+                //! Convert a frame number without the overhead of a string
+                //! stream. Returns false if the number is not a plain frame
+                //! number, which includes numbers that are too large for
+                //! Frame::fromString().
+                bool parseFrame(const std::string& value, Frame::Number& frame, size_t& pad)
+                {
+                    const size_t size = value.size();
+                    if (0 == size || size > 9)
+                    {
+                        return false;
+                    }
+                    frame = 0;
+                    for (const auto c : value)
+                    {
+                        if (c < '0' || c > '9')
+                        {
+                            return false;
+                        }
+                        frame = frame * 10 + (c - '0');
+                    }
+                    pad = size >= 2 && '0' == value[0] ? size : 0;
+                    return true;
+                }
+
+                //! Convert a glob pattern to a regular expression.
+                std::string globToRegex(const std::string& value)
+                {
+                    std::string out = "^";
+                    for (const auto c : value)
+                    {
+                        switch (c)
+                        {
+                        case '*': out += ".*"; break;
+                        case '?': out += '.'; break;
+                        case '.': case '+': case '(': case ')': case '[': case ']':
+                        case '{': case '}': case '^': case '$': case '|': case '\\':
+                            out += '\\';
+                            out += c;
+                            break;
+                        default: out += c; break;
+                        }
+                    }
+                    out += '$';
+                    return out;
+                }
+
+            } // namespace
+
+            struct DirectoryListMatcher::Private
+            {
+                std::unordered_set<std::string> extensions;
+                bool filterEnabled = false;
+                bool filterValid = false;
+                std::regex filter;
+            };
+
+            DirectoryListMatcher::DirectoryListMatcher(const DirectoryListOptions& options) :
+                _p(new Private)
+            {
+                DJV_PRIVATE_PTR();
+                for (const auto& i : options.fileExtensions)
+                {
+                    p.extensions.insert(String::toLower(i));
+                }
+                if (!options.filter.empty())
+                {
+                    p.filterEnabled = true;
+                    const auto flags = std::regex_constants::icase | std::regex_constants::optimize;
+                    try
+                    {
+                        p.filter = std::regex(options.filter, flags);
+                        p.filterValid = true;
+                    }
+                    catch (const std::exception&)
+                    {
+                        try
+                        {
+                            p.filter = std::regex(globToRegex(options.filter), flags);
+                            p.filterValid = true;
+                        }
+                        catch (const std::exception&)
+                        {}
+                    }
+                }
+            }
+
+            DirectoryListMatcher::~DirectoryListMatcher()
+            {}
+
+            bool DirectoryListMatcher::matchExtension(const std::string& value) const
+            {
+                DJV_PRIVATE_PTR();
+                if (p.extensions.empty())
+                {
+                    return true;
+                }
+                // Check each suffix that starts with a period so that extensions
+                // like ".tar.gz" also match.
+                const std::string lower = String::toLower(value);
+                size_t i = lower.rfind('.');
+                while (i != std::string::npos)
+                {
+                    if (p.extensions.find(lower.substr(i)) != p.extensions.end())
+                    {
+                        return true;
+                    }
+                    if (0 == i)
+                    {
+                        break;
+                    }
+                    i = lower.rfind('.', i - 1);
+                }
+                return false;
+            }
+
+            bool DirectoryListMatcher::matchFilter(const std::string& value) const
+            {
+                DJV_PRIVATE_PTR();
+                if (!p.filterEnabled)
+                {
+                    return true;
+                }
+                return p.filterValid && std::regex_search(value, p.filter);
+            }
+
+            bool DirectoryListMatcher::match(const std::string& value) const
+            {
+                return matchFilter(value) && matchExtension(value);
+            }
+
             std::string getFilePermissionsLabel(int in)
             {
                 const std::vector<std::string> data =
@@ -170,42 +306,91 @@ namespace djv
                 return out;
             }
 
-            void FileInfo::_fileSequence(FileInfo& fileInfo, const DirectoryListOptions& options, std::vector<FileInfo>& out)
+            std::vector<FileInfo> FileInfo::groupFileSequences(std::vector<FileInfo> value, const DirectoryListOptions& options)
             {
-                std::string extension = fileInfo.getPath().getExtension();
-                std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
-                const auto i = std::find(
-                    options.fileSequenceExtensions.begin(),
-                    options.fileSequenceExtensions.end(),
-                    extension);
-                if (options.fileSequences && i != options.fileSequenceExtensions.end())
+                if (!options.fileSequences)
                 {
-                    fileInfo.evalSequence();
-                    if (fileInfo.isSequenceValid())
+                    return value;
+                }
+                std::vector<FileInfo> out;
+                out.reserve(value.size());
+                struct Group
+                {
+                    size_t          index = 0;
+                    Frame::Sequence sequence;
+                };
+                std::vector<Group> groups;
+                std::unordered_map<std::string, size_t> groupIndex;
+                std::string extension;
+                std::string key;
+                for (auto& fileInfo : value)
+                {
+                    const Path& path = fileInfo._path;
+                    extension = path.getExtension();
+                    std::transform(extension.begin(), extension.end(), extension.begin(), tolower);
+                    if (FileType::File == fileInfo._type &&
+                        options.fileSequenceExtensions.find(extension) != options.fileSequenceExtensions.end())
                     {
-                        const size_t size = out.size();
-                        size_t j = 0;
-                        for (; j < size; ++j)
+                        Frame::Sequence sequence;
+                        Frame::Number frame = 0;
+                        size_t pad = 0;
+                        if (parseFrame(path.getNumber(), frame, pad))
+                        {
+                            sequence.ranges.push_back(Frame::Range(frame));
+                            sequence.pad = pad;
+                        }
+                        else
                         {
-                            if (out[j].addToSequence(fileInfo))
+                            fileInfo.evalSequence();
+                            if (fileInfo.isSequenceValid())
                             {
-                                break;
+                                sequence = fileInfo._sequence;
                             }
                         }
-                        if (size == j)
+                        if (sequence.ranges.size())
                         {
-                            out.push_back(fileInfo);
+                            key = path.getDirectoryName();
+                            key.push_back('\0');
+                            key.append(path.getBaseName());
+                            key.push_back('\0');
+                            key.append(path.getExtension());
+                            const auto i = groupIndex.find(key);
+                            if (i == groupIndex.end())
+                            {
+                                groupIndex[key] = groups.size();
+                                Group group;
+                                group.index = out.size();
+                                group.sequence = std::move(sequence);
+                                groups.push_back(std::move(group));
+                                fileInfo._type = FileType::Sequence;
+                                out.push_back(std::move(fileInfo));
+                            }
+                            else
+                            {
+                                auto& group = groups[i->second];
+                                for (const auto& range : sequence.ranges)
+                                {
+                                    group.sequence.ranges.push_back(range);
+                                }
+                                group.sequence.pad = std::max(group.sequence.pad, sequence.pad);
+                                auto& groupFileInfo = out[group.index];
+                                groupFileInfo._size += fileInfo._size;
+                                groupFileInfo._user = std::max(groupFileInfo._user, fileInfo._user);
+                                groupFileInfo._time = std::max(groupFileInfo._time, fileInfo._time);
+                            }
+                            continue;
                         }
                     }
-                    else
-                    {
-                        out.push_back(fileInfo);
-                    }
+                    out.push_back(std::move(fileInfo));
                 }
-                else
+
+                // Merge the frame numbers into ranges.
+                for (auto& group : groups)
                 {
-                    out.push_back(fileInfo);
+                    group.sequence.sort();
+                    out[group.index].setSequence(group.sequence);
                 }
+                return out;
             }
 
             void FileInfo::_sort(const DirectoryListOptions& options, std::vector<FileInfo>& out)
@@ -57,6 +57,10 @@ namespace djv
             DJV_ENUM_HELPERS(DirectoryListSort);
 
             //! This struct provides directory listing options.
+            //!
+            //! Files are only passed to stat() when the stat option is set or
+            //! the items are sorted by size or time. Otherwise only the path and
+            //! type of the files are available.
             struct DirectoryListOptions
             {
                 std::set<std::string>       fileExtensions;
@@ -67,6 +71,38 @@ namespace djv
                 bool                        reverseSort             = false;
                 bool                        sortDirectoriesFirst    = true;
                 std::string                 filter;
+                bool                        stat                    = false;
+            };
+
+            //! This class provides file name matching for directory listings.
+            //!
+            //! The file extensions are case folded and stored in a hash set, and
+            //! the filter is compiled once, so matching a file name does not
+            //! construct a regular expression. The filter is a case insensitive
+            //! regular expression, if it is not a valid regular expression it is
+            //! treated as a glob pattern (e.g., "*.exr").
+            class DirectoryListMatcher
+            {
+                DJV_NON_COPYABLE(DirectoryListMatcher);
+
+            public:
+                explicit DirectoryListMatcher(const DirectoryListOptions& = DirectoryListOptions());
+                ~DirectoryListMatcher();
+
+                //! Get whether the file name has one of the file extensions. This
+                //! returns true if there are no file extensions.
+                bool matchExtension(const std::string&) const;
+
+                //! Get whether the file name matches the filter. This returns true
+                //! if there is no filter.
+                bool matchFilter(const std::string&) const;
+
+                //! Get whether the file name passes both the extension and filter
+                //! tests.
+                bool match(const std::string&) const;
+
+            private:
+                DJV_PRIVATE();
             };
 
             //! This class provides information about files and file sequences.
@@ -151,6 +187,12 @@ namespace djv
                 //! Get the file sequence for the given file.
                 static FileInfo getFileSequence(const Path&, const std::set<std::string>& extensions);
 
+                //! Group files that share a name and extension into file
+                //! sequences. The files are grouped with a hash table in a single
+                //! pass, and the frame numbers of each sequence are merged into
+                //! ranges when all of the files have been added.
+                static std::vector<FileInfo> groupFileSequences(std::vector<FileInfo>, const DirectoryListOptions&);
+
                 ///@}
 
                 bool operator == (const FileInfo &) const;
@@ -160,7 +202,6 @@ namespace djv
                 explicit operator std::string() const;
 
             private:
-                static void _fileSequence(FileInfo&, const DirectoryListOptions&, std::vector<FileInfo>&);
                 static void _sort(const DirectoryListOptions&, std::vector<FileInfo>&);
                 
                 Path            _path;
@@ -91,6 +91,8 @@ namespace djv
             std::vector<FileInfo> FileInfo::directoryList(const Path& value, const DirectoryListOptions& options)
             {
                 std::vector<FileInfo> out;
+                const bool stat = options.stat || options.sort != DirectoryListSort::Name;
+                const DirectoryListMatcher matcher(options);
                 
                 // List the directory contents.
                 if (auto dir = opendir(value.get().c_str()))
@@ -98,9 +100,7 @@ namespace djv
                     dirent* de = nullptr;
                     while ((de = readdir(dir)))
                     {
-                        FileInfo fileInfo(Path(value, de->d_name));
-                        
-                        const std::string fileName = fileInfo.getFileName(-1, false);
+                        const std::string fileName(de->d_name);
                         
                         bool filter = false;
                         if (fileName.size() > 0 && '.' == fileName[0])
@@ -115,34 +115,40 @@ namespace djv
                         {
                             filter = true;
                         }
-                        if (options.filter.size() && !String::match(fileName, options.filter))
+                        if (!filter && !matcher.matchFilter(fileName))
                         {
                             filter = true;
                         }
-                        if (!filter && !(de->d_type & DT_DIR) && options.fileExtensions.size())
+                        if (!filter && !(de->d_type & DT_DIR) && !matcher.matchExtension(fileName))
                         {
-                            bool match = false;
-                            for (const auto& i : options.fileExtensions)
-                            {
-                                if (String::match(fileName, '\\' + i + '$'))
-                                {
-                                    match = true;
-                                    break;
-                                }
-                            }
-                            if (!match)
-                            {
-                                filter = true;
-                            }
+                            filter = true;
                         }
 
                         if (!filter)
                         {
-                            _fileSequence(fileInfo, options, out);
+                            // Only call stat() if it was requested or the file
+                            // type is not known.
+                            FileInfo fileInfo(Path(value, fileName), false);
+                            if (stat || DT_UNKNOWN == de->d_type || DT_LNK == de->d_type)
+                            {
+                                fileInfo.stat();
+                            }
+                            else
+                            {
+                                fileInfo._exists = true;
+                                if (DT_DIR == de->d_type)
+                                {
+                                    fileInfo._type = FileType::Directory;
+                                }
+                            }
+                            out.push_back(std::move(fileInfo));
                         }
                     }
                     closedir(dir);
                 }
+
+                // Group the file sequences.
+                out = groupFileSequences(std::move(out), options);
                     
                 // Sort the items.
                 _sort(options, out);
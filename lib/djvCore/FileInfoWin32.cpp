@@ -200,6 +200,9 @@ namespace djv
                 std::vector<FileInfo> out;
                 if (!value.isEmpty())
                 {
+                    const bool stat = options.stat || options.sort != DirectoryListSort::Name;
+                    const DirectoryListMatcher matcher(options);
+
                     // Prepare the path.
                     const std::wstring path = String::toWide(value.get() + Path::getSeparator(PathSeparator::Windows) + '*');
                     WCHAR pathBuf[MAX_PATH];
@@ -232,31 +235,28 @@ namespace djv
                                 {
                                     filter = true;
                                 }
-                                if (options.filter.size() && !String::match(fileName, options.filter))
+                                if (!filter && !matcher.matchFilter(fileName))
                                 {
                                     filter = true;
                                 }
-                                if (!filter && !(ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && options.fileExtensions.size())
+                                if (!filter && !(ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && !matcher.matchExtension(fileName))
                                 {
-                                    bool match = false;
-                                    for (const auto& i : options.fileExtensions)
-                                    {
-                                        if (String::match(fileName, '\\' + i + '$'))
-                                        {
-                                            match = true;
-                                            break;
-                                        }
-                                    }
-                                    if (!match)
-                                    {
-                                        filter = true;
-                                    }
+                                    filter = true;
                                 }
 
                                 if (!filter)
                                 {
-                                    FileInfo fileInfo(Path(value, fileName));
-                                    _fileSequence(fileInfo, options, out);
+                                    // Only call stat() if it was requested.
+                                    FileInfo fileInfo(Path(value, fileName), stat);
+                                    if (!stat)
+                                    {
+                                        fileInfo._exists = true;
+                                        if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                                        {
+                                            fileInfo._type = FileType::Directory;
+                                        }
+                                    }
+                                    out.push_back(std::move(fileInfo));
                                 }
                             } while (FindNextFileW(hFind, &ffd) != 0);
                         }
@@ -265,6 +265,9 @@ namespace djv
                             //! \bug How should we handle this error?
                         }
                         FindClose(hFind);
+
+                        // Group the file sequences.
+                        out = groupFileSequences(std::move(out), options);
                     }
                     else if ("\\\\" == value.getDirectoryName())
                     {
@@ -24,34 +24,28 @@ namespace djv
 
                 std::sort(ranges.begin(), ranges.end());
 
+                // The ranges are sorted so each range can only be merged with
+                // the last range.
                 if (ranges.size())
                 {
                     std::vector<Range> tmp;
+                    tmp.reserve(ranges.size());
                     tmp.push_back(ranges[0]);
                     for (size_t i = 1; i < ranges.size(); ++i)
                     {
-                        const size_t tmpSize = tmp.size();
-                        size_t j = 0;
-                        for (; j < tmpSize; ++j)
+                        auto& last = tmp.back();
+                        if (ranges[i].min <= last.max + 1)
                         {
-                            if (ranges[i].min == tmp[j].max + 1)
-                            {
-                                tmp[j].max = ranges[i].max;
-                                break;
-                            }
-                            else if (ranges[i].intersects(tmp[j]))
-                            {
-                                tmp[j].expand(ranges[i]);
-                                break;
-                            }
+                            last.max = std::max(last.max, ranges[i].max);
                         }
-                        if (tmpSize == j)
+                        else
                         {
                             tmp.push_back(ranges[i]);
                         }
                     }
-                    ranges = tmp;
+                    ranges = std::move(tmp);
                 }
+                _resetIndexCache();
             }
             
             bool Sequence::merge(const Range& value)
@@ -79,9 +73,52 @@ namespace djv
                         break;
                     }
                 }
+                if (out)
+                {
+                    _resetIndexCache();
+                }
                 return out;
             }
 
+            std::shared_ptr<const Sequence::IndexCache> Sequence::_getIndexCache() const
+            {
+                auto out = std::atomic_load(&_indexCache);
+                const size_t rangeCount = ranges.size();
+                if (!out ||
+                    out->rangeCount != rangeCount ||
+                    (rangeCount > 0 && (out->first != ranges.front() || out->last != ranges.back())))
+                {
+                    auto cache = std::make_shared<IndexCache>();
+                    cache->rangeCount = rangeCount;
+                    if (rangeCount > 0)
+                    {
+                        cache->first = ranges.front();
+                        cache->last = ranges.back();
+                    }
+                    cache->offsets.reserve(rangeCount);
+                    Index offset = 0;
+                    for (size_t i = 0; i < rangeCount; ++i)
+                    {
+                        const auto& range = ranges[i];
+                        if (range.min > range.max || (i > 0 && range.min <= ranges[i - 1].max))
+                        {
+                            cache->sorted = false;
+                        }
+                        cache->offsets.push_back(offset);
+                        offset += range.max - range.min + 1;
+                        cache->size += range.min < range.max ? (range.max - range.min + 1) : (range.min - range.max + 1);
+                    }
+                    out = cache;
+                    std::atomic_store(&_indexCache, out);
+                }
+                return out;
+            }
+
+            void Sequence::_resetIndexCache()
+            {
+                std::atomic_store(&_indexCache, std::shared_ptr<const IndexCache>());
+            }
+
             void sort(Range & out)
             {
                 const auto _min = std::min(out.min, out.max);
@@ -6,6 +6,9 @@
 
 #include <djvCore/Range.h>
 
+#include <memory>
+#include <vector>
+
 namespace djv
 {
     namespace Core
@@ -33,6 +36,13 @@ namespace djv
             
             //! This class provides a sequence of frame numbers. A sequence is
             //! composed of multiple frame number ranges (e.g., 1-10,20-30).
+            //!
+            //! The sequence keeps an index of where each range starts, so that
+            //! getFrame(), getIndex(), and contains() are binary searches when the
+            //! ranges are sorted. The index is rebuilt when it is next used after
+            //! sort() or merge(), or after the number of ranges or the first or
+            //! last range changes. Code that modifies other ranges in place should
+            //! call sort() afterwards.
             class Sequence
             {
             public:
@@ -41,6 +51,8 @@ namespace djv
                 Sequence(Number, Number, size_t pad = 0);
                 explicit Sequence(const Range& range, size_t pad = 0);
                 explicit Sequence(const std::vector<Range>& ranges, size_t pad = 0);
+                Sequence(const Sequence&);
+                Sequence(Sequence&&);
 
                 std::vector<Range> ranges;
                 size_t pad = 0;
@@ -62,8 +74,27 @@ namespace djv
                 
                 ///@}
 
+                Sequence& operator = (const Sequence&);
+                Sequence& operator = (Sequence&&);
+
                 bool operator == (const Sequence&) const;
                 bool operator != (const Sequence&) const;
+
+            private:
+                struct IndexCache
+                {
+                    size_t              rangeCount = 0;
+                    Range               first;
+                    Range               last;
+                    bool                sorted     = true;
+                    size_t              size       = 0;
+                    std::vector<Index>  offsets;
+                };
+
+                std::shared_ptr<const IndexCache> _getIndexCache() const;
+                void _resetIndexCache();
+
+                mutable std::shared_ptr<const IndexCache> _indexCache;
             };
 
             //! \name Utilities
@@ -4,6 +4,8 @@
 
 #include <djvCore/Math.h>
 
+#include <algorithm>
+
 namespace djv
 {
     namespace Core
@@ -45,6 +47,18 @@ namespace djv
                 pad(pad)
             {}
 
+            inline Sequence::Sequence(const Sequence& other) :
+                ranges(other.ranges),
+                pad(other.pad),
+                _indexCache(std::atomic_load(&other._indexCache))
+            {}
+
+            inline Sequence::Sequence(Sequence&& other) :
+                ranges(std::move(other.ranges)),
+                pad(other.pad),
+                _indexCache(std::atomic_load(&other._indexCache))
+            {}
+
             inline bool Sequence::isValid() const
             {
                 return ranges.size() > 0;
@@ -53,12 +67,29 @@ namespace djv
             inline bool Sequence::contains(Index value) const
             {
                 bool out = false;
-                for (const auto& i : ranges)
+                const auto cache = _getIndexCache();
+                if (cache->sorted)
                 {
-                    if (i.contains(value))
+                    // Find the last range that starts at or before the value.
+                    const auto i = std::upper_bound(
+                        ranges.begin(),
+                        ranges.end(),
+                        value,
+                        [](Index value, const Range& range)
+                        {
+                            return value < range.min;
+                        });
+                    out = i != ranges.begin() && (i - 1)->contains(value);
+                }
+                else
+                {
+                    for (const auto& i : ranges)
                     {
-                        out = true;
-                        break;
+                        if (i.contains(value))
+                        {
+                            out = true;
+                            break;
+                        }
                     }
                 }
                 return out;
@@ -66,33 +97,33 @@ namespace djv
 
             inline size_t Sequence::getSize() const
             {
-                size_t out = 0;
-                for (const auto& i : ranges)
-                {
-                    if (i.min < i.max)
-                    {
-                        out += i.max - i.min + 1;
-                    }
-                    else
-                    {
-                        out += i.min - i.max + 1;
-                    }
-                }
-                return out;
+                return _getIndexCache()->size;
             }
 
             inline Number Sequence::getFrame(Index value) const
             {
                 Number out = invalid;
-                for (const auto& j : ranges)
+                const auto cache = _getIndexCache();
+                if (cache->sorted)
                 {
-                    const size_t size = j.max - j.min + 1;
-                    if (value < size)
+                    if (value >= 0 && value < static_cast<Index>(cache->size))
                     {
-                        out = j.min + value;
-                        break;
+                        const auto i = std::upper_bound(cache->offsets.begin(), cache->offsets.end(), value) - 1;
+                        out = ranges[i - cache->offsets.begin()].min + value - *i;
+                    }
+                }
+                else
+                {
+                    for (const auto& j : ranges)
+                    {
+                        const size_t size = j.max - j.min + 1;
+                        if (value < size)
+                        {
+                            out = j.min + value;
+                            break;
+                        }
+                        value -= size;
                     }
-                    value -= size;
                 }
                 return out;
             }
@@ -100,34 +131,59 @@ namespace djv
             inline Index Sequence::getIndex(Number value) const
             {
                 Index out = invalidIndex;
-                Index tmp = 0;
-                for (const auto& j : ranges)
+                const auto cache = _getIndexCache();
+                if (cache->sorted)
                 {
-                    if (j.contains(value))
+                    const auto i = std::upper_bound(
+                        ranges.begin(),
+                        ranges.end(),
+                        value,
+                        [](Number value, const Range& range)
+                        {
+                            return value < range.min;
+                        });
+                    if (i != ranges.begin() && (i - 1)->contains(value))
                     {
-                        out = tmp + value - j.min;
-                        break;
+                        const size_t j = i - 1 - ranges.begin();
+                        out = cache->offsets[j] + value - ranges[j].min;
+                    }
+                }
+                else
+                {
+                    Index tmp = 0;
+                    for (const auto& j : ranges)
+                    {
+                        if (j.contains(value))
+                        {
+                            out = tmp + value - j.min;
+                            break;
+                        }
+                        tmp += j.max - j.min + 1;
                     }
-                    tmp += j.max - j.min + 1;
                 }
                 return out;
             }
 
             inline Index Sequence::getLastIndex() const
             {
-                Index out = 0;
-                for (const auto& i : ranges)
-                {
-                    if (i.min < i.max)
-                    {
-                        out += i.max - i.min + 1;
-                    }
-                    else
-                    {
-                        out += i.min - i.max + 1;
-                    }
-                }
-                return out > 0 ? (out - 1) : 0;
+                const size_t size = _getIndexCache()->size;
+                return size > 0 ? (size - 1) : 0;
+            }
+
+            inline Sequence& Sequence::operator = (const Sequence& other)
+            {
+                ranges = other.ranges;
+                pad = other.pad;
+                std::atomic_store(&_indexCache, std::atomic_load(&other._indexCache));
+                return *this;
+            }
+
+            inline Sequence& Sequence::operator = (Sequence&& other)
+            {
+                ranges = std::move(other.ranges);
+                pad = other.pad;
+                std::atomic_store(&_indexCache, std::atomic_load(&other._indexCache));
+                return *this;
             }
 
             inline bool Sequence::operator == (const Sequence & value) const
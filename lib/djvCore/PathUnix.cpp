@@ -48,6 +48,17 @@ namespace djv
                 }
             }
             
+            void Path::rm(const Path& value)
+            {
+                if (::unlink(value.get().c_str()) != 0)
+                {
+                    //! \todo How can we translate this?
+                    throw std::invalid_argument(String::Format("{0}: {1}").
+                        arg(value.get()).
+                        arg(DJV_TEXT("error_cannot_be_removed")));
+                }
+            }
+
             Path Path::getAbsolute(const Path& value)
             {
                 std::string directoryName = value.getDirectoryName();
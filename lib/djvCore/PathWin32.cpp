@@ -16,6 +16,7 @@
 #endif // NOMINMAX
 #include <windows.h>
 #include <direct.h>
+#include <io.h>
 
 #include <codecvt>
 #include <locale>
@@ -48,6 +49,17 @@ namespace djv
                 }
             }
 
+            void Path::rm(const Path & value)
+            {
+                if (_wunlink(String::toWide(value.get()).c_str()) != 0)
+                {
+                    //! \todo How can we translate this?
+                    throw std::invalid_argument(String::Format("{0}: {1}").
+                        arg(value.get()).
+                        arg(DJV_TEXT("error_cannot_be_removed")));
+                }
+            }
+
             Path Path::getAbsolute(const Path & value)
             {
                 wchar_t buf[MAX_PATH];
@@ -149,6 +149,8 @@ namespace djv
             Path settingsFile(documents, applicationName + ".json");
             p.paths[ResourcePath::SettingsFile] = settingsFile;
 
+            p.paths[ResourcePath::Cache] = Path(documents, "Cache");
+
             Path testPath = p.paths[ResourcePath::Application];
             testPath.append("djvCore.en.text");
             if (FileInfo(testPath).doesExist())
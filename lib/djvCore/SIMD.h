@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+//! \def DJV_SSE2
+//! This macro is defined when the compiler targets SSE2, which is always
+//! available on x86-64.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_SSE2
+#include <emmintrin.h>
+#endif // DJV_SSE2
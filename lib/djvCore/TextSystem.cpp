@@ -378,6 +378,8 @@ namespace djv
             std::vector<FileSystem::FileInfo> out;
             FileSystem::DirectoryListOptions options;
             options.filter = "\\.text$";
+            // The modification times are used to reload changed files.
+            options.stat = true;
 
             const auto textPath = p.resourceSystem->getPath(FileSystem::ResourcePath::Text);
             out = FileSystem::FileInfo::directoryList(textPath, options);
@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            const size_t priorityCount = static_cast<size_t>(ThreadPool::Priority::Count);
+
+            //! This struct provides the per-thread job queues.
+            struct Worker
+            {
+                std::mutex mutex;
+                std::deque<std::function<void()> > queues[priorityCount];
+            };
+
+            //! The pool and worker index of the current thread, used to keep
+            //! jobs pushed from a worker on that worker's queue.
+            thread_local const void* currentPool = nullptr;
+            thread_local size_t currentWorker = 0;
+
+            //! This struct provides the state of a parallel loop that is
+            //! shared between the threads.
+            struct ParallelFor
+            {
+                std::function<void(size_t)> function;
+                size_t count = 0;
+                std::atomic<size_t> next;
+                size_t finished = 0;
+                std::atomic<bool> canceled;
+                std::exception_ptr exception;
+                std::mutex mutex;
+                std::condition_variable cv;
+            };
+
+            void runParallelFor(const std::shared_ptr<ParallelFor>& data)
+            {
+                // Exceptions are caught for each index so that the index is
+                // still counted as finished, and the calls that have not
+                // started yet are skipped.
+                size_t count = 0;
+                size_t i = 0;
+                while ((i = data->next++) < data->count)
+                {
+                    if (!data->canceled)
+                    {
+                        try
+                        {
+                            data->function(i);
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard<std::mutex> lock(data->mutex);
+                            if (!data->exception)
+                            {
+                                data->exception = std::current_exception();
+                            }
+                            data->canceled = true;
+                        }
+                    }
+                    ++count;
+                }
+                if (count)
+                {
+                    std::lock_guard<std::mutex> lock(data->mutex);
+                    data->finished += count;
+                    if (data->finished == data->count)
+                    {
+                        data->cv.notify_all();
+                    }
+                }
+            }
+
+        } // namespace
+
+        struct ThreadPool::Private
+        {
+            std::vector<std::unique_ptr<Worker> > workers;
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable cv;
+            size_t pending = 0;
+            size_t active = 0;
+            size_t maxActive = 0;
+            std::atomic<size_t> next;
+            std::atomic<bool> running;
+        };
+
+        void ThreadPool::_init(size_t threadCount)
+        {
+            DJV_PRIVATE_PTR();
+            if (0 == threadCount)
+            {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            p.maxActive = threadCount;
+            p.next = 0;
+            p.running = true;
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.workers.push_back(std::unique_ptr<Worker>(new Worker));
+            }
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.threads.push_back(std::thread(
+                    [this, i]
+                    {
+                        _run(i);
+                    }));
+            }
+        }
+
+        ThreadPool::ThreadPool() :
+            _p(new Private)
+        {}
+
+        ThreadPool::~ThreadPool()
+        {
+            DJV_PRIVATE_PTR();
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_all();
+            for (auto& i : p.threads)
+            {
+                if (i.joinable())
+                {
+                    i.join();
+                }
+            }
+        }
+
+        std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+        {
+            auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+            out->_init(threadCount);
+            return out;
+        }
+
+        size_t ThreadPool::getThreadCount() const
+        {
+            return _p->threads.size();
+        }
+
+        size_t ThreadPool::getMaxActive() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.maxActive;
+        }
+
+        void ThreadPool::setMaxActive(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                p.maxActive = std::max(value, static_cast<size_t>(1));
+            }
+            p.cv.notify_all();
+        }
+
+        size_t ThreadPool::getActiveCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.active;
+        }
+
+        size_t ThreadPool::getPendingCount() const
+        {
+            DJV_PRIVATE_PTR();
+            std::lock_guard<std::mutex> lock(p.mutex);
+            return p.pending;
+        }
+
+        void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& function, Priority priority)
+        {
+            DJV_PRIVATE_PTR();
+            if (count < 2)
+            {
+                if (count)
+                {
+                    function(0);
+                }
+                return;
+            }
+            auto data = std::make_shared<ParallelFor>();
+            data->function = function;
+            data->count = count;
+            data->next = 0;
+            data->canceled = false;
+            const size_t helperCount = std::min(p.workers.size(), count - 1);
+            for (size_t i = 0; i < helperCount; ++i)
+            {
+                _push(
+                    [data]
+                    {
+                        runParallelFor(data);
+                    },
+                    priority);
+            }
+            runParallelFor(data);
+            std::unique_lock<std::mutex> lock(data->mutex);
+            data->cv.wait(
+                lock,
+                [data]
+                {
+                    return data->finished == data->count;
+                });
+            if (data->exception)
+            {
+                std::rethrow_exception(data->exception);
+            }
+        }
+
+        void ThreadPool::_push(std::function<void()>&& job, Priority priority)
+        {
+            DJV_PRIVATE_PTR();
+            size_t index = 0;
+            if (this == currentPool)
+            {
+                index = currentWorker;
+            }
+            else
+            {
+                index = p.next++ % p.workers.size();
+            }
+            {
+                auto& worker = *p.workers[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.queues[static_cast<size_t>(priority)].push_back(std::move(job));
+            }
+            {
+                std::lock_guard<std::mutex> lock(p.mutex);
+                ++p.pending;
+            }
+            p.cv.notify_one();
+        }
+
+        void ThreadPool::_run(size_t index)
+        {
+            DJV_PRIVATE_PTR();
+            currentPool = this;
+            currentWorker = index;
+            while (true)
+            {
+                // Wait for a job and a free slot.
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            DJV_PRIVATE_PTR();
+                            return !p.running || (p.pending > 0 && p.active < p.maxActive);
+                        });
+                    if (!p.running)
+                    {
+                        break;
+                    }
+                    --p.pending;
+                    ++p.active;
+                }
+
+                // Every claimed slot is backed by a queued job, so keep
+                // looking until it is found.
+                std::function<void()> job;
+                while (!_pop(index, job))
+                {
+                    std::this_thread::yield();
+                }
+                job();
+                job = nullptr;
+
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    --p.active;
+                }
+                p.cv.notify_one();
+            }
+        }
+
+        bool ThreadPool::_pop(size_t index, std::function<void()>& out)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t workerCount = p.workers.size();
+            for (int priority = static_cast<int>(priorityCount) - 1; priority >= 0; --priority)
+            {
+                // Take the oldest job from our own queue first, then steal
+                // the newest job from the other workers.
+                {
+                    auto& worker = *p.workers[index];
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    auto& queue = worker.queues[priority];
+                    if (queue.size())
+                    {
+                        out = std::move(queue.front());
+                        queue.pop_front();
+                        return true;
+                    }
+                }
+                for (size_t i = 1; i < workerCount; ++i)
+                {
+                    auto& worker = *p.workers[(index + i) % workerCount];
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    auto& queue = worker.queues[priority];
+                    if (queue.size())
+                    {
+                        out = std::move(queue.back());
+                        queue.pop_back();
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    } // namespace Core
+} // namespace djv
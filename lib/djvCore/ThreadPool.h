@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a work stealing thread pool.
+        //!
+        //! Each worker thread owns a queue of jobs for each priority level.
+        //! Idle workers steal jobs from the other workers, always taking the
+        //! highest priority job available. The number of jobs running at the
+        //! same time can be capped independently of the number of threads.
+        class ThreadPool : public std::enable_shared_from_this<ThreadPool>
+        {
+            DJV_NON_COPYABLE(ThreadPool);
+            void _init(size_t threadCount);
+            ThreadPool();
+
+        public:
+            ~ThreadPool();
+
+            //! Create a new thread pool. If the thread count is zero the
+            //! number of hardware threads is used.
+            static std::shared_ptr<ThreadPool> create(size_t threadCount = 0);
+
+            //! This enumeration provides the job priorities.
+            enum class Priority
+            {
+                Low,
+                Normal,
+                High,
+
+                Count
+            };
+
+            //! Get the number of worker threads.
+            size_t getThreadCount() const;
+
+            //! \name Concurrency
+            ///@{
+
+            //! Get the maximum number of jobs that may run at the same time.
+            size_t getMaxActive() const;
+
+            //! Set the maximum number of jobs that may run at the same time.
+            void setMaxActive(size_t);
+
+            ///@}
+
+            //! \name Statistics
+            ///@{
+
+            size_t getActiveCount() const;
+            size_t getPendingCount() const;
+
+            ///@}
+
+            //! Add a job to the pool.
+            template<typename T>
+            std::future<typename std::result_of<T()>::type> push(T&&, Priority = Priority::Normal);
+
+            //! Call a function for each index from zero to the given count,
+            //! with the calls distributed across the worker threads. The
+            //! calling thread also makes calls, so this finishes even if the
+            //! pool is busy, and it returns when all of the calls have
+            //! finished. If a call throws an exception the calls that have
+            //! not started are skipped, and the first exception is rethrown
+            //! on the calling thread after the other calls have finished.
+            //! The priority should match the priority of the calling job so
+            //! that the helper jobs do not run ahead of other work.
+            void parallelFor(size_t count, const std::function<void(size_t)>&, Priority = Priority::High);
+
+        private:
+            void _push(std::function<void()>&&, Priority);
+            void _run(size_t);
+            bool _pop(size_t, std::function<void()>&);
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Core
+} // namespace djv
+
+#include <djvCore/ThreadPoolInline.h>
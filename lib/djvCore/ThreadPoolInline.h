@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace Core
+    {
+        template<typename T>
+        inline std::future<typename std::result_of<T()>::type> ThreadPool::push(T&& value, Priority priority)
+        {
+            typedef typename std::result_of<T()>::type Result;
+            auto task = std::make_shared<std::packaged_task<Result()> >(std::forward<T>(value));
+            auto out = task->get_future();
+            _push(
+                [task]
+                {
+                    (*task)();
+                },
+                priority);
+            return out;
+        }
+
+    } // namespace Core
+} // namespace djv
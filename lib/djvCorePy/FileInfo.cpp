@@ -34,7 +34,8 @@ void wrapFileInfo(pybind11::module& m)
         .def_readwrite("sort", &FileSystem::DirectoryListOptions::sort)
         .def_readwrite("reverseSort", &FileSystem::DirectoryListOptions::reverseSort)
         .def_readwrite("sortDirectoriesFirst", &FileSystem::DirectoryListOptions::sortDirectoriesFirst)
-        .def_readwrite("filter", &FileSystem::DirectoryListOptions::filter);
+        .def_readwrite("filter", &FileSystem::DirectoryListOptions::filter)
+        .def_readwrite("stat", &FileSystem::DirectoryListOptions::stat);
 
     py::class_<FileSystem::FileInfo>(m, "FileInfo")
         .def(py::init<>())
@@ -66,6 +67,7 @@ void wrapFileInfo(pybind11::module& m)
         .def("addToSequence", &FileSystem::FileInfo::addToSequence)
         .def_static("directoryList", &FileSystem::FileInfo::directoryList, py::arg("path"), py::arg("options") = FileSystem::DirectoryListOptions())
         .def_static("getFileSequence", &FileSystem::FileInfo::getFileSequence)
+        .def_static("groupFileSequences", &FileSystem::FileInfo::groupFileSequences)
         .def(py::self == py::self)
         .def(py::self != py::self)
         .def(py::self < py::self);
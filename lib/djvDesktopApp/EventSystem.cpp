@@ -254,6 +254,10 @@ namespace djv
                     p.render->endFrame();
                     glBindFramebuffer(GL_FRAMEBUFFER, 0);
                     _redraw();
+
+                    // Draw again when the color space conversions that are being
+                    // prepared are ready.
+                    p.redrawRequest |= p.render->hasPendingColorSpaces();
                 }
             }
         }
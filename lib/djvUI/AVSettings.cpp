@@ -6,6 +6,7 @@
 
 #include <djvAV/AVSystem.h>
 #include <djvAV/IO.h>
+#include <djvAV/OCIOLUT.h>
 #include <djvAV/Render2D.h>
 
 #include <djvCore/Context.h>
@@ -64,16 +65,22 @@ namespace djv
                     Time::FPS defaultSpeed = Time::getDefaultSpeed();
                     djv::AV::Render2D::ImageFilterOptions imageFilterOptions;
                     bool lcdText = false;
+                    size_t textureCacheSize = djv::AV::Render2D::textureCacheSizeDefault;
+                    size_t lutSize = djv::AV::OCIO::lutSizeDefault;
                     read("TimeUnits", object, timeUnits);
                     read("AlphaBlend", object, alphaBlend);
                     read("DefaultSpeed", object, defaultSpeed);
                     read("ImageFilterOptions", object, imageFilterOptions);
                     read("LCDText", object, lcdText);
+                    read("TextureCacheSize", object, textureCacheSize);
+                    read("LUTSize", object, lutSize);
                     p.avSystem->setTimeUnits(timeUnits);
                     p.avSystem->setAlphaBlend(alphaBlend);
                     p.avSystem->setDefaultSpeed(defaultSpeed);
                     p.avSystem->setImageFilterOptions(imageFilterOptions);
                     p.avSystem->setLCDText(lcdText);
+                    p.avSystem->setTextureCacheSize(textureCacheSize);
+                    p.avSystem->setLUTSize(lutSize);
                     for (const auto & i : p.ioSystem->getPluginNames())
                     {
                         const auto j = object.find(i);
@@ -95,6 +102,8 @@ namespace djv
                 write("DefaultSpeed", p.avSystem->observeDefaultSpeed()->get(), object);
                 write("ImageFilterOptions", p.avSystem->observeImageFilterOptions()->get(), object);
                 write("LCDText", p.avSystem->observeLCDText()->get(), object);
+                write("TextureCacheSize", p.avSystem->observeTextureCacheSize()->get(), object);
+                write("LUTSize", p.avSystem->observeLUTSize()->get(), object);
                 for (const auto & i : p.ioSystem->getPluginNames())
                 {
                     object[i] = p.ioSystem->getOptions(i);
@@ -269,7 +269,6 @@ namespace djv
                 std::shared_ptr<AV::Image::Image> image;
                 bool finished = false;
                 {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
                     auto& queue = i->read->getVideoQueue();
                     if (!queue.isEmpty())
                     {
@@ -152,9 +152,10 @@ namespace djv
             glm::mat3x3 m(1.F);
             m = glm::rotate(m, Math::deg2rad(UI::getImageRotate(rotate)));
             const auto& info = image->getInfo();
+            const float proxyScale = static_cast<float>(1 << image->getProxy());
             m = glm::scale(m, glm::vec2(
-                scale.x * UI::getPixelAspectRatio(imageAspectRatio, info.pixelAspectRatio),
-                scale.y * UI::getAspectRatioScale(imageAspectRatio, image->getAspectRatio())));
+                scale.x * proxyScale * UI::getPixelAspectRatio(imageAspectRatio, info.pixelAspectRatio),
+                scale.y * proxyScale * UI::getAspectRatioScale(imageAspectRatio, image->getAspectRatio())));
             switch (rotate)
             {
             case ImageRotate::_90:
@@ -255,10 +256,13 @@ namespace djv
                 options.cache = AV::Render2D::ImageCache::Dynamic;
                 glm::mat3x3 m(1.F);
                 m = glm::translate(m, pos);
+                const float proxyScale = static_cast<float>(1 << p.image->getProxy());
                 m *= getXForm(
                     p.image,
                     p.imageRotate,
-                    glm::vec2(size.x / static_cast<float>(info.size.w), size.y / static_cast<float>(info.size.h)),
+                    glm::vec2(
+                        size.x / static_cast<float>(info.size.w) / proxyScale,
+                        size.y / static_cast<float>(info.size.h) / proxyScale),
                     UI::ImageAspectRatio::Unscaled);
 
                 auto i = p.ocioConfig.fileColorSpaces.find(p.image->getPluginName());
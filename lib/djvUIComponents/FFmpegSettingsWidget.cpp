@@ -4,6 +4,7 @@
 
 #include <djvUIComponents/FFmpegSettingsWidget.h>
 
+#include <djvUI/CheckBox.h>
 #include <djvUI/FormLayout.h>
 #include <djvUI/GroupBox.h>
 #include <djvUI/IntSlider.h>
@@ -21,6 +22,8 @@ namespace djv
         struct FFmpegSettingsWidget::Private
         {
             std::shared_ptr<IntSlider> threadCountSlider;
+            std::shared_ptr<CheckBox> frameThreadingCheckBox;
+            std::shared_ptr<IntSlider> convertThreadCountSlider;
             std::shared_ptr<FormLayout> layout;
         };
 
@@ -34,8 +37,15 @@ namespace djv
             p.threadCountSlider = IntSlider::create(context);
             p.threadCountSlider->setRange(IntRange(1, 16));
 
+            p.frameThreadingCheckBox = CheckBox::create(context);
+
+            p.convertThreadCountSlider = IntSlider::create(context);
+            p.convertThreadCountSlider->setRange(IntRange(1, 16));
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.threadCountSlider);
+            p.layout->addChild(p.frameThreadingCheckBox);
+            p.layout->addChild(p.convertThreadCountSlider);
             addChild(p.layout);
 
             _widgetUpdate();
@@ -57,6 +67,38 @@ namespace djv
                         }
                     }
                 });
+
+            p.frameThreadingCheckBox->setCheckedCallback(
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::FFmpeg::Options options;
+                            fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
+                            options.frameThreading = value;
+                            io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options));
+                        }
+                    }
+                });
+
+            p.convertThreadCountSlider->setValueCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::FFmpeg::Options options;
+                            fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
+                            options.convertThreadCount = value;
+                            io->setOptions(AV::IO::FFmpeg::pluginName, toJSON(options));
+                        }
+                    }
+                });
         }
 
         FFmpegSettingsWidget::FFmpegSettingsWidget() :
@@ -95,6 +137,8 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("settings_io_ffmpeg_thread_count")) + ":");
+            p.frameThreadingCheckBox->setText(_getText(DJV_TEXT("settings_io_ffmpeg_frame_threading")));
+            p.layout->setText(p.convertThreadCountSlider, _getText(DJV_TEXT("settings_io_ffmpeg_convert_thread_count")) + ":");
             _widgetUpdate();
         }
 
@@ -108,6 +152,8 @@ namespace djv
                 fromJSON(io->getOptions(AV::IO::FFmpeg::pluginName), options);
 
                 p.threadCountSlider->setValue(options.threadCount);
+                p.frameThreadingCheckBox->setChecked(options.frameThreading);
+                p.convertThreadCountSlider->setValue(options.convertThreadCount);
             }
         }
 
@@ -292,7 +292,8 @@ namespace djv
                                     {
                                         if (ioSystem->canRead(fileInfo))
                                         {
-                                            p.ioInfoFutures[i.first] = thumbnailSystem->getInfo(fileInfo);
+                                            // Items are prioritized by their position in the view.
+                                            p.ioInfoFutures[i.first] = thumbnailSystem->getInfo(fileInfo, i.first);
                                         }
                                     }
                                 }
@@ -305,7 +306,7 @@ namespace djv
                                     auto ioSystem = context->getSystemT<AV::IO::System>();
                                     if (thumbnailSystem && ioSystem && ioSystem->canRead(fileInfo))
                                     {
-                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize);
+                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize, AV::Image::Type::None, i.first);
                                     }
                                 }
                             }
@@ -1079,7 +1080,7 @@ namespace djv
                                     auto ioSystem = context->getSystemT<AV::IO::System>();
                                     if (ioSystem && ioSystem->canRead(fileInfo))
                                     {
-                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize);
+                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize, AV::Image::Type::None, i.first);
                                     }
                                 }
                             }
@@ -4,6 +4,7 @@
 
 #include <djvUIComponents/OpenEXRSettingsWidget.h>
 
+#include <djvUI/CheckBox.h>
 #include <djvUI/ComboBox.h>
 #include <djvUI/FloatSlider.h>
 #include <djvUI/FormLayout.h>
@@ -26,6 +27,8 @@ namespace djv
             std::shared_ptr<ComboBox> channelsComboBox;
             std::shared_ptr<ComboBox> compressionComboBox;
             std::shared_ptr<FloatSlider> dwaCompressionLevelSlider;
+            std::shared_ptr<CheckBox> tiledCheckBox;
+            std::shared_ptr<IntSlider> tileSizeSlider;
             std::shared_ptr<FormLayout> layout;
         };
 
@@ -37,7 +40,7 @@ namespace djv
             setClassName("djv::UI::OpenEXRSettingsWidget");
 
             p.threadCountSlider = IntSlider::create(context);
-            p.threadCountSlider->setRange(IntRange(1, 16));
+            p.threadCountSlider->setRange(IntRange(0, 16));
 
             p.channelsComboBox = ComboBox::create(context);
             
@@ -46,11 +49,18 @@ namespace djv
             p.dwaCompressionLevelSlider = FloatSlider::create(context);
             p.dwaCompressionLevelSlider->setRange(FloatRange(0.F, 200.F));
 
+            p.tiledCheckBox = CheckBox::create(context);
+
+            p.tileSizeSlider = IntSlider::create(context);
+            p.tileSizeSlider->setRange(IntRange(16, 512));
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.threadCountSlider);
             p.layout->addChild(p.channelsComboBox);
             p.layout->addChild(p.compressionComboBox);
             p.layout->addChild(p.dwaCompressionLevelSlider);
+            p.layout->addChild(p.tiledCheckBox);
+            p.layout->addChild(p.tileSizeSlider);
             addChild(p.layout);
 
             _widgetUpdate();
@@ -120,6 +130,38 @@ namespace djv
                         }
                     }
                 });
+
+            p.tiledCheckBox->setCheckedCallback(
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::OpenEXR::Options options;
+                            fromJSON(io->getOptions(AV::IO::OpenEXR::pluginName), options);
+                            options.tiled = value;
+                            io->setOptions(AV::IO::OpenEXR::pluginName, toJSON(options));
+                        }
+                    }
+                });
+
+            p.tileSizeSlider->setValueCallback(
+                [weak, contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto io = context->getSystemT<AV::IO::System>();
+                            AV::IO::OpenEXR::Options options;
+                            fromJSON(io->getOptions(AV::IO::OpenEXR::pluginName), options);
+                            options.tileSize = value;
+                            io->setOptions(AV::IO::OpenEXR::pluginName, toJSON(options));
+                        }
+                    }
+                });
         }
 
         OpenEXRSettingsWidget::OpenEXRSettingsWidget() :
@@ -161,6 +203,8 @@ namespace djv
             p.layout->setText(p.channelsComboBox, _getText(DJV_TEXT("settings_io_exr_channel_grouping")) + ":");
             p.layout->setText(p.compressionComboBox, _getText(DJV_TEXT("settings_io_exr_compression")) + ":");
             p.layout->setText(p.dwaCompressionLevelSlider, _getText(DJV_TEXT("settings_io_exr_dwa_compression_level")) + ":");
+            p.tiledCheckBox->setText(_getText(DJV_TEXT("settings_io_exr_tiled")));
+            p.layout->setText(p.tileSizeSlider, _getText(DJV_TEXT("settings_io_exr_tile_size")) + ":");
             _widgetUpdate();
         }
 
@@ -194,6 +238,9 @@ namespace djv
                 p.compressionComboBox->setCurrentItem(static_cast<int>(options.compression));
 
                 p.dwaCompressionLevelSlider->setValue(options.dwaCompressionLevel);
+
+                p.tiledCheckBox->setChecked(options.tiled);
+                p.tileSizeSlider->setValue(options.tileSize);
             }
         }
 
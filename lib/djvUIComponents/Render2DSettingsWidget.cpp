@@ -7,12 +7,15 @@
 #include <djvUI/CheckBox.h>
 #include <djvUI/ComboBox.h>
 #include <djvUI/FormLayout.h>
+#include <djvUI/IntSlider.h>
 #include <djvUI/RowLayout.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/OCIOLUT.h>
 #include <djvAV/Render2D.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/Memory.h>
 
 using namespace djv::Core;
 
@@ -20,12 +23,24 @@ namespace djv
 {
     namespace UI
     {
+        namespace
+        {
+            const std::vector<size_t> lutSizes = { 16, 32, 64 };
+
+        } // namespace
+
         struct Render2DImageSettingsWidget::Private
         {
             AV::Render2D::ImageFilterOptions filterOptions;
+            size_t textureCacheSize = 0;
+            size_t lutSize = 0;
             std::shared_ptr<UI::ComboBox> filterComboBox[2];
+            std::shared_ptr<UI::IntSlider> textureCacheSizeSlider;
+            std::shared_ptr<UI::ComboBox> lutSizeComboBox;
             std::shared_ptr<UI::FormLayout> layout;
             std::shared_ptr<ValueObserver<AV::Render2D::ImageFilterOptions> > filterOptionsObserver;
+            std::shared_ptr<ValueObserver<size_t> > textureCacheSizeObserver;
+            std::shared_ptr<ValueObserver<size_t> > lutSizeObserver;
         };
 
         void Render2DImageSettingsWidget::_init(const std::shared_ptr<Context>& context)
@@ -38,9 +53,16 @@ namespace djv
             p.filterComboBox[0] = UI::ComboBox::create(context);
             p.filterComboBox[1] = UI::ComboBox::create(context);
 
+            p.textureCacheSizeSlider = UI::IntSlider::create(context);
+            p.textureCacheSizeSlider->setRange(IntRange(64, 8192));
+
+            p.lutSizeComboBox = UI::ComboBox::create(context);
+
             p.layout = UI::FormLayout::create(context);
             p.layout->addChild(p.filterComboBox[0]);
             p.layout->addChild(p.filterComboBox[1]);
+            p.layout->addChild(p.textureCacheSizeSlider);
+            p.layout->addChild(p.lutSizeComboBox);
             addChild(p.layout);
 
             auto weak = std::weak_ptr<Render2DImageSettingsWidget>(std::dynamic_pointer_cast<Render2DImageSettingsWidget>(shared_from_this()));
@@ -71,6 +93,27 @@ namespace djv
                         }
                     }
                 });
+            p.textureCacheSizeSlider->setValueCallback(
+                [contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto avSystem = context->getSystemT<AV::AVSystem>();
+                        avSystem->setTextureCacheSize(static_cast<size_t>(value * Memory::megabyte));
+                    }
+                });
+            p.lutSizeComboBox->setCallback(
+                [contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (value >= 0 && value < static_cast<int>(lutSizes.size()))
+                        {
+                            auto avSystem = context->getSystemT<AV::AVSystem>();
+                            avSystem->setLUTSize(lutSizes[value]);
+                        }
+                    }
+                });
 
             auto avSystem = context->getSystemT<AV::AVSystem>();
             p.filterOptionsObserver = ValueObserver<AV::Render2D::ImageFilterOptions>::create(
@@ -83,6 +126,26 @@ namespace djv
                         widget->_widgetUpdate();
                     }
                 });
+            p.textureCacheSizeObserver = ValueObserver<size_t>::create(
+                avSystem->observeTextureCacheSize(),
+                [weak](size_t value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->textureCacheSize = value;
+                        widget->_widgetUpdate();
+                    }
+                });
+            p.lutSizeObserver = ValueObserver<size_t>::create(
+                avSystem->observeLUTSize(),
+                [weak](size_t value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->lutSize = value;
+                        widget->_widgetUpdate();
+                    }
+                });
         }
 
         Render2DImageSettingsWidget::Render2DImageSettingsWidget() :
@@ -122,6 +185,8 @@ namespace djv
             DJV_PRIVATE_PTR();
             p.layout->setText(p.filterComboBox[0], _getText(DJV_TEXT("settings_render2d_minify_filter")) + ":");
             p.layout->setText(p.filterComboBox[1], _getText(DJV_TEXT("settings_render2d_magnify_filter")) + ":");
+            p.layout->setText(p.textureCacheSizeSlider, _getText(DJV_TEXT("settings_render2d_texture_cache_size")) + ":");
+            p.layout->setText(p.lutSizeComboBox, _getText(DJV_TEXT("settings_render2d_lut_size")) + ":");
             _widgetUpdate();
         }
 
@@ -139,6 +204,14 @@ namespace djv
             }
             p.filterComboBox[0]->setCurrentItem(static_cast<int>(p.filterOptions.min));
             p.filterComboBox[1]->setCurrentItem(static_cast<int>(p.filterOptions.mag));
+            p.textureCacheSizeSlider->setValue(static_cast<int>(p.textureCacheSize / Memory::megabyte));
+            p.lutSizeComboBox->clearItems();
+            for (const auto i : lutSizes)
+            {
+                p.lutSizeComboBox->addItem(std::to_string(i));
+            }
+            const auto i = std::find(lutSizes.begin(), lutSizes.end(), p.lutSize);
+            p.lutSizeComboBox->setCurrentItem(i != lutSizes.end() ? static_cast<int>(i - lutSizes.begin()) : -1);
         }
 
         struct Render2DTextSettingsWidget::Private
@@ -189,7 +189,6 @@ namespace djv
                     {
                         bool erase = false;
                         {
-                            std::unique_lock<std::mutex> lock((*i)->getMutex());
                             auto& queue = (*i)->getVideoQueue();
                             if (!queue.isEmpty())
                             {
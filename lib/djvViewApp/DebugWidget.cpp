@@ -23,6 +23,7 @@
 #include <djvAV/ThumbnailSystem.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/Memory.h>
 #include <djvCore/Timer.h>
 
 using namespace djv::Core;
@@ -430,6 +431,19 @@ namespace djv
                 _lineGraphs["DynamicTextureCount"] = UI::LineGraphWidget::create(context);
                 _lineGraphs["DynamicTextureCount"]->setPrecision(0);
 
+                _labels["DynamicTextureByteCount"] = UI::Label::create(context);
+                _labels["DynamicTextureByteCountValue"] = UI::Label::create(context);
+                _labels["DynamicTextureByteCountValue"]->setFont(AV::Font::familyMono);
+                _thermometerWidgets["DynamicTextureByteCount"] = UI::ThermometerWidget::create(context);
+
+                _labels["DynamicTextureHits"] = UI::Label::create(context);
+                _labels["DynamicTextureHitsValue"] = UI::Label::create(context);
+                _labels["DynamicTextureHitsValue"]->setFont(AV::Font::familyMono);
+
+                _labels["DynamicTextureUploads"] = UI::Label::create(context);
+                _labels["DynamicTextureUploadsValue"] = UI::Label::create(context);
+                _labels["DynamicTextureUploadsValue"]->setFont(AV::Font::familyMono);
+
                 _labels["VBOSize"] = UI::Label::create(context);
                 _labels["VBOSizeValue"] = UI::Label::create(context);
                 _labels["VBOSizeValue"]->setFont(AV::Font::familyMono);
@@ -454,6 +468,19 @@ namespace djv
                 _layout->addChild(hLayout);
                 _layout->addChild(_lineGraphs["DynamicTextureCount"]);
                 hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["DynamicTextureByteCount"]);
+                hLayout->addChild(_labels["DynamicTextureByteCountValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_thermometerWidgets["DynamicTextureByteCount"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["DynamicTextureHits"]);
+                hLayout->addChild(_labels["DynamicTextureHitsValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["DynamicTextureUploads"]);
+                hLayout->addChild(_labels["DynamicTextureUploadsValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
                 hLayout->addChild(_labels["VBOSize"]);
                 hLayout->addChild(_labels["VBOSizeValue"]);
                 _layout->addChild(hLayout);
@@ -489,10 +516,19 @@ namespace djv
                 auto render = _getRender();
                 const float textureAtlasPercentage = render->getTextureAtlasPercentage();
                 const size_t dynamicTextureCount = render->getDynamicTextureCount();
+                const size_t dynamicTextureByteCount = render->getDynamicTextureByteCount();
+                const size_t textureCacheSize = render->getTextureCacheSize();
+                const size_t dynamicTextureHits = render->getDynamicTextureHits();
+                const size_t dynamicTextureMisses = render->getDynamicTextureMisses();
+                const uint64_t dynamicTextureUploadByteCount = render->getDynamicTextureUploadByteCount();
                 const size_t vboSize = render->getVBOSize();
 
                 _thermometerWidgets["TextureAtlas"]->setPercentage(textureAtlasPercentage);
                 _lineGraphs["DynamicTextureCount"]->addSample(dynamicTextureCount);
+                _thermometerWidgets["DynamicTextureByteCount"]->setPercentage(
+                    textureCacheSize > 0 ?
+                    std::min(dynamicTextureByteCount / static_cast<float>(textureCacheSize) * 100.F, 100.F) :
+                    0.F);
                 _lineGraphs["VBOSize"]->addSample(vboSize);
 
                 {
@@ -516,6 +552,36 @@ namespace djv
                     ss << dynamicTextureCount;
                     _labels["DynamicTextureCountValue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_render_dynamic_texture_byte_count")) << ":";
+                    _labels["DynamicTextureByteCount"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << Memory::getSizeLabel(dynamicTextureByteCount) << "/" << Memory::getSizeLabel(textureCacheSize);
+                    _labels["DynamicTextureByteCountValue"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_render_dynamic_texture_hits")) << ":";
+                    _labels["DynamicTextureHits"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << dynamicTextureHits << "/" << dynamicTextureMisses;
+                    _labels["DynamicTextureHitsValue"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_render_dynamic_texture_uploads")) << ":";
+                    _labels["DynamicTextureUploads"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << Memory::getSizeLabel(dynamicTextureUploadByteCount);
+                    _labels["DynamicTextureUploadsValue"]->setText(ss.str());
+                }
                 {
                     std::stringstream ss;
                     ss << _getText(DJV_TEXT("debug_render_vbo_size")) << ":";
@@ -554,6 +620,8 @@ namespace djv
                 size_t _videoQueueCount = 0;
                 size_t _audioQueueMax = 0;
                 size_t _audioQueueCount = 0;
+                size_t _audioUnderrunCount = 0;
+                size_t _audioDeviceUnderrunCount = 0;
                 std::map<std::string, std::shared_ptr<UI::Label> > _labels;
                 std::map<std::string, std::shared_ptr<UI::LineGraphWidget> > _lineGraphs;
                 std::shared_ptr<UI::VerticalLayout> _layout;
@@ -564,6 +632,9 @@ namespace djv
                 std::shared_ptr<ValueObserver<size_t> > _videoQueueCountObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueMaxObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueCountObserver;
+                std::shared_ptr<ValueObserver<size_t> > _audioBufferCountObserver;
+                std::shared_ptr<ValueObserver<size_t> > _audioUnderrunCountObserver;
+                std::shared_ptr<ValueObserver<size_t> > _audioDeviceUnderrunCountObserver;
             };
 
             void MediaDebugWidget::_init(const std::shared_ptr<Context>& context)
@@ -584,6 +655,17 @@ namespace djv
                 _lineGraphs["AudioQueue"] = UI::LineGraphWidget::create(context);
                 _lineGraphs["AudioQueue"]->setPrecision(0);
 
+                _labels["AudioBuffer"] = UI::Label::create(context);
+                _lineGraphs["AudioBuffer"] = UI::LineGraphWidget::create(context);
+                _lineGraphs["AudioBuffer"]->setPrecision(0);
+
+                _labels["AudioUnderruns"] = UI::Label::create(context);
+                _labels["AudioUnderrunsValue"] = UI::Label::create(context);
+                _labels["AudioUnderrunsValue"]->setFont(AV::Font::familyMono);
+                _labels["AudioDeviceUnderruns"] = UI::Label::create(context);
+                _labels["AudioDeviceUnderrunsValue"] = UI::Label::create(context);
+                _labels["AudioDeviceUnderrunsValue"]->setFont(AV::Font::familyMono);
+
                 for (auto& i : _labels)
                 {
                     i.second->setTextHAlign(UI::TextHAlign::Left);
@@ -599,6 +681,16 @@ namespace djv
                 _layout->addChild(_lineGraphs["VideoQueue"]);
                 _layout->addChild(_labels["AudioQueue"]);
                 _layout->addChild(_lineGraphs["AudioQueue"]);
+                _layout->addChild(_labels["AudioBuffer"]);
+                _layout->addChild(_lineGraphs["AudioBuffer"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["AudioUnderruns"]);
+                hLayout->addChild(_labels["AudioUnderrunsValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["AudioDeviceUnderruns"]);
+                hLayout->addChild(_labels["AudioDeviceUnderrunsValue"]);
+                _layout->addChild(hLayout);
                 addChild(_layout);
 
                 auto weak = std::weak_ptr<MediaDebugWidget>(std::dynamic_pointer_cast<MediaDebugWidget>(shared_from_this()));
@@ -679,6 +771,35 @@ namespace djv
                                         widget->_widgetUpdate();
                                     }
                                 });
+                                widget->_audioBufferCountObserver = ValueObserver<size_t>::create(
+                                    value->observeAudioBufferCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_lineGraphs["AudioBuffer"]->addSample(value);
+                                    }
+                                });
+                                widget->_audioUnderrunCountObserver = ValueObserver<size_t>::create(
+                                    value->observeAudioUnderrunCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioUnderrunCount = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
+                                widget->_audioDeviceUnderrunCountObserver = ValueObserver<size_t>::create(
+                                    value->observeAudioDeviceUnderrunCount(),
+                                    [weak](size_t value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_audioDeviceUnderrunCount = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
                             }
                             else
                             {
@@ -688,12 +809,17 @@ namespace djv
                                 widget->_videoQueueCount = 0;
                                 widget->_audioQueueMax = 0;
                                 widget->_audioQueueCount = 0;
+                                widget->_audioUnderrunCount = 0;
+                                widget->_audioDeviceUnderrunCount = 0;
                                 widget->_sequenceObserver.reset();
                                 widget->_currentFrameObserver.reset();
                                 widget->_videoQueueMaxObserver.reset();
                                 widget->_videoQueueCountObserver.reset();
                                 widget->_audioQueueMaxObserver.reset();
                                 widget->_audioQueueCountObserver.reset();
+                                widget->_audioBufferCountObserver.reset();
+                                widget->_audioUnderrunCountObserver.reset();
+                                widget->_audioDeviceUnderrunCountObserver.reset();
                                 widget->_widgetUpdate();
                             }
                         }
@@ -734,6 +860,21 @@ namespace djv
                     ss << _getText(DJV_TEXT("debug_media_audio_queue")) << ":";
                     _labels["AudioQueue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_audio_buffer")) << ":";
+                    _labels["AudioBuffer"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_audio_underruns")) << ":";
+                    _labels["AudioUnderruns"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_audio_device_underruns")) << ":";
+                    _labels["AudioDeviceUnderruns"]->setText(ss.str());
+                }
                 _widgetUpdate();
             }
 
@@ -749,6 +890,16 @@ namespace djv
                     ss << _currentFrame << " / " << _sequence.getSize();
                     _labels["CurrentFrameValue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _audioUnderrunCount;
+                    _labels["AudioUnderrunsValue"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _audioDeviceUnderrunCount;
+                    _labels["AudioDeviceUnderrunsValue"]->setText(ss.str());
+                }
             }
 
         } // namespace
@@ -26,6 +26,7 @@
 #include <djvCore/RecentFilesModel.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/ThreadPool.h>
 #include <djvCore/Timer.h>
 
 #define GLFW_INCLUDE_NONE
@@ -45,7 +46,9 @@ namespace djv
             std::shared_ptr<ValueSubject<std::shared_ptr<Media> > > closed;
             std::shared_ptr<ListSubject<std::shared_ptr<Media> > > media;
             std::shared_ptr<ValueSubject<std::shared_ptr<Media> > > currentMedia;
+            std::shared_ptr<AV::IO::FrameCache> frameCache;
             std::shared_ptr<ValueSubject<float> > cachePercentage;
+            std::shared_ptr<ValueSubject<AV::IO::FrameCacheStats> > cacheStats;
             std::map<std::string, std::shared_ptr<UI::Action> > actions;
             std::shared_ptr<UI::Menu> menu;
             std::shared_ptr<UI::FileBrowser::Dialog> fileBrowserDialog;
@@ -76,7 +79,9 @@ namespace djv
             p.closed = ValueSubject<std::shared_ptr<Media> >::create();
             p.media = ListSubject<std::shared_ptr<Media> >::create();
             p.currentMedia = ValueSubject<std::shared_ptr<Media> >::create();
+            p.frameCache = context->getSystemT<AV::IO::System>()->getFrameCache();
             p.cachePercentage = ValueSubject<float>::create();
+            p.cacheStats = ValueSubject<AV::IO::FrameCacheStats>::create();
 
             p.actions["Open"] = UI::Action::create();
             p.actions["Open"]->setIcon("djvIconFileOpen");
@@ -377,12 +382,16 @@ namespace djv
 
             auto settingsSystem = context->getSystemT<UI::Settings::System>();
             auto ioSettings = settingsSystem->getSettingsT<UI::Settings::IO>();
+            auto ioThreadPool = context->getSystemT<AV::IO::System>()->getThreadPool();
             p.threadCountObserver = ValueObserver<size_t>::create(
                 ioSettings->observeThreadCount(),
-                [weak](size_t value)
+                [weak, ioThreadPool](size_t value)
                 {
                     if (auto system = weak.lock())
                     {
+                        // The thread count also caps the number of I/O jobs
+                        // that run at the same time across all of the media.
+                        ioThreadPool->setMaxActive(value);
                         system->_p->threadCount = value;
                         const auto& media = system->_p->media->get();
                         for (const auto& i : media)
@@ -400,20 +409,9 @@ namespace djv
                 {
                     if (auto system = weak.lock())
                     {
-                        size_t cacheMaxByteCount  = 0;
-                        size_t cacheByteCount = 0;
-                        for (const auto& i : system->_p->media->get())
-                        {
-                            if (i->hasCache())
-                            {
-                                cacheMaxByteCount  += i->getCacheMaxByteCount();
-                                cacheByteCount += i->getCacheByteCount();
-                            }
-                        }
-                        const float percentage = cacheMaxByteCount ?
-                            (cacheByteCount / static_cast<float>(cacheMaxByteCount) * 100.F) :
-                            0.F;
-                        system->_p->cachePercentage->setIfChanged(percentage);
+                        const auto stats = system->_p->frameCache->getStats();
+                        system->_p->cachePercentage->setIfChanged(stats.getPercentageUsed());
+                        system->_p->cacheStats->setIfChanged(stats);
                     }
                 });
         }
@@ -474,6 +472,11 @@ namespace djv
             return _p->cachePercentage;
         }
 
+        std::shared_ptr<IValueSubject<AV::IO::FrameCacheStats> > FileSystem::observeCacheStats() const
+        {
+            return _p->cacheStats;
+        }
+
         void FileSystem::open()
         {
             _showFileBrowserDialog();
@@ -656,22 +659,16 @@ namespace djv
         void FileSystem::_cacheUpdate()
         {
             DJV_PRIVATE_PTR();
-            size_t cacheCount = 0;
-            const auto& media = p.media->get();
-            for (const auto& i : media)
-            {
-                if (i->hasCache())
-                {
-                    ++cacheCount;
-                }
-            }
+            // The byte budget is shared by all of the media through the I/O
+            // frame cache, which decides which frames to keep based on the
+            // playhead of each media.
             const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
             const size_t cacheMaxByteCount = p.settings->observeCacheMaxGB()->get() * Memory::gigabyte;
-            const size_t mediaCacheSizeByteCount = cacheCount > 0 ? (cacheMaxByteCount / cacheCount) : 0;
-            for (const auto& i : media)
+            p.frameCache->setMaxByteCount(cacheEnabled ? cacheMaxByteCount : 0);
+            for (const auto& i : p.media->get())
             {
                 i->setCacheEnabled(cacheEnabled);
-                i->setCacheMaxByteCount(mediaCacheSizeByteCount);
+                i->setCacheMaxByteCount(cacheMaxByteCount);
             }
         }
 
@@ -6,6 +6,8 @@
 
 #include <djvViewApp/IViewSystem.h>
 
+#include <djvAV/FrameCache.h>
+
 #include <djvCore/ListObserver.h>
 #include <djvCore/ValueObserver.h>
 
@@ -57,6 +59,7 @@ namespace djv
             std::shared_ptr<Core::IListSubject<std::shared_ptr<Media> > > observeMedia() const;
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<Media> > > observeCurrentMedia() const;
             std::shared_ptr<Core::IValueSubject<float> > observeCachePercentage() const;
+            std::shared_ptr<Core::IValueSubject<AV::IO::FrameCacheStats> > observeCacheStats() const;
 
             void open();
             void open(const Core::FileSystem::FileInfo&, const OpenOptions& = OpenOptions());
@@ -4,21 +4,389 @@
 
 #include <djvViewApp/HistogramWidget.h>
 
+#include <djvViewApp/ImageView.h>
+#include <djvViewApp/MediaWidget.h>
+#include <djvViewApp/WindowSystem.h>
+
+#include <djvUI/ComboBox.h>
+#include <djvUI/Label.h>
+#include <djvUI/RowLayout.h>
+#include <djvUI/Style.h>
+
+#include <djvAV/IO.h>
+#include <djvAV/Image.h>
+#include <djvAV/ImageScopes.h>
+#include <djvAV/Render2D.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/ThreadPool.h>
+#include <djvCore/Timer.h>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_transform_2d.hpp>
+
+#include <cmath>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace ViewApp
     {
+        namespace
+        {
+            //! This enumeration provides the scopes.
+            enum class Scope
+            {
+                Histogram,
+                Waveform,
+                Vectorscope
+            };
+
+            //! This struct provides the scopes with the images that are used to
+            //! draw them.
+            struct ScopesData
+            {
+                std::shared_ptr<AV::Image::Scopes> scopes;
+                std::shared_ptr<AV::Image::Image> waveform;
+                std::shared_ptr<AV::Image::Image> vectorscope;
+            };
+
+            //! Create an image from the counts of a scope, with the rows
+            //! flipped so that the first row of counts is at the bottom. The
+            //! intensity is logarithmic so that sparse values are visible.
+            std::shared_ptr<AV::Image::Image> createImage(
+                const std::vector<uint32_t>& counts,
+                size_t size,
+                uint32_t max,
+                bool transpose)
+            {
+                auto out = AV::Image::Image::create(AV::Image::Info(
+                    static_cast<uint16_t>(size),
+                    static_cast<uint16_t>(size),
+                    AV::Image::Type::L_U8));
+                const float scale = max > 0 ? (255.F / std::log(1.F + max)) : 0.F;
+                for (size_t y = 0; y < size; ++y)
+                {
+                    const size_t row = size - 1 - y;
+                    uint8_t* p = out->getData(static_cast<uint16_t>(y));
+                    for (size_t x = 0; x < size; ++x)
+                    {
+                        const uint32_t count = transpose ? counts[x * size + row] : counts[row * size + x];
+                        p[x] = static_cast<uint8_t>(std::log(1.F + count) * scale);
+                    }
+                }
+                return out;
+            }
+
+            AV::Image::Color getChannelColor(size_t channelCount, size_t channel)
+            {
+                const float a = .5F;
+                AV::Image::Color out(1.F, 1.F, 1.F, a);
+                switch (channelCount)
+                {
+                case 2:
+                    if (1 == channel)
+                    {
+                        out = AV::Image::Color(.5F, .5F, .5F, a);
+                    }
+                    break;
+                case 3:
+                case 4:
+                    switch (channel)
+                    {
+                    case 0: out = AV::Image::Color(1.F, 0.F, 0.F, a); break;
+                    case 1: out = AV::Image::Color(0.F, 1.F, 0.F, a); break;
+                    case 2: out = AV::Image::Color(0.F, 0.F, 1.F, a); break;
+                    case 3: out = AV::Image::Color(.5F, .5F, .5F, a); break;
+                    default: break;
+                    }
+                    break;
+                default: break;
+                }
+                return out;
+            }
+
+            class ScopeWidget : public UI::Widget
+            {
+                DJV_NON_COPYABLE(ScopeWidget);
+
+            protected:
+                void _init(Scope, const std::shared_ptr<Context>&);
+                ScopeWidget();
+
+            public:
+                static std::shared_ptr<ScopeWidget> create(Scope, const std::shared_ptr<Context>&);
+
+                void setData(const ScopesData&);
+
+            protected:
+                void _preLayoutEvent(Event::PreLayout&) override;
+                void _paintEvent(Event::Paint&) override;
+
+            private:
+                Scope _scope = Scope::Histogram;
+                ScopesData _data;
+            };
+
+            void ScopeWidget::_init(Scope scope, const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::ViewApp::ScopeWidget");
+                _scope = scope;
+            }
+
+            ScopeWidget::ScopeWidget()
+            {}
+
+            std::shared_ptr<ScopeWidget> ScopeWidget::create(Scope scope, const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<ScopeWidget>(new ScopeWidget);
+                out->_init(scope, context);
+                return out;
+            }
+
+            void ScopeWidget::setData(const ScopesData& value)
+            {
+                _data = value;
+                _redraw();
+            }
+
+            void ScopeWidget::_preLayoutEvent(Event::PreLayout&)
+            {
+                const auto& style = _getStyle();
+                const float tc = style->getMetric(UI::MetricsRole::TextColumn);
+                _setMinimumSize(glm::vec2(tc, tc / 2.F) + getMargin().getSize(style));
+            }
+
+            void ScopeWidget::_paintEvent(Event::Paint& event)
+            {
+                Widget::_paintEvent(event);
+                const auto& style = _getStyle();
+                const BBox2f& g = getMargin().bbox(getGeometry(), style);
+                BBox2f area = g;
+                if (Scope::Vectorscope == _scope)
+                {
+                    const float size = std::min(g.w(), g.h());
+                    const glm::vec2 c = g.getCenter();
+                    area = BBox2f(c.x - size / 2.F, c.y - size / 2.F, size, size);
+                }
+                auto render = _getRender();
+                render->setFillColor(style->getColor(UI::ColorRole::Trough));
+                render->drawRect(area);
+                if (!_data.scopes)
+                    return;
+
+                switch (_scope)
+                {
+                case Scope::Histogram:
+                {
+                    const auto& scopes = *_data.scopes;
+                    const size_t bins = scopes.options.histogramBins;
+                    const float max = static_cast<float>(scopes.histogramMax);
+                    if (max > 0.F)
+                    {
+                        const float binWidth = area.w() / bins;
+                        for (size_t c = 0; c < scopes.histogramChannelCount; ++c)
+                        {
+                            std::vector<BBox2f> rects;
+                            rects.reserve(bins);
+                            for (size_t i = 0; i < bins; ++i)
+                            {
+                                const float h = scopes.histogram[c * bins + i] / max * area.h();
+                                if (h > 0.F)
+                                {
+                                    rects.push_back(BBox2f(area.min.x + i * binWidth, area.max.y - h, binWidth, h));
+                                }
+                            }
+                            render->setFillColor(getChannelColor(scopes.histogramChannelCount, c));
+                            render->drawRects(rects);
+                        }
+                    }
+                    break;
+                }
+                case Scope::Waveform:
+                case Scope::Vectorscope:
+                {
+                    const auto& image = Scope::Waveform == _scope ? _data.waveform : _data.vectorscope;
+                    if (image)
+                    {
+                        if (Scope::Vectorscope == _scope)
+                        {
+                            // Draw the axes through the neutral point.
+                            const float b = style->getMetric(UI::MetricsRole::Border);
+                            const glm::vec2 c = area.getCenter();
+                            render->setFillColor(style->getColor(UI::ColorRole::Border));
+                            render->drawRect(BBox2f(area.min.x, floorf(c.y - b / 2.F), area.w(), b));
+                            render->drawRect(BBox2f(floorf(c.x - b / 2.F), area.min.y, b, area.h()));
+                        }
+                        glm::mat3x3 m(1.F);
+                        m = glm::translate(m, area.min);
+                        m = glm::scale(m, glm::vec2(
+                            area.w() / static_cast<float>(image->getWidth()),
+                            area.h() / static_cast<float>(image->getHeight())));
+                        render->pushTransform(m);
+                        render->setFillColor(style->getColor(UI::ColorRole::Checked));
+                        AV::Render2D::ImageOptions options;
+                        options.cache = AV::Render2D::ImageCache::Dynamic;
+                        render->drawFilledImage(image, glm::vec2(0.F, 0.F), options);
+                        render->popTransform();
+                    }
+                    break;
+                }
+                default: break;
+                }
+            }
+
+        } // namespace
+
         struct HistogramWidget::Private
         {
+            AV::Image::HistogramScale histogramScale = AV::Image::HistogramScale::Linear;
+            std::shared_ptr<AV::Image::Image> image;
+            bool pending = false;
+            bool refine = false;
+            ScopesData data;
+            std::shared_ptr<ThreadPool> threadPool;
+            std::future<ScopesData> future;
+
+            std::map<Scope, std::shared_ptr<UI::Label> > labels;
+            std::map<Scope, std::shared_ptr<ScopeWidget> > scopeWidgets;
+            std::shared_ptr<UI::ComboBox> histogramScaleComboBox;
+            std::shared_ptr<UI::Label> samplesLabel;
+            std::shared_ptr<UI::VerticalLayout> layout;
 
+            std::shared_ptr<Time::Timer> timer;
+
+            std::shared_ptr<ValueObserver<std::shared_ptr<MediaWidget> > > activeWidgetObserver;
+            std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > imageObserver;
         };
 
         void HistogramWidget::_init(const std::shared_ptr<Core::Context>& context)
         {
             MDIWidget::_init(context);
+
+            DJV_PRIVATE_PTR();
             setClassName("djv::ViewApp::HistogramWidget");
+
+            p.threadPool = context->getSystemT<AV::IO::System>()->getThreadPool();
+
+            for (const auto i : { Scope::Histogram, Scope::Waveform, Scope::Vectorscope })
+            {
+                p.labels[i] = UI::Label::create(context);
+                p.labels[i]->setTextHAlign(UI::TextHAlign::Left);
+                p.labels[i]->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+                p.scopeWidgets[i] = ScopeWidget::create(i, context);
+                p.scopeWidgets[i]->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            }
+
+            p.histogramScaleComboBox = UI::ComboBox::create(context);
+
+            p.samplesLabel = UI::Label::create(context);
+            p.samplesLabel->setFont(AV::Font::familyMono);
+            p.samplesLabel->setTextHAlign(UI::TextHAlign::Right);
+            p.samplesLabel->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+
+            p.layout = UI::VerticalLayout::create(context);
+            p.layout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::None));
+            p.layout->setBackgroundRole(UI::ColorRole::Background);
+            p.layout->setShadowOverlay({ UI::Side::Top });
+            for (const auto i : { Scope::Histogram, Scope::Waveform, Scope::Vectorscope })
+            {
+                p.layout->addChild(p.labels[i]);
+                p.layout->addChild(p.scopeWidgets[i]);
+                p.layout->setStretch(p.scopeWidgets[i], UI::RowStretch::Expand);
+            }
+            auto hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::None));
+            hLayout->addChild(p.histogramScaleComboBox);
+            hLayout->addChild(p.samplesLabel);
+            hLayout->setStretch(p.samplesLabel, UI::RowStretch::Expand);
+            p.layout->addChild(hLayout);
+            addChild(p.layout);
+
+            auto weak = std::weak_ptr<HistogramWidget>(std::dynamic_pointer_cast<HistogramWidget>(shared_from_this()));
+            p.histogramScaleComboBox->setCallback(
+                [weak](int value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->histogramScale = static_cast<AV::Image::HistogramScale>(value);
+                        widget->_p->refine = false;
+                        widget->_scopesUpdate();
+                    }
+                });
+
+            if (auto windowSystem = context->getSystemT<WindowSystem>())
+            {
+                p.activeWidgetObserver = ValueObserver<std::shared_ptr<MediaWidget> >::create(
+                    windowSystem->observeActiveWidget(),
+                    [weak](const std::shared_ptr<MediaWidget>& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            if (value)
+                            {
+                                widget->_p->imageObserver = ValueObserver<std::shared_ptr<AV::Image::Image> >::create(
+                                    value->getImageView()->observeImage(),
+                                    [weak](const std::shared_ptr<AV::Image::Image>& value)
+                                    {
+                                        if (auto widget = weak.lock())
+                                        {
+                                            widget->_p->image = value;
+                                            widget->_p->refine = false;
+                                            widget->_scopesUpdate();
+                                        }
+                                    });
+                            }
+                            else
+                            {
+                                widget->_p->imageObserver.reset();
+                                widget->_p->image.reset();
+                                widget->_p->refine = false;
+                                widget->_scopesUpdate();
+                            }
+                        }
+                    });
+            }
+
+            p.timer = Time::Timer::create(context);
+            p.timer->setRepeating(true);
+            p.timer->start(
+                Time::getTime(Time::TimerValue::Fast),
+                [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        auto& p = *widget->_p;
+                        if (p.future.valid() &&
+                            p.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        {
+                            try
+                            {
+                                p.data = p.future.get();
+                            }
+                            catch (const std::exception& e)
+                            {
+                                p.data = ScopesData();
+                                widget->_log(e.what(), LogLevel::Error);
+                            }
+                            widget->_widgetUpdate();
+
+                            if (p.pending)
+                            {
+                                widget->_scopesUpdate();
+                            }
+                            else if (!p.refine && p.data.scopes && p.data.scopes->sampleStride > 1)
+                            {
+                                // The image has not changed, compute the scopes
+                                // again with every pixel.
+                                p.refine = true;
+                                widget->_scopesUpdate();
+                            }
+                        }
+                    }
+                });
         }
 
         HistogramWidget::HistogramWidget() :
@@ -38,9 +406,89 @@ namespace djv
         void HistogramWidget::_initEvent(Event::Init & event)
         {
             MDIWidget::_initEvent(event);
+            DJV_PRIVATE_PTR();
             setTitle(_getText(DJV_TEXT("histogram")));
+            p.labels[Scope::Histogram]->setText(_getText(DJV_TEXT("widget_histogram_histogram")));
+            p.labels[Scope::Waveform]->setText(_getText(DJV_TEXT("widget_histogram_waveform")));
+            p.labels[Scope::Vectorscope]->setText(_getText(DJV_TEXT("widget_histogram_vectorscope")));
+            p.histogramScaleComboBox->setTooltip(_getText(DJV_TEXT("widget_histogram_scale_tooltip")));
+            _widgetUpdate();
+        }
+
+        void HistogramWidget::_scopesUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.future.valid())
+            {
+                // Only compute the latest image once the current scopes have
+                // finished.
+                p.pending = true;
+                return;
+            }
+            p.pending = false;
+            if (!p.image || !p.image->isValid())
+            {
+                p.data = ScopesData();
+                _widgetUpdate();
+                return;
+            }
+            AV::Image::ScopesOptions options;
+            options.histogramScale = p.histogramScale;
+            if (p.refine)
+            {
+                options.sampleMax = 0;
+            }
+            auto image = p.image;
+            auto threadPool = p.threadPool;
+            p.future = p.threadPool->push(
+                [image, options, threadPool]
+                {
+                    ScopesData out;
+                    out.scopes = AV::Image::computeScopes(*image, options, threadPool, ThreadPool::Priority::Low);
+                    out.waveform = createImage(
+                        out.scopes->waveform,
+                        out.scopes->options.waveformSize,
+                        out.scopes->waveformMax,
+                        true);
+                    out.vectorscope = createImage(
+                        out.scopes->vectorscope,
+                        out.scopes->options.vectorscopeSize,
+                        out.scopes->vectorscopeMax,
+                        false);
+                    return out;
+                },
+                ThreadPool::Priority::Low);
+        }
+
+        void HistogramWidget::_widgetUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            for (const auto& i : p.scopeWidgets)
+            {
+                i.second->setData(p.data);
+            }
+
+            p.histogramScaleComboBox->clearItems();
+            for (const auto i : AV::Image::getHistogramScaleEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                p.histogramScaleComboBox->addItem(_getText(ss.str()));
+            }
+            p.histogramScaleComboBox->setCurrentItem(static_cast<int>(p.histogramScale));
+            p.histogramScaleComboBox->setEnabled(p.image && AV::Image::isFloatType(p.image->getType()));
+
+            std::stringstream ss;
+            if (p.data.scopes)
+            {
+                ss << _getText(DJV_TEXT("widget_histogram_samples")) << ": " << p.data.scopes->sampleCount;
+                if (p.data.scopes->sampleStride > 1)
+                {
+                    ss << " (1/" << p.data.scopes->sampleStride << ")";
+                }
+            }
+            p.samplesLabel->setText(ss.str());
         }
 
     } // namespace ViewApp
 } // namespace djv
-
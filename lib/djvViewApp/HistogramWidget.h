@@ -11,6 +11,12 @@ namespace djv
     namespace ViewApp
     {
         //! This class provides the histogram widget.
+        //!
+        //! The histogram, waveform, and vectorscope of the displayed image are
+        //! computed with the thread pool of the I/O system. While the image is
+        //! changing, for example during playback, the scopes are computed with
+        //! a decimated image and only the latest image is computed. When the
+        //! image stops changing the scopes are refined with every pixel.
         class HistogramWidget : public MDIWidget
         {
             DJV_NON_COPYABLE(HistogramWidget);
@@ -28,6 +34,9 @@ namespace djv
             void _initEvent(Core::Event::Init &) override;
 
         private:
+            void _scopesUpdate();
+            void _widgetUpdate();
+
             DJV_PRIVATE();
         };
 
@@ -53,6 +53,7 @@ namespace djv
         struct ImageView::Private
         {
             std::shared_ptr<ValueSubject<std::shared_ptr<AV::Image::Image> > > image;
+            std::vector<std::shared_ptr<AV::Image::Image> > stagedImages;
             std::shared_ptr<ValueSubject<AV::Render2D::ImageOptions> > imageOptions;
             AV::OCIO::Config ocioConfig;
             std::string outputColorSpace;
@@ -60,6 +61,7 @@ namespace djv
             std::shared_ptr<ValueSubject<float> > imageZoom;
             std::shared_ptr<ValueSubject<UI::ImageRotate> > imageRotate;
             std::shared_ptr<ValueSubject<UI::ImageAspectRatio> > imageAspectRatio;
+            std::shared_ptr<ValueSubject<BBox2i> > visibleImageBBox;
             ImageViewLock lock = ImageViewLock::None;
             BBox2f lockFrame = BBox2f(0.F, 0.F, 0.F, 0.F);
             std::shared_ptr<ValueSubject<GridOptions> > gridOptions;
@@ -92,6 +94,7 @@ namespace djv
             p.imageZoom = ValueSubject<float>::create(1.F);
             p.imageRotate = ValueSubject<UI::ImageRotate>::create(imageSettings->observeRotate()->get());
             p.imageAspectRatio = ValueSubject<UI::ImageAspectRatio>::create(imageSettings->observeAspectRatio()->get());
+            p.visibleImageBBox = ValueSubject<BBox2i>::create();
             p.gridOptions = ValueSubject<GridOptions>::create(viewSettings->observeGridOptions()->get());
             p.backgroundColor = ValueSubject<AV::Image::Color>::create(viewSettings->observeBackgroundColor()->get());
 
@@ -176,6 +179,11 @@ namespace djv
             }
         }
 
+        void ImageView::setStagedImages(const std::vector<std::shared_ptr<AV::Image::Image> >& value)
+        {
+            _p->stagedImages = value;
+        }
+
         std::shared_ptr<IValueSubject<AV::Render2D::ImageOptions> > ImageView::observeImageOptions() const
         {
             return _p->imageOptions;
@@ -218,6 +226,11 @@ namespace djv
             return _getBBox(_getImagePoints());
         }
 
+        std::shared_ptr<IValueSubject<BBox2i> > ImageView::observeVisibleImageBBox() const
+        {
+            return _p->visibleImageBBox;
+        }
+
         void ImageView::setImagePos(const glm::vec2& value, bool animate)
         {
             DJV_PRIVATE_PTR();
@@ -415,6 +428,7 @@ namespace djv
             p.gridOverlay->setGeometry(getGeometry());
             p.gridOverlay->setImageBBox(getImageBBox());
             p.gridOverlay->setImageFrame(p.lockFrame);
+            _visibleImageBBoxUpdate();
         }
 
         void ImageView::_paintEvent(Event::Paint &)
@@ -428,6 +442,7 @@ namespace djv
             render->drawRect(g);
 
             const float zoom = p.imageZoom->get();
+            render->stageImages(p.stagedImages);
             if (auto image = p.image->get())
             {
                 glm::mat3x3 m(1.F);
@@ -577,6 +592,46 @@ namespace djv
             p.gridOverlay->setImagePosAndZoom(p.imagePos->get(), p.imageZoom->get());
             p.gridOverlay->setImageBBox(getImageBBox());
             p.gridOverlay->setImageFrame(p.lockFrame);
+            _visibleImageBBoxUpdate();
+        }
+
+        void ImageView::_visibleImageBBoxUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            BBox2i bbox;
+            if (auto image = p.image->get())
+            {
+                // Map the view geometry back into the image, the transform
+                // maps proxy images to full resolution so scale them back up.
+                const auto& style = _getStyle();
+                const BBox2f& g = getMargin().bbox(getGeometry(), style);
+                const float zoom = p.imageZoom->get();
+                glm::mat3x3 m(1.F);
+                m = glm::translate(m, g.min + p.imagePos->get());
+                m *= UI::ImageWidget::getXForm(image, p.imageRotate->get(), glm::vec2(zoom, zoom), p.imageAspectRatio->get());
+                const glm::mat3x3 mi = glm::inverse(m);
+                std::vector<glm::vec3> pts;
+                pts.push_back(mi * glm::vec3(g.min.x, g.min.y, 1.F));
+                pts.push_back(mi * glm::vec3(g.max.x, g.min.y, 1.F));
+                pts.push_back(mi * glm::vec3(g.max.x, g.max.y, 1.F));
+                pts.push_back(mi * glm::vec3(g.min.x, g.max.y, 1.F));
+                const BBox2f b = _getBBox(pts);
+                const int proxyScale = 1 << image->getProxy();
+                const AV::Image::Size& size = image->getSize();
+                bbox = BBox2i(
+                    glm::ivec2(
+                        static_cast<int>(floorf(b.min.x)) * proxyScale,
+                        static_cast<int>(floorf(b.min.y)) * proxyScale),
+                    glm::ivec2(
+                        static_cast<int>(ceilf(b.max.x)) * proxyScale - 1,
+                        static_cast<int>(ceilf(b.max.y)) * proxyScale - 1)).
+                    intersect(BBox2i(0, 0, size.w * proxyScale, size.h * proxyScale));
+                if (bbox.min.x > bbox.max.x || bbox.min.y > bbox.max.y)
+                {
+                    bbox = BBox2i();
+                }
+            }
+            p.visibleImageBBox->setIfChanged(bbox);
         }
 
     } // namespace ViewApp
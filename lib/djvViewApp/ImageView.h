@@ -67,6 +67,10 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > observeImage() const;
             void setImage(const std::shared_ptr<AV::Image::Image>&);
 
+            //! Set the images to upload ahead of time, these are the next
+            //! images that will be shown.
+            void setStagedImages(const std::vector<std::shared_ptr<AV::Image::Image> >&);
+
             std::shared_ptr<Core::IValueSubject<AV::Render2D::ImageOptions> > observeImageOptions() const;
             void setImageOptions(const AV::Render2D::ImageOptions&);
 
@@ -75,6 +79,11 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<UI::ImageRotate> > observeImageRotate() const;
             std::shared_ptr<Core::IValueSubject<UI::ImageAspectRatio> > observeImageAspectRatio() const;
             Core::BBox2f getImageBBox() const;
+
+            //! Observe the area of the image that is visible in the view, in
+            //! full resolution pixels.
+            std::shared_ptr<Core::IValueSubject<Core::BBox2i> > observeVisibleImageBBox() const;
+
             void setImagePos(const glm::vec2&, bool animate = false);
             void setImageZoom(float, bool animate = false);
             void setImageZoomFocus(float, const glm::vec2&, bool animate = false);
@@ -108,6 +117,7 @@ namespace djv
 
             void _animatePosAndZoom(const glm::vec2&, float);
             void _setPosAndZoom(const glm::vec2&, float);
+            void _visibleImageBBoxUpdate();
 
             DJV_PRIVATE();
         };
@@ -15,6 +15,8 @@
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
 
+#include <atomic>
+
 using namespace djv::Core;
 
 namespace djv
@@ -25,7 +27,9 @@ namespace djv
         {
             //! \todo Should this be configurable?
             const size_t audioBufferFrameCount = 256;
+            const size_t audioRingBufferSeconds = 1;
             const size_t videoQueueSize        = 10;
+            const size_t stagedImageCount      = 4;
             const size_t realSpeedFrameCount   = 30;
             
         } // namespace
@@ -40,6 +44,11 @@ namespace djv
             AV::IO::AudioInfo audioInfo;
             std::shared_ptr<ValueSubject<bool> > reload;
             std::shared_ptr<ValueSubject<size_t> > layer;
+            //! The layers that have been viewed are decoded together with the
+            //! current layer, so switching back to them is a cache hit.
+            std::set<size_t> cacheLayers;
+            std::shared_ptr<ValueSubject<size_t> > proxy;
+            std::shared_ptr<ValueSubject<BBox2i> > roi;
             std::shared_ptr<ValueSubject<Time::Speed> > speed;
             std::shared_ptr<ValueSubject<PlaybackSpeed> > playbackSpeed;
             std::shared_ptr<ValueSubject<Time::Speed> > defaultSpeed;
@@ -50,6 +59,7 @@ namespace djv
             std::shared_ptr<ValueSubject<Frame::Sequence> > sequence;
             std::shared_ptr<ValueSubject<Frame::Index> > currentFrame;
             std::shared_ptr<ValueSubject<std::shared_ptr<AV::Image::Image> > > currentImage;
+            std::shared_ptr<ListSubject<std::shared_ptr<AV::Image::Image> > > stagedImages;
             std::shared_ptr<ValueSubject<Playback> > playback;
             std::shared_ptr<ValueSubject<PlaybackMode> > playbackMode;
             std::shared_ptr<ValueSubject<AV::IO::InOutPoints> > inOutPoints;
@@ -67,13 +77,22 @@ namespace djv
             std::shared_ptr<ValueSubject<size_t> > videoQueueCount;
             std::shared_ptr<ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<ValueSubject<size_t> > audioQueueCount;
+            std::shared_ptr<ValueSubject<size_t> > audioBufferMax;
+            std::shared_ptr<ValueSubject<size_t> > audioBufferCount;
+            std::shared_ptr<ValueSubject<size_t> > audioUnderrunCount;
+            std::shared_ptr<ValueSubject<size_t> > audioDeviceUnderrunCount;
             std::shared_ptr<AV::IO::IRead> read;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
             std::unique_ptr<RtAudio> rtAudio;
+            std::shared_ptr<AV::Audio::RingBuffer> audioBuffer;
             std::shared_ptr<AV::Audio::Data> audioData;
             size_t audioDataSamplesOffset = 0;
-            size_t audioDataSamplesCount = 0;
+            std::atomic<size_t> audioDataSamplesCount;
+            std::atomic<bool> audioFinished;
+            std::atomic<float> audioVolume;
+            std::atomic<size_t> audioUnderruns;
+            std::atomic<size_t> audioDeviceUnderruns;
             Frame::Index frameOffset = 0;
             Time::Duration currentTime = Time::Duration::zero();
             std::chrono::steady_clock::time_point playbackTime;
@@ -98,6 +117,8 @@ namespace djv
             p.info = ValueSubject<AV::IO::Info>::create();
             p.reload = ValueSubject<bool>::create(false);
             p.layer = ValueSubject<size_t>::create(0);
+            p.proxy = ValueSubject<size_t>::create(0);
+            p.roi = ValueSubject<BBox2i>::create();
             p.speed = ValueSubject<Time::Speed>::create();
             p.playbackSpeed = ValueSubject<PlaybackSpeed>::create();
             p.defaultSpeed = ValueSubject<Time::Speed>::create();
@@ -107,6 +128,7 @@ namespace djv
             p.sequence = ValueSubject<Frame::Sequence>::create();
             p.currentFrame = ValueSubject<Frame::Index>::create(Frame::invalid);
             p.currentImage = ValueSubject<std::shared_ptr<AV::Image::Image> >::create();
+            p.stagedImages = ListSubject<std::shared_ptr<AV::Image::Image> >::create();
             p.playback = ValueSubject<Playback>::create(Playback::First);
             p.playbackMode = ValueSubject<PlaybackMode>::create(PlaybackMode::First);
             p.inOutPoints = ValueSubject<AV::IO::InOutPoints>::create();
@@ -122,6 +144,16 @@ namespace djv
             p.audioQueueMax = ValueSubject<size_t>::create();
             p.videoQueueCount = ValueSubject<size_t>::create();
             p.audioQueueCount = ValueSubject<size_t>::create();
+            p.audioBufferMax = ValueSubject<size_t>::create();
+            p.audioBufferCount = ValueSubject<size_t>::create();
+            p.audioUnderrunCount = ValueSubject<size_t>::create();
+            p.audioDeviceUnderrunCount = ValueSubject<size_t>::create();
+
+            p.audioDataSamplesCount = 0;
+            p.audioFinished = false;
+            p.audioVolume = 1.F;
+            p.audioUnderruns = 0;
+            p.audioDeviceUnderruns = 0;
 
             p.playbackTimer = Time::Timer::create(context);
             p.playbackTimer->setRepeating(true);
@@ -210,8 +242,11 @@ namespace djv
 
         void Media::setLayer(size_t value)
         {
-            if (_p->layer->setIfChanged(value))
+            DJV_PRIVATE_PTR();
+            const size_t prev = p.layer->get();
+            if (p.layer->setIfChanged(value))
             {
+                p.cacheLayers.insert(prev);
                 _open();
             }
         }
@@ -246,11 +281,55 @@ namespace djv
             setLayer(layer);
         }
 
+        std::shared_ptr<IValueSubject<size_t> > Media::observeProxy() const
+        {
+            return _p->proxy;
+        }
+
+        void Media::setProxy(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            const size_t prev = p.proxy->get();
+            if (p.proxy->setIfChanged(std::min(value, AV::IO::proxyMax)) &&
+                p.read && p.read->getProxy(prev) != p.read->getProxy(p.proxy->get()))
+            {
+                _open();
+            }
+        }
+
+        std::shared_ptr<IValueSubject<BBox2i> > Media::observeROI() const
+        {
+            return _p->roi;
+        }
+
+        void Media::setROI(const BBox2i& value)
+        {
+            DJV_PRIVATE_PTR();
+            // A region of interest that covers the whole image is the same as
+            // no region of interest.
+            BBox2i roi = value;
+            const auto& size = p.videoInfo.info.size;
+            if (roi.isValid() && size.isValid() && roi.contains(BBox2i(0, 0, size.w, size.h)))
+            {
+                roi = BBox2i();
+            }
+            if (p.roi->setIfChanged(roi) &&
+                p.read && p.read->hasROI())
+            {
+                _open();
+            }
+        }
+
         std::shared_ptr<IValueSubject<std::shared_ptr<AV::Image::Image> > > Media::observeCurrentImage() const
         {
             return _p->currentImage;
         }
 
+        std::shared_ptr<IListSubject<std::shared_ptr<AV::Image::Image> > > Media::observeStagedImages() const
+        {
+            return _p->stagedImages;
+        }
+
         std::shared_ptr<IValueSubject<Time::Speed> > Media::observeSpeed() const
         {
             return _p->speed;
@@ -578,12 +657,16 @@ namespace djv
 
         void Media::setVolume(float value)
         {
-            _p->volume->setIfChanged(Math::clamp(value, 0.F, 1.F));
+            DJV_PRIVATE_PTR();
+            p.volume->setIfChanged(Math::clamp(value, 0.F, 1.F));
+            p.audioVolume = !p.mute->get() ? p.volume->get() : 0.F;
         }
 
         void Media::setMute(bool value)
         {
-            _p->mute->setIfChanged(value);
+            DJV_PRIVATE_PTR();
+            p.mute->setIfChanged(value);
+            p.audioVolume = !p.mute->get() ? p.volume->get() : 0.F;
         }
 
         std::shared_ptr<IValueSubject<size_t> > Media::observeThreadCount() const
@@ -685,6 +768,26 @@ namespace djv
             return _p->audioQueueCount;
         }
 
+        std::shared_ptr<IValueSubject<size_t> > Media::observeAudioBufferMax() const
+        {
+            return _p->audioBufferMax;
+        }
+
+        std::shared_ptr<IValueSubject<size_t> > Media::observeAudioBufferCount() const
+        {
+            return _p->audioBufferCount;
+        }
+
+        std::shared_ptr<IValueSubject<size_t> > Media::observeAudioUnderrunCount() const
+        {
+            return _p->audioUnderrunCount;
+        }
+
+        std::shared_ptr<IValueSubject<size_t> > Media::observeAudioDeviceUnderrunCount() const
+        {
+            return _p->audioDeviceUnderrunCount;
+        }
+
         bool Media::_hasAudio() const
         {
             DJV_PRIVATE_PTR();
@@ -715,6 +818,9 @@ namespace djv
                 {
                     AV::IO::ReadOptions options;
                     options.layer = p.layer->get();
+                    options.proxy = p.proxy->get();
+                    options.roi = p.roi->get();
+                    options.cacheLayers = p.cacheLayers;
                     options.videoQueueSize = videoQueueSize;
                     auto io = context->getSystemT<AV::IO::System>();
                     p.read = io->read(p.fileInfo, options);
@@ -768,6 +874,11 @@ namespace djv
                         {
                             p.rtAudio->closeStream();
                         }
+                        p.audioBuffer = AV::Audio::RingBuffer::create(AV::Audio::Info(
+                            p.audioInfo.info.channelCount,
+                            p.audioInfo.info.type,
+                            p.audioInfo.info.sampleRate,
+                            p.audioInfo.info.sampleRate * audioRingBufferSeconds));
                         RtAudio::StreamParameters rtParameters;
                         auto audioSystem = context->getSystemT<AV::Audio::System>();
                         rtParameters.deviceId = audioSystem->getDefaultOutputDevice();
@@ -825,31 +936,19 @@ namespace djv
                             {
                                 if (media->_p->read)
                                 {
-                                    bool valid = false;
-                                    size_t videoQueueMax   = 0;
-                                    size_t videoQueueCount = 0;
-                                    size_t audioQueueMax   = 0;
-                                    size_t audioQueueCount = 0;
-                                    {
-                                        std::unique_lock<std::mutex> lock(media->_p->read->getMutex());
-                                        if (lock.owns_lock())
-                                        {
-                                            valid = true;
-                                            const auto& videoQueue = media->_p->read->getVideoQueue();
-                                            const auto& audioQueue = media->_p->read->getAudioQueue();
-                                            videoQueueMax   = videoQueue.getMax();
-                                            videoQueueCount = videoQueue.getCount();
-                                            audioQueueMax   = audioQueue.getMax();
-                                            audioQueueCount = audioQueue.getCount();
-                                        }
-                                    }
-                                    if (valid)
+                                    const auto& videoQueue = media->_p->read->getVideoQueue();
+                                    const auto& audioQueue = media->_p->read->getAudioQueue();
+                                    media->_p->videoQueueMax->setAlways(videoQueue.getMax());
+                                    media->_p->videoQueueCount->setAlways(videoQueue.getCount());
+                                    media->_p->audioQueueMax->setAlways(audioQueue.getMax());
+                                    media->_p->audioQueueCount->setAlways(audioQueue.getCount());
+                                    if (const auto& audioBuffer = media->_p->audioBuffer)
                                     {
-                                        media->_p->videoQueueMax->setAlways(videoQueueMax);
-                                        media->_p->videoQueueCount->setAlways(videoQueueCount);
-                                        media->_p->audioQueueMax->setAlways(audioQueueMax);
-                                        media->_p->audioQueueCount->setAlways(audioQueueCount);
+                                        media->_p->audioBufferMax->setAlways(audioBuffer->getCapacity());
+                                        media->_p->audioBufferCount->setAlways(audioBuffer->getReadCount());
                                     }
+                                    media->_p->audioUnderrunCount->setIfChanged(media->_p->audioUnderruns);
+                                    media->_p->audioDeviceUnderrunCount->setIfChanged(media->_p->audioDeviceUnderruns);
                                 }
                             }
                         });
@@ -964,6 +1063,13 @@ namespace djv
                 p.realSpeedFrameCount = 0;
                 p.playEveryFrameTime = Time::Duration::zero();
                 _stopAudioStream();
+
+                // The audio stream is stopped so the ring buffer can be reset.
+                if (p.audioBuffer)
+                {
+                    p.audioBuffer->reset();
+                }
+                p.audioFinished = false;
             }
         }
 
@@ -1146,7 +1252,7 @@ namespace djv
                 AV::IO::VideoFrame frame;
                 bool gotFrame = false;
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
+                    // The queue is lock-free so this does not wait on the reader.
                     auto& queue = p.read->getVideoQueue();
                     if (p.playEveryFrame->get())
                     {
@@ -1193,10 +1299,32 @@ namespace djv
                     }
                 }
 
+                // The frames left in the queue are the next frames in the
+                // playback direction.
+                std::vector<std::shared_ptr<AV::Image::Image> > stagedImages;
+                if (playback != Playback::Stop)
+                {
+                    const auto& queue = p.read->getVideoQueue();
+                    const auto& currentImage = p.currentImage->get();
+                    const size_t count = queue.getCount();
+                    for (size_t i = 0; i < count && stagedImages.size() < stagedImageCount; ++i)
+                    {
+                        const auto image = queue.getFrame(i).image;
+                        if (image && image != currentImage)
+                        {
+                            stagedImages.push_back(image);
+                        }
+                    }
+                }
+                p.stagedImages->setIfChanged(stagedImages);
+
                 // Update the audio queue.
-                if (_hasAudio() && !_hasAudioSyncPlayback())
+                if (_hasAudioSyncPlayback() && p.audioBuffer)
+                {
+                    _audioBufferUpdate();
+                }
+                else if (_hasAudio())
                 {
-                    std::lock_guard<std::mutex> lock(p.read->getMutex());
                     auto& queue = p.read->getAudioQueue();
                     while (queue.getCount() > queue.getMax())
                     {
@@ -1206,6 +1334,41 @@ namespace djv
             }
         }
         
+        void Media::_audioBufferUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            const auto& info = p.audioInfo.info;
+            const size_t sampleByteCount = info.channelCount * AV::Audio::getByteCount(info.type);
+            auto& queue = p.read->getAudioQueue();
+            while (p.audioBuffer->getWriteCount() > 0)
+            {
+                if (!p.audioData)
+                {
+                    if (queue.isEmpty())
+                    {
+                        break;
+                    }
+                    // The frame may be empty if the reader cleared the queue.
+                    auto frame = queue.popFrame();
+                    if (!frame.audio)
+                    {
+                        continue;
+                    }
+                    p.audioData = frame.audio;
+                    p.audioDataSamplesOffset = 0;
+                }
+                p.audioDataSamplesOffset += p.audioBuffer->write(
+                    p.audioData->getData() + p.audioDataSamplesOffset * sampleByteCount,
+                    p.audioData->getSampleCount() - p.audioDataSamplesOffset);
+                if (p.audioDataSamplesOffset >= p.audioData->getSampleCount())
+                {
+                    p.audioData.reset();
+                    p.audioDataSamplesOffset = 0;
+                }
+            }
+            p.audioFinished = !p.audioData && queue.isEmpty() && queue.isFinished();
+        }
+
         int Media::_rtAudioCallback(
             void* outputBuffer,
             void* inputBuffer,
@@ -1214,90 +1377,33 @@ namespace djv
             RtAudioStreamStatus status,
             void* userData)
         {
+            // This function runs on the audio thread, it must not allocate
+            // memory or wait on locks.
             Media* media = reinterpret_cast<Media*>(userData);
             const auto& info = media->_p->audioInfo;
-
-            size_t outputSampleCount = static_cast<size_t>(nFrames);
-            size_t sampleCount = 0;
             const size_t sampleByteCount = info.info.channelCount * AV::Audio::getByteCount(info.info.type);
-            const float volume = !media->_p->mute->get() ? media->_p->volume->get() : 0.F;
-
-            if (media->_p->audioData)
-            {
-                sampleCount += media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset;
-            }
 
-            // Get audio frames from the read queue.
-            std::vector<AV::IO::AudioFrame> frames;
+            if (status & RTAUDIO_OUTPUT_UNDERFLOW)
             {
-                std::lock_guard<std::mutex> lock(media->_p->read->getMutex());
-                auto& queue = media->_p->read->getAudioQueue();
-                while (!queue.isEmpty() && sampleCount < outputSampleCount)
-                {
-                    auto frame = queue.getFrame();
-                    frames.push_back(frame);
-                    queue.popFrame();
-                    sampleCount += frame.audio->getSampleCount();
-                }
+                ++media->_p->audioDeviceUnderruns;
             }
 
-            // Use the remaining data from the frame.
             uint8_t* p = reinterpret_cast<uint8_t*>(outputBuffer);
-            if (media->_p->audioData)
+            const size_t outputSampleCount = static_cast<size_t>(nFrames);
+            const size_t sampleCount = media->_p->audioBuffer->read(p, outputSampleCount, media->_p->audioVolume);
+            if (sampleCount < outputSampleCount)
             {
-                const size_t size = std::min(
-                    media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset,
-                    outputSampleCount);
-                //memcpy(
-                //    p,
-                //    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                //    size * sampleByteCount);
-                AV::Audio::Data::volume(
-                    media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
-                    p,
-                    volume,
-                    size,
-                    info.info.channelCount,
-                    info.info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset += size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
-                if (media->_p->audioDataSamplesOffset >= media->_p->audioData->getSampleCount())
+                //! \todo Is this the correct way to clear the audio data?
+                memset(p + sampleCount * sampleByteCount, 0, (outputSampleCount - sampleCount) * sampleByteCount);
+
+                // Don't count the start of playback before any samples have
+                // arrived, or the end of the stream.
+                if (media->_p->audioDataSamplesCount > 0 && !media->_p->audioFinished)
                 {
-                    media->_p->audioData.reset();
-                    media->_p->audioDataSamplesOffset = 0;
+                    ++media->_p->audioUnderruns;
                 }
             }
-
-            // Process the frames.
-            for (const auto& i : frames)
-            {
-                media->_p->audioData = i.audio;
-                size_t size = std::min(i.audio->getSampleCount(), outputSampleCount);
-                //memcpy(
-                //    p,
-                //    i.audio->getData(),
-                //    size * sampleByteCount);
-                AV::Audio::Data::volume(
-                    i.audio->getData(),
-                    p,
-                    volume,
-                    size,
-                    info.info.channelCount,
-                    info.info.type);
-                p += size * sampleByteCount;
-                media->_p->audioDataSamplesOffset = size;
-                media->_p->audioDataSamplesCount += size;
-                outputSampleCount -= size;
-            }
-
-            const size_t zero = (nFrames * sampleByteCount) - (p - reinterpret_cast<uint8_t*>(outputBuffer));
-            if (zero)
-            {
-                //! \todo Is this the correct way to clear the audio data?
-                memset(p, 0, zero);
-            }
+            media->_p->audioDataSamplesCount += sampleCount;
 
             return 0;
         }
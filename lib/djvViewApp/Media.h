@@ -72,11 +72,32 @@ namespace djv
 
             ///@}
 
+            //! \name Proxy and Region of Interest
+            ///@{
+
+            std::shared_ptr<Core::IValueSubject<size_t> > observeProxy() const;
+
+            //! Set the proxy level used to read the media. Each level halves
+            //! the resolution of the images.
+            void setProxy(size_t);
+
+            std::shared_ptr<Core::IValueSubject<Core::BBox2i> > observeROI() const;
+
+            //! Set the region of interest used to read the media, in full
+            //! resolution pixels. An invalid region reads the whole image.
+            void setROI(const Core::BBox2i&);
+
+            ///@}
+
             //! \name Image
             ///@{
 
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > observeCurrentImage() const;
 
+            //! Observe the next images in the playback direction, these can be
+            //! uploaded ahead of time before they become the current image.
+            std::shared_ptr<Core::IListSubject<std::shared_ptr<AV::Image::Image> > > observeStagedImages() const;
+
             ///@}
 
             //! \name Playback
@@ -166,6 +187,14 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<size_t> > observeAudioQueueMax() const;
             std::shared_ptr<Core::IValueSubject<size_t> > observeVideoQueueCount() const;
             std::shared_ptr<Core::IValueSubject<size_t> > observeAudioQueueCount() const;
+            std::shared_ptr<Core::IValueSubject<size_t> > observeAudioBufferMax() const;
+            std::shared_ptr<Core::IValueSubject<size_t> > observeAudioBufferCount() const;
+
+            //! Observe the number of times the audio callback ran out of samples.
+            std::shared_ptr<Core::IValueSubject<size_t> > observeAudioUnderrunCount() const;
+
+            //! Observe the number of underruns reported by the audio device.
+            std::shared_ptr<Core::IValueSubject<size_t> > observeAudioDeviceUnderrunCount() const;
 
             ///@}
 
@@ -182,6 +211,7 @@ namespace djv
             void _startAudioStream();
             void _stopAudioStream();
             void _queueUpdate();
+            void _audioBufferUpdate();
 
             static int _rtAudioCallback(
                 void* outputBuffer,
@@ -68,6 +68,41 @@ namespace djv
             return state == other.state && pos == other.pos;
         }
 
+        namespace
+        {
+            //! Get the proxy level for the given zoom. The resolution is halved
+            //! for as long as it stays at or above the screen resolution.
+            size_t getProxy(float zoom)
+            {
+                size_t out = 0;
+                while (out < AV::IO::proxyMax && zoom * static_cast<float>(1 << (out + 1)) <= 1.F)
+                {
+                    ++out;
+                }
+                return out;
+            }
+
+            const int roiGrid = 256;
+
+            //! Get the region of interest for the visible area of the image.
+            //! The region is only used when zoomed in, it is snapped to a grid
+            //! with a margin so that small changes to the view do not require
+            //! reading the image again.
+            BBox2i getROI(const BBox2i& visible, float zoom)
+            {
+                BBox2i out;
+                if (zoom > 1.F && visible.isValid())
+                {
+                    out.min.x = std::max((visible.min.x / roiGrid - 1) * roiGrid, 0);
+                    out.min.y = std::max((visible.min.y / roiGrid - 1) * roiGrid, 0);
+                    out.max.x = (visible.max.x / roiGrid + 2) * roiGrid - 1;
+                    out.max.y = (visible.max.y / roiGrid + 2) * roiGrid - 1;
+                }
+                return out;
+            }
+
+        } // namespace
+
         struct MediaWidget::Private
         {
             std::shared_ptr<ValueSubject<PointerData> > hover;
@@ -139,6 +174,7 @@ namespace djv
             std::shared_ptr<ValueObserver<bool> > currentFrameChangeObserver;
             std::shared_ptr<ValueObserver<Time::Units> > timeUnitsObserver;
             std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > imageObserver;
+            std::shared_ptr<ListObserver<std::shared_ptr<AV::Image::Image> > > stagedImagesObserver;
             std::shared_ptr<ValueObserver<Time::Speed> > speedObserver;
             std::shared_ptr<ValueObserver<PlaybackSpeed> > playbackSpeedObserver;
             std::shared_ptr<ValueObserver<Time::Speed> > defaultSpeedObserver;
@@ -165,6 +201,8 @@ namespace djv
             std::shared_ptr<ValueObserver<bool> > frameStoreEnabledObserver;
             std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > frameStoreObserver;
             std::shared_ptr<ValueObserver<AV::Render2D::ImageOptions> > imageOptionsObserver;
+            std::shared_ptr<ValueObserver<float> > imageZoomObserver;
+            std::shared_ptr<ValueObserver<BBox2i> > visibleImageBBoxObserver;
             std::shared_ptr<ValueObserver<UI::ImageRotate> > imageRotateObserver;
             std::shared_ptr<ValueObserver<UI::ImageAspectRatio> > imageAspectRatioObserver;
         };
@@ -819,6 +857,16 @@ namespace djv
                     }
                 });
 
+            p.stagedImagesObserver = ListObserver<std::shared_ptr<AV::Image::Image> >::create(
+                p.media->observeStagedImages(),
+                [weak](const std::vector<std::shared_ptr<AV::Image::Image> >& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->imageView->setStagedImages(value);
+                    }
+                });
+
             p.speedObserver = ValueObserver<Time::Speed>::create(
                 p.media->observeSpeed(),
                 [weak](const Time::Speed& value)
@@ -1117,6 +1165,27 @@ namespace djv
                     }
                 });
 
+            p.imageZoomObserver = ValueObserver<float>::create(
+                p.imageView->observeImageZoom(),
+                [weak](float value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->media->setProxy(getProxy(value));
+                    }
+                });
+
+            p.visibleImageBBoxObserver = ValueObserver<BBox2i>::create(
+                p.imageView->observeVisibleImageBBox(),
+                [weak](const BBox2i& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        const float zoom = widget->_p->imageView->observeImageZoom()->get();
+                        widget->_p->media->setROI(getROI(value, zoom));
+                    }
+                });
+
             p.imageRotateObserver = ValueObserver<UI::ImageRotate>::create(
                 p.imageView->observeImageRotate(),
                 [weak](UI::ImageRotate value)
@@ -25,6 +25,7 @@ namespace djv
         struct MemoryCacheWidget::Private
         {
             float percentageUsed = 0.F;
+            AV::IO::FrameCacheStats stats;
 
             std::shared_ptr<UI::Label> titleLabel;
             std::shared_ptr<UI::CheckBox> enabledCheckBox;
@@ -32,11 +33,18 @@ namespace djv
             std::shared_ptr<UI::Label> maxGBLabel;
             std::shared_ptr<UI::Label> percentageLabel;
             std::shared_ptr<UI::Label> percentageLabel2;
+            std::shared_ptr<UI::Label> hitsLabel;
+            std::shared_ptr<UI::Label> hitsLabel2;
+            std::shared_ptr<UI::Label> missesLabel;
+            std::shared_ptr<UI::Label> missesLabel2;
+            std::shared_ptr<UI::Label> evictionsLabel;
+            std::shared_ptr<UI::Label> evictionsLabel2;
             std::shared_ptr<UI::VerticalLayout> layout;
 
             std::shared_ptr<ValueObserver<bool> > enabledObserver;
             std::shared_ptr<ValueObserver<int> > maxGBObserver;
             std::shared_ptr<ValueObserver<float> > percentageObserver;
+            std::shared_ptr<ValueObserver<AV::IO::FrameCacheStats> > statsObserver;
         };
 
         void MemoryCacheWidget::_init(const std::shared_ptr<Core::Context>& context)
@@ -61,6 +69,18 @@ namespace djv
             p.percentageLabel->setTextHAlign(UI::TextHAlign::Left);
             p.percentageLabel2 = UI::Label::create(context);
             p.percentageLabel2->setFont(AV::Font::familyMono);
+            p.hitsLabel = UI::Label::create(context);
+            p.hitsLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.hitsLabel2 = UI::Label::create(context);
+            p.hitsLabel2->setFont(AV::Font::familyMono);
+            p.missesLabel = UI::Label::create(context);
+            p.missesLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.missesLabel2 = UI::Label::create(context);
+            p.missesLabel2->setFont(AV::Font::familyMono);
+            p.evictionsLabel = UI::Label::create(context);
+            p.evictionsLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.evictionsLabel2 = UI::Label::create(context);
+            p.evictionsLabel2->setFont(AV::Font::familyMono);
 
             p.layout = UI::VerticalLayout::create(context);
             p.layout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::None));
@@ -82,6 +102,16 @@ namespace djv
             hLayout->addChild(p.percentageLabel);
             hLayout->addChild(p.percentageLabel2);
             vLayout->addChild(hLayout);
+            hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
+            hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.hitsLabel);
+            hLayout->addChild(p.hitsLabel2);
+            hLayout->addChild(p.missesLabel);
+            hLayout->addChild(p.missesLabel2);
+            hLayout->addChild(p.evictionsLabel);
+            hLayout->addChild(p.evictionsLabel2);
+            vLayout->addChild(hLayout);
             p.layout->addChild(vLayout);
             addChild(p.layout);
 
@@ -149,6 +179,17 @@ namespace djv
                             widget->_widgetUpdate();
                         }
                     });
+
+                p.statsObserver = ValueObserver<AV::IO::FrameCacheStats>::create(
+                    fileSystem->observeCacheStats(),
+                    [weak](const AV::IO::FrameCacheStats& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->stats = value;
+                            widget->_widgetUpdate();
+                        }
+                    });
             }
         }
 
@@ -200,6 +241,12 @@ namespace djv
                 ss << static_cast<int>(p.percentageUsed) << "%";
                 p.percentageLabel2->setText(ss.str());
             }
+            p.hitsLabel->setText(_getText(DJV_TEXT("memory_cache_hits")) + ":");
+            p.hitsLabel2->setText(std::to_string(p.stats.hits));
+            p.missesLabel->setText(_getText(DJV_TEXT("memory_cache_misses")) + ":");
+            p.missesLabel2->setText(std::to_string(p.stats.misses));
+            p.evictionsLabel->setText(_getText(DJV_TEXT("memory_cache_evictions")) + ":");
+            p.evictionsLabel2->setText(std::to_string(p.stats.evictions));
         }
 
     } // namespace ViewApp
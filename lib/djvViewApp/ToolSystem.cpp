@@ -5,6 +5,7 @@
 #include <djvViewApp/ToolSystem.h>
 
 #include <djvViewApp/DebugWidget.h>
+#include <djvViewApp/HistogramWidget.h>
 #include <djvViewApp/IToolSystem.h>
 #include <djvViewApp/InfoWidget.h>
 #include <djvViewApp/MessagesWidget.h>
@@ -90,6 +91,8 @@ namespace djv
             p.actions["Info"] = UI::Action::create();
             p.actions["Info"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["Info"]->setShortcut(GLFW_KEY_I, UI::Shortcut::getSystemModifier());
+            p.actions["Histogram"] = UI::Action::create();
+            p.actions["Histogram"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["Messages"] = UI::Action::create();
             p.actions["Messages"]->setButtonType(UI::ButtonType::Toggle);
             p.actions["SystemLog"] = UI::Action::create();
@@ -108,6 +111,7 @@ namespace djv
             }
             p.menu->addSeparator();
             p.menu->addAction(p.actions["Info"]);
+            p.menu->addAction(p.actions["Histogram"]);
             p.menu->addSeparator();
             p.menu->addAction(p.actions["Messages"]);
             p.menu->addAction(p.actions["SystemLog"]);
@@ -156,6 +160,26 @@ namespace djv
                     }
                 });
 
+            p.actionObservers["Histogram"] = ValueObserver<bool>::create(
+                p.actions["Histogram"]->observeChecked(),
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            if (value)
+                            {
+                                system->_openWidget("Histogram", HistogramWidget::create(context));
+                            }
+                            else
+                            {
+                                system->_closeWidget("Histogram");
+                            }
+                        }
+                    }
+                });
+
             p.actionObservers["Messages"] = ValueObserver<bool>::create(
                 p.actions["Messages"]->observeChecked(),
                 [weak, contextWeak](bool value)
@@ -301,6 +325,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             _closeWidget("Info");
+            _closeWidget("Histogram");
             _closeWidget("Messages");
             _closeWidget("SystemLog");
             _closeWidget("Debug");
@@ -359,6 +384,8 @@ namespace djv
             {
                 p.actions["Info"]->setText(_getText(DJV_TEXT("menu_tools_information")));
                 p.actions["Info"]->setTooltip(_getText(DJV_TEXT("menu_tools_information_widget_tooltip")));
+                p.actions["Histogram"]->setText(_getText(DJV_TEXT("menu_tools_histogram")));
+                p.actions["Histogram"]->setTooltip(_getText(DJV_TEXT("menu_tools_histogram_widget_tooltip")));
                 p.actions["Messages"]->setText(_getText(DJV_TEXT("menu_tools_messages")));
                 p.actions["Messages"]->setTooltip(_getText(DJV_TEXT("menu_tools_messages_widget_tooltip")));
                 p.actions["SystemLog"]->setText(_getText(DJV_TEXT("menu_tools_system_log")));
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/Cache.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileInfo.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace djv;
+
+//! This benchmark measures the performance of the core containers and
+//! algorithms with large inputs that are too slow for the unit tests.
+//!
+//! Usage: CoreBenchmark
+
+namespace
+{
+    class Timer
+    {
+    public:
+        Timer() :
+            _start(std::chrono::steady_clock::now())
+        {}
+
+        float getMilliseconds() const
+        {
+            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - _start);
+            return duration.count() / 1000.F;
+        }
+
+    private:
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    void cache()
+    {
+        const size_t max = 1000;
+        const size_t count = 1000000;
+        Core::Memory::Cache<size_t, size_t> cache;
+        cache.setMax(max);
+        const Timer timer;
+        size_t hits = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Mix lookups of recent entries with additions that overflow the
+            // cache so that every add() evicts.
+            size_t value = 0;
+            if (cache.get(i - std::min(i, max / 2), value))
+            {
+                ++hits;
+            }
+            cache.add(i, i);
+        }
+        std::cout << "Cache: " << count << " gets and adds in " << timer.getMilliseconds() << "ms (" <<
+            hits << " hits)" << std::endl;
+    }
+
+    void fileInfo()
+    {
+        const size_t sequenceCount = 50;
+        const size_t frameCount = 20000;
+        std::vector<Core::FileSystem::FileInfo> fileInfos;
+        fileInfos.reserve(sequenceCount * frameCount);
+        for (size_t i = 0; i < frameCount; ++i)
+        {
+            for (size_t j = 0; j < sequenceCount; ++j)
+            {
+                std::stringstream ss;
+                ss << "render" << j << "." << Core::Frame::toString(i, 5) << ".exr";
+                fileInfos.push_back(Core::FileSystem::FileInfo(Core::FileSystem::Path(ss.str()), false));
+            }
+        }
+        Core::FileSystem::DirectoryListOptions options;
+        options.fileSequences = true;
+        options.fileSequenceExtensions = { ".exr" };
+        const Timer timer;
+        const auto out = Core::FileSystem::FileInfo::groupFileSequences(std::move(fileInfos), options);
+        std::cout << "FileInfo: " << sequenceCount * frameCount << " files grouped into " << out.size() <<
+            " sequences in " << timer.getMilliseconds() << "ms" << std::endl;
+    }
+
+    void frame()
+    {
+        // Create a sparse sequence (e.g., "1-10,20-30,33,35,37...").
+        const size_t rangeCount = 10000;
+        Core::Frame::Sequence sequence;
+        for (size_t i = 0; i < rangeCount; ++i)
+        {
+            const Core::Frame::Number frame = static_cast<Core::Frame::Number>(i * 20);
+            sequence.ranges.push_back(i % 2 ? Core::Frame::Range(frame) : Core::Frame::Range(frame, frame + 9));
+        }
+        const size_t size = sequence.getSize();
+        const Timer timer;
+        size_t errors = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const Core::Frame::Number frame = sequence.getFrame(i);
+            if (static_cast<Core::Frame::Index>(i) != sequence.getIndex(frame))
+            {
+                ++errors;
+            }
+        }
+        std::cout << "Frame: " << size << " frame and index lookups in a sequence with " << rangeCount <<
+            " ranges in " << timer.getMilliseconds() << "ms (" << errors << " errors)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        cache();
+        fileInfo();
+        frame();
+        r = 0;
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/IO.h>
+#include <djvAV/OpenEXR.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Path.h>
+#include <djvCore/TextSystem.h>
+#include <djvCore/Timer.h>
+
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace djv;
+
+//! This benchmark measures the throughput of the OpenEXR writer for each
+//! compression type, with scanline and tiled output.
+//!
+//! Usage: OpenEXRBenchmark [-size WxH] [-frames N] [-threads N]
+//!
+//! The frames are written to the temporary directory and removed afterwards.
+//! The thread count sets both the number of frames that are written
+//! concurrently and the size of the Imf global thread pool, zero uses the
+//! number of hardware threads.
+
+namespace
+{
+    const std::vector<AV::IO::OpenEXR::Compression> compressionList =
+    {
+        AV::IO::OpenEXR::Compression::None,
+        AV::IO::OpenEXR::Compression::RLE,
+        AV::IO::OpenEXR::Compression::ZIPS,
+        AV::IO::OpenEXR::Compression::ZIP,
+        AV::IO::OpenEXR::Compression::PIZ,
+        AV::IO::OpenEXR::Compression::DWAA,
+        AV::IO::OpenEXR::Compression::DWAB
+    };
+
+    //! Create an image with smooth gradients and some noise so that the
+    //! compression ratios are closer to rendered images.
+    std::shared_ptr<AV::Image::Image> createImage(const AV::Image::Size& size)
+    {
+        auto out = AV::Image::Image::create(AV::Image::Info(size, AV::Image::Type::RGBA_F16));
+        for (uint16_t y = 0; y < size.h; ++y)
+        {
+            auto p = reinterpret_cast<AV::Image::F16_T*>(out->getData(y));
+            for (uint16_t x = 0; x < size.w; ++x, p += 4)
+            {
+                const float noise = Core::Math::getRandom(-.02F, .02F);
+                p[0] = x / static_cast<float>(size.w) + noise;
+                p[1] = y / static_cast<float>(size.h) + noise;
+                p[2] = .5F + .5F * sinf(x * .01F) * cosf(y * .01F) + noise;
+                p[3] = 1.F;
+            }
+        }
+        return out;
+    }
+
+} // namespace
+
+class Application : public Core::Context
+{
+    DJV_NON_COPYABLE(Application);
+
+protected:
+    void _init(std::list<std::string>&);
+
+    Application();
+
+public:
+    static std::shared_ptr<Application> create(std::list<std::string>&);
+
+    void run();
+
+private:
+    void _write(
+        AV::IO::OpenEXR::Compression,
+        bool tiled,
+        const std::shared_ptr<AV::Image::Image>&);
+
+    AV::Image::Size _size = AV::Image::Size(1920, 1080);
+    size_t _frames = 24;
+    size_t _threadCount = 0;
+};
+
+void Application::_init(std::list<std::string>& args)
+{
+    std::string argv0;
+    if (args.size())
+    {
+        argv0 = args.front();
+        args.pop_front();
+    }
+    Context::_init(argv0);
+    AV::IO::System::create(shared_from_this());
+
+    auto i = args.begin();
+    while (i != args.end())
+    {
+        if ("-size" == *i && std::next(i) != args.end())
+        {
+            i = args.erase(i);
+            std::stringstream ss(*i);
+            ss >> _size;
+            i = args.erase(i);
+        }
+        else if ("-frames" == *i && std::next(i) != args.end())
+        {
+            i = args.erase(i);
+            _frames = static_cast<size_t>(std::max(std::stoi(*i), 1));
+            i = args.erase(i);
+        }
+        else if ("-threads" == *i && std::next(i) != args.end())
+        {
+            i = args.erase(i);
+            _threadCount = static_cast<size_t>(std::max(std::stoi(*i), 0));
+            i = args.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+Application::Application()
+{}
+
+std::shared_ptr<Application> Application::create(std::list<std::string>& args)
+{
+    auto out = std::shared_ptr<Application>(new Application);
+    out->_init(args);
+    return out;
+}
+
+void Application::run()
+{
+    auto io = getSystemT<AV::IO::System>();
+    AV::IO::OpenEXR::Options options;
+    fromJSON(io->getOptions(AV::IO::OpenEXR::pluginName), options);
+    options.threadCount = _threadCount;
+    std::cout << "Size: " << _size << std::endl;
+    std::cout << "Frames: " << _frames << std::endl;
+    std::cout << "Threads: " << AV::IO::OpenEXR::getGlobalThreadCount(options) << std::endl;
+    std::cout << std::endl;
+    std::cout <<
+        std::setw(12) << std::left << "Compression" <<
+        std::setw(10) << std::left << "Output" <<
+        std::setw(10) << std::right << "FPS" <<
+        std::setw(10) << std::right << "MB/s" <<
+        std::setw(10) << std::right << "Ratio" << std::endl;
+
+    const auto image = createImage(_size);
+    for (const auto compression : compressionList)
+    {
+        for (const bool tiled : { false, true })
+        {
+            _write(compression, tiled, image);
+        }
+    }
+}
+
+void Application::_write(
+    AV::IO::OpenEXR::Compression compression,
+    bool tiled,
+    const std::shared_ptr<AV::Image::Image>& image)
+{
+    auto io = getSystemT<AV::IO::System>();
+    AV::IO::OpenEXR::Options options;
+    fromJSON(io->getOptions(AV::IO::OpenEXR::pluginName), options);
+    options.threadCount = _threadCount;
+    options.compression = compression;
+    options.tiled = tiled;
+    io->setOptions(AV::IO::OpenEXR::pluginName, toJSON(options));
+
+    const Core::Frame::Sequence sequence(1, static_cast<Core::Frame::Number>(_frames));
+    Core::FileSystem::FileInfo fileInfo(Core::FileSystem::Path(
+        Core::FileSystem::Path::getTemp(),
+        "OpenEXRBenchmark.1-" + std::to_string(_frames) + ".exr"));
+    fileInfo.evalSequence();
+    AV::IO::Info info;
+    info.video.push_back(AV::IO::VideoInfo(image->getInfo(), Core::Time::Speed(), sequence));
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        auto write = io->write(fileInfo, info);
+        write->setThreadCount(AV::IO::OpenEXR::getGlobalThreadCount(options));
+        auto& queue = write->getVideoQueue();
+        size_t frame = 0;
+        const auto timeout = Core::Time::getValue(Core::Time::TimerValue::VeryFast);
+        while (write->isRunning())
+        {
+            if (frame < _frames)
+            {
+                if (queue.addFrame(AV::IO::VideoFrame(static_cast<Core::Frame::Number>(frame), image)))
+                {
+                    ++frame;
+                    if (frame == _frames)
+                    {
+                        std::lock_guard<std::mutex> lock(write->getMutex());
+                        queue.setFinished(true);
+                    }
+                    continue;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        }
+    }
+    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+
+    uint64_t fileByteCount = 0;
+    for (size_t i = 0; i < _frames; ++i)
+    {
+        const std::string fileName = fileInfo.getFileName(static_cast<Core::Frame::Number>(i + 1));
+        fileByteCount += Core::FileSystem::FileInfo(fileName).getSize();
+        std::remove(fileName.c_str());
+    }
+
+    const double seconds = delta.count();
+    const double byteCount = static_cast<double>(image->getDataByteCount()) * _frames;
+    std::stringstream ss;
+    ss << compression;
+    auto textSystem = getSystemT<Core::TextSystem>();
+    std::cout <<
+        std::setw(12) << std::left << textSystem->getText(ss.str()) <<
+        std::setw(10) << std::left << (tiled ? "Tiled" : "Scanline") <<
+        std::fixed << std::setprecision(2) <<
+        std::setw(10) << std::right << (seconds > 0.0 ? _frames / seconds : 0.0) <<
+        std::setw(10) << std::right << (seconds > 0.0 ? byteCount / seconds / Core::Memory::megabyte : 0.0) <<
+        std::setw(10) << std::right << (fileByteCount > 0 ? byteCount / fileByteCount : 0.0) << std::endl;
+}
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        std::list<std::string> args;
+        for (int i = 0; i < argc; ++i)
+        {
+            args.push_back(argv[i]);
+        }
+        auto app = Application::create(args);
+        app->run();
+        r = 0;
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -144,7 +144,6 @@ void Application::_init(std::list<std::string>& args)
             while (1)
             {
                 {
-                    std::lock_guard<std::mutex> lock(read->getMutex());
                     auto& queue = read->getVideoQueue();
                     if (!queue.isEmpty())
                     {
@@ -22,6 +22,7 @@ namespace djv
             _info();
             _data();
             _util();
+            _ringBuffer();
             _operators();
         }
 
@@ -114,6 +115,61 @@ namespace djv
             }
         }
         
+        void AudioDataTest::_ringBuffer()
+        {
+            {
+                const Audio::Info info(2, Audio::Type::S16, 44000, 8);
+                auto buffer = Audio::RingBuffer::create(info);
+                DJV_ASSERT(info == buffer->getInfo());
+                DJV_ASSERT(8 == buffer->getCapacity());
+                DJV_ASSERT(0 == buffer->getReadCount());
+                DJV_ASSERT(8 == buffer->getWriteCount());
+
+                std::vector<Audio::S16_T> in(12 * 2);
+                for (size_t i = 0; i < in.size(); ++i)
+                {
+                    in[i] = static_cast<Audio::S16_T>(i);
+                }
+                DJV_ASSERT(6 == buffer->write(reinterpret_cast<const uint8_t*>(in.data()), 6));
+                DJV_ASSERT(6 == buffer->getReadCount());
+                DJV_ASSERT(2 == buffer->getWriteCount());
+
+                std::vector<Audio::S16_T> out(12 * 2, 0);
+                DJV_ASSERT(4 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 4));
+                for (size_t i = 0; i < 4 * 2; ++i)
+                {
+                    DJV_ASSERT(in[i] == out[i]);
+                }
+
+                // Write and read across the end of the buffer.
+                DJV_ASSERT(6 == buffer->write(reinterpret_cast<const uint8_t*>(in.data() + 6 * 2), 6));
+                DJV_ASSERT(0 == buffer->write(reinterpret_cast<const uint8_t*>(in.data()), 1));
+                DJV_ASSERT(8 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 12));
+                for (size_t i = 0; i < 8 * 2; ++i)
+                {
+                    DJV_ASSERT(in[4 * 2 + i] == out[i]);
+                }
+                DJV_ASSERT(0 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 1));
+
+                DJV_ASSERT(2 == buffer->write(reinterpret_cast<const uint8_t*>(in.data()), 2));
+                DJV_ASSERT(2 == buffer->read(reinterpret_cast<uint8_t*>(out.data()), 2, 0.F));
+                DJV_ASSERT(0 == out[0] && 0 == out[3]);
+
+                DJV_ASSERT(2 == buffer->write(reinterpret_cast<const uint8_t*>(in.data()), 2));
+                buffer->reset();
+                DJV_ASSERT(0 == buffer->getReadCount());
+                DJV_ASSERT(8 == buffer->getWriteCount());
+            }
+
+            {
+                auto buffer = Audio::RingBuffer::create(Audio::Info());
+                DJV_ASSERT(0 == buffer->getCapacity());
+                uint8_t data = 0;
+                DJV_ASSERT(0 == buffer->write(&data, 1));
+                DJV_ASSERT(0 == buffer->read(&data, 1));
+            }
+        }
+
         void AudioDataTest::_operators()
         {
             {
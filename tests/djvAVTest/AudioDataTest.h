@@ -20,6 +20,7 @@ namespace djv
             void _info();
             void _data();
             void _util();
+            void _ringBuffer();
             void _operators();
         };
         
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/FrameCacheTest.h>
+
+#include <djvAV/FrameCache.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        FrameCacheTest::FrameCacheTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::FrameCacheTest", context)
+        {}
+        
+        void FrameCacheTest::run()
+        {
+            const Image::Info imageInfo(1, 2, Image::Type::RGB_U8);
+            const size_t byteCount = Image::Image::create(imageInfo)->getDataByteCount();
+            const IO::FrameCache::Key a("a.####.ppm", 0);
+            const IO::FrameCache::Key b("b.####.ppm", 0);
+
+            {
+                const IO::FrameCacheStats stats;
+                DJV_ASSERT(0 == stats.byteCount);
+                DJV_ASSERT(0.F == stats.getPercentageUsed());
+            }
+
+            {
+                auto cache = IO::FrameCache::create();
+                DJV_ASSERT(0 == cache->getMaxByteCount());
+                DJV_ASSERT(!cache->add(a, 0, Image::Image::create(imageInfo)));
+                DJV_ASSERT(!cache->contains(a, 0));
+                DJV_ASSERT(!cache->canAdd(a, 0, byteCount));
+            }
+
+            {
+                auto cache = IO::FrameCache::create();
+                cache->setMaxByteCount(byteCount * 4);
+                IO::FrameCache::Playhead playhead;
+                playhead.key = a;
+                playhead.frame = 0;
+                playhead.range = Range::Range<Frame::Index>(0, 99);
+                cache->setPlayhead(1, playhead);
+                for (Frame::Index i = 0; i < 4; ++i)
+                {
+                    DJV_ASSERT(cache->add(a, i, Image::Image::create(imageInfo)));
+                }
+                DJV_ASSERT(byteCount * 4 == cache->getByteCount());
+                DJV_ASSERT(byteCount * 4 == cache->getByteCount(a));
+                DJV_ASSERT(Frame::Sequence(0, 3) == cache->getFrames(a));
+
+                // Frames farther from the playhead are not added.
+                DJV_ASSERT(!cache->canAdd(a, 4, byteCount));
+                DJV_ASSERT(!cache->add(a, 4, Image::Image::create(imageInfo)));
+
+                // Moving the playhead allows new frames to replace old ones.
+                playhead.frame = 2;
+                cache->setPlayhead(1, playhead);
+                DJV_ASSERT(cache->canAdd(a, 4, byteCount));
+                DJV_ASSERT(cache->add(a, 4, Image::Image::create(imageInfo)));
+                DJV_ASSERT(!cache->contains(a, 0) || !cache->contains(a, 1));
+
+                // Reverse playback keeps the frames before the playhead.
+                playhead.direction = IO::Direction::Reverse;
+                cache->setPlayhead(1, playhead);
+                DJV_ASSERT(cache->add(a, 1, Image::Image::create(imageInfo)));
+                DJV_ASSERT(!cache->contains(a, 3));
+
+                std::shared_ptr<Image::Image> image;
+                DJV_ASSERT(cache->get(a, 1, image));
+                DJV_ASSERT(image);
+                DJV_ASSERT(!cache->get(a, 10, image));
+                const auto stats = cache->getStats();
+                DJV_ASSERT(1 == stats.hits);
+                DJV_ASSERT(1 == stats.misses);
+                DJV_ASSERT(stats.evictions > 0);
+                DJV_ASSERT(100.F == stats.getPercentageUsed());
+            }
+
+            {
+                auto cache = IO::FrameCache::create();
+                cache->setMaxByteCount(byteCount * 4);
+                for (Frame::Index i = 0; i < 4; ++i)
+                {
+                    DJV_ASSERT(cache->add(b, i, Image::Image::create(imageInfo)));
+                }
+
+                // Frames without a playhead are evicted first.
+                IO::FrameCache::Playhead playhead;
+                playhead.key = a;
+                playhead.range = Range::Range<Frame::Index>(0, 99);
+                cache->setPlayhead(1, playhead);
+                for (Frame::Index i = 0; i < 4; ++i)
+                {
+                    DJV_ASSERT(cache->add(a, i, Image::Image::create(imageInfo)));
+                }
+                DJV_ASSERT(0 == cache->getByteCount(b));
+                DJV_ASSERT(Frame::Sequence() == cache->getFrames(b));
+                cache->removePlayhead(1);
+
+                cache->setMaxByteCount(byteCount * 2);
+                DJV_ASSERT(byteCount * 2 == cache->getByteCount());
+                cache->clear(a);
+                DJV_ASSERT(0 == cache->getByteCount());
+                DJV_ASSERT(cache->add(b, 0, Image::Image::create(imageInfo)));
+                cache->clear();
+                DJV_ASSERT(!cache->contains(b, 0));
+            }
+
+            {
+                // Layers that share a playhead are not evicted by frames without
+                // a playhead.
+                auto cache = IO::FrameCache::create();
+                cache->setMaxByteCount(byteCount * 4);
+                const IO::FrameCache::Key a1("a.####.ppm", 1);
+                IO::FrameCache::Playhead playhead;
+                playhead.key = a;
+                playhead.range = Range::Range<Frame::Index>(0, 99);
+                playhead.layers.insert(1);
+                cache->setPlayhead(1, playhead);
+                for (Frame::Index i = 0; i < 2; ++i)
+                {
+                    DJV_ASSERT(cache->add(a, i, Image::Image::create(imageInfo)));
+                    DJV_ASSERT(cache->add(a1, i, Image::Image::create(imageInfo)));
+                }
+                DJV_ASSERT(!cache->canAdd(b, 0, byteCount));
+                DJV_ASSERT(!cache->add(b, 0, Image::Image::create(imageInfo)));
+                DJV_ASSERT(cache->contains(a1, 0));
+                DJV_ASSERT(cache->contains(a1, 1));
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class FrameCacheTest : public Test::ITest
+        {
+        public:
+            FrameCacheTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        };
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -4,12 +4,17 @@
 
 #include <djvAVTest/IOTest.h>
 
+#include <djvAV/FrameCache.h>
 #include <djvAV/IO.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/FileInfo.h>
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -32,6 +37,9 @@ namespace djv
             _audioQueue();
             _cache();
             _io();
+            _sequenceWrite();
+            _proxy();
+            _roi();
             _system();
             _operators();
         }
@@ -147,12 +155,134 @@ namespace djv
                 DJV_ASSERT(!queue.isEmpty());
                 DJV_ASSERT(3 == queue.getCount());
                 DJV_ASSERT(frame == queue.getFrame());
+                DJV_ASSERT(2 == queue.getFrame(1).frame);
+                DJV_ASSERT(3 == queue.getFrame(2).frame);
+                DJV_ASSERT(IO::VideoFrame() == queue.getFrame(3));
+                DJV_ASSERT(1 == queue.getFrameNumber());
                 DJV_ASSERT(frame == queue.popFrame());
                 queue.clearFrames();
                 DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(Frame::invalid == queue.getFrameNumber());
+                queue.addFrame(IO::VideoFrame(4, nullptr));
+                DJV_ASSERT(1 == queue.getCount());
+                DJV_ASSERT(4 == queue.popFrame().frame);
                 queue.setFinished(true);
                 DJV_ASSERT(queue.isFinished());
             }
+
+            {
+                IO::VideoQueue queue;
+                queue.setMax(10);
+                queue.addFrame(IO::VideoFrame(1, nullptr));
+                queue.addFrame(IO::VideoFrame(2, nullptr));
+                queue.invalidateFrames();
+                DJV_ASSERT(queue.isEmpty());
+                DJV_ASSERT(IO::VideoFrame() == queue.getFrame());
+                DJV_ASSERT(IO::VideoFrame() == queue.popFrame());
+                DJV_ASSERT(Frame::invalid == queue.getFrameNumber());
+                queue.clearFrames();
+                DJV_ASSERT(queue.isEmpty());
+                queue.addFrame(IO::VideoFrame(3, nullptr));
+                DJV_ASSERT(3 == queue.getFrame().frame);
+                DJV_ASSERT(3 == queue.popFrame().frame);
+            }
+
+            {
+                IO::VideoQueue queue;
+                queue.setMax(1);
+                size_t count = 0;
+                while (queue.addFrame(IO::VideoFrame(count, nullptr)))
+                {
+                    ++count;
+                }
+                DJV_ASSERT(count >= queue.getMax());
+                DJV_ASSERT(count == queue.getCount());
+            }
+
+            {
+                IO::VideoQueue queue;
+                queue.setMax(10);
+                size_t popCount = 0;
+                queue.setPopCallback(
+                    [&popCount]
+                    {
+                        ++popCount;
+                    });
+                const Frame::Number frameCount = 10000;
+                std::thread thread(
+                    [&queue, frameCount]
+                    {
+                        for (Frame::Number i = 0; i < frameCount; ++i)
+                        {
+                            while (!queue.addFrame(IO::VideoFrame(i, nullptr)))
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                        queue.setFinished(true);
+                    });
+                Frame::Number frame = 0;
+                while (frame < frameCount)
+                {
+                    if (!queue.isEmpty())
+                    {
+                        DJV_ASSERT(frame == queue.popFrame().frame);
+                        ++frame;
+                    }
+                }
+                thread.join();
+                DJV_ASSERT(queue.isFinished());
+                DJV_ASSERT(static_cast<size_t>(frameCount) == popCount);
+            }
+
+            {
+                // Seek while the producer is adding frames and check that
+                // no frame from before a seek is returned.
+                IO::VideoQueue queue;
+                queue.setMax(10);
+                const Frame::Number seekCount = 1000;
+                const Frame::Number seekFrames = 1000000;
+                std::atomic<Frame::Number> seek(0);
+                std::atomic<bool> running(true);
+                std::thread thread(
+                    [&queue, &seek, &running]
+                    {
+                        Frame::Number current = 0;
+                        Frame::Number frame = 0;
+                        while (running)
+                        {
+                            const Frame::Number value = seek.load();
+                            if (value != current)
+                            {
+                                current = value;
+                                frame = value;
+                                queue.clearFrames();
+                            }
+                            if (queue.addFrame(IO::VideoFrame(frame, nullptr)))
+                            {
+                                ++frame;
+                            }
+                            else
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    });
+                for (Frame::Number i = 1; i <= seekCount; ++i)
+                {
+                    queue.invalidateFrames();
+                    seek.store(i * seekFrames);
+                    for (size_t j = 0; j < 10; ++j)
+                    {
+                        const Frame::Number frame = queue.getFrame().frame;
+                        DJV_ASSERT(0 == frame || frame >= i * seekFrames);
+                        const Frame::Number popped = queue.popFrame().frame;
+                        DJV_ASSERT(0 == popped || popped >= i * seekFrames);
+                    }
+                }
+                running = false;
+                thread.join();
+            }
         }
         
         void IOTest::_audioFrame()
@@ -352,6 +482,221 @@ namespace djv
             }
         }
         
+        void IOTest::_sequenceWrite()
+        {
+            if (auto context = getContext().lock())
+            {
+                // Write a sequence that requires the images to be converted,
+                // and check that every frame is written.
+                const size_t frameCount = 20;
+                const Image::Info imageInfo(32, 32, Image::Type::RGBA_F32);
+                auto io = context->getSystemT<AV::IO::System>();
+                FileSystem::FileInfo fileInfo("IOTest_sequence.1.ppm");
+                fileInfo.evalSequence();
+                {
+                    IO::Info info;
+                    info.video.push_back(imageInfo);
+                    IO::WriteOptions options;
+                    options.videoQueueSize = 4;
+                    auto write = io->write(fileInfo, info, options);
+                    size_t frame = 0;
+                    while (frame < frameCount)
+                    {
+                        auto& writeQueue = write->getVideoQueue();
+                        if (writeQueue.getCount() < writeQueue.getMax())
+                        {
+                            auto image = Image::Image::create(imageInfo);
+                            image->zero();
+                            writeQueue.addFrame(IO::VideoFrame(frame, image));
+                            ++frame;
+                        }
+                        else
+                        {
+                            std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                        }
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(write->getMutex());
+                        write->getVideoQueue().setFinished(true);
+                    }
+                    while (write->isRunning())
+                    {}
+                }
+                for (size_t i = 1; i <= frameCount; ++i)
+                {
+                    const std::string fileName = fileInfo.getFileName(static_cast<Frame::Number>(i));
+                    _print(fileName);
+                    DJV_ASSERT(FileSystem::FileInfo(fileName).doesExist());
+                }
+            }
+        }
+        
+        void IOTest::_proxy()
+        {
+            DJV_ASSERT(Image::Size(33, 17) == IO::getProxySize(Image::Size(33, 17), 0));
+            DJV_ASSERT(Image::Size(17, 9) == IO::getProxySize(Image::Size(33, 17), 1));
+            DJV_ASSERT(Image::Size(9, 5) == IO::getProxySize(Image::Size(33, 17), 2));
+            DJV_ASSERT(Image::Size(5, 3) == IO::getProxySize(Image::Size(33, 17), 3));
+            DJV_ASSERT(Image::Size(5, 3) == IO::getProxySize(Image::Size(33, 17), 4));
+
+            DJV_ASSERT(IO::FrameCache::Key("a", 0, 0) == IO::FrameCache::Key("a", 0, 0));
+            DJV_ASSERT(IO::FrameCache::Key("a", 0, 0) < IO::FrameCache::Key("a", 0, 1));
+            DJV_ASSERT(IO::FrameCache::Key("a", 1, 0) < IO::FrameCache::Key("b", 0, 0));
+
+            if (auto context = getContext().lock())
+            {
+                // Write an image with a pattern and check that the proxy images
+                // have the expected size and pixels.
+                const Image::Info imageInfo(33, 17, Image::Type::RGB_U8);
+                auto image = Image::Image::create(imageInfo);
+                for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                {
+                    uint8_t* p = image->getData(y);
+                    for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += 3)
+                    {
+                        p[0] = static_cast<uint8_t>(x);
+                        p[1] = static_cast<uint8_t>(y);
+                        p[2] = 0;
+                    }
+                }
+                auto io = context->getSystemT<AV::IO::System>();
+                FileSystem::FileInfo fileInfo("IOTest_proxy.ppm");
+                {
+                    IO::Info info;
+                    info.video.push_back(imageInfo);
+                    auto write = io->write(fileInfo, info);
+                    {
+                        std::lock_guard<std::mutex> lock(write->getMutex());
+                        auto& writeQueue = write->getVideoQueue();
+                        writeQueue.addFrame(IO::VideoFrame(0, image));
+                        writeQueue.setFinished(true);
+                    }
+                    while (write->isRunning())
+                    {}
+                }
+                for (size_t proxy = 0; proxy <= IO::proxyMax; ++proxy)
+                {
+                    IO::ReadOptions options;
+                    options.proxy = proxy;
+                    auto read = io->read(fileInfo, options);
+                    DJV_ASSERT(read->hasProxy());
+                    DJV_ASSERT(proxy == read->getProxy(proxy));
+                    std::shared_ptr<Image::Image> proxyImage;
+                    while (!proxyImage)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(read->getMutex());
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                proxyImage = readQueue.popFrame().image;
+                            }
+                        }
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                    std::stringstream ss;
+                    ss << "proxy " << proxy << ": " << proxyImage->getSize();
+                    _print(ss.str());
+                    DJV_ASSERT(proxy == proxyImage->getProxy());
+                    DJV_ASSERT(IO::getProxySize(imageInfo.size, proxy) == proxyImage->getSize());
+                    const uint16_t step = static_cast<uint16_t>(1 << proxy);
+                    const uint8_t* p = proxyImage->getData(1, 1);
+                    DJV_ASSERT(step == p[0]);
+                    DJV_ASSERT(step == p[1]);
+                }
+            }
+        }
+
+        void IOTest::_roi()
+        {
+            {
+                const IO::ReadOptions options;
+                DJV_ASSERT(!options.roi.isValid());
+            }
+            {
+                const BBox2i roi(0, 0, 256, 256);
+                DJV_ASSERT(IO::FrameCache::Key("a", 0, 0, roi) == IO::FrameCache::Key("a", 0, 0, roi));
+                DJV_ASSERT(!(IO::FrameCache::Key("a", 0, 0, roi) == IO::FrameCache::Key("a", 0, 0)));
+                DJV_ASSERT(IO::FrameCache::Key("a", 0, 0) < IO::FrameCache::Key("a", 0, 0, roi));
+                DJV_ASSERT(IO::FrameCache::Key("a", 0, 0, roi) < IO::FrameCache::Key("a", 0, 1));
+            }
+
+            if (auto context = getContext().lock())
+            {
+                // Write an image with a pattern and check that only the pixels
+                // inside the region of interest are read.
+                const Image::Info imageInfo(64, 32, Image::Type::RGB_F32);
+                auto image = Image::Image::create(imageInfo);
+                for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                {
+                    float* p = reinterpret_cast<float*>(image->getData(y));
+                    for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += 3)
+                    {
+                        p[0] = static_cast<float>(x);
+                        p[1] = static_cast<float>(y);
+                        p[2] = 1.F;
+                    }
+                }
+                auto io = context->getSystemT<AV::IO::System>();
+                const FileSystem::FileInfo fileInfo("IOTest_roi.exr");
+                IO::Info info;
+                info.video.push_back(imageInfo);
+                if (io->canWrite(fileInfo, info))
+                {
+                    {
+                        auto write = io->write(fileInfo, info);
+                        {
+                            std::lock_guard<std::mutex> lock(write->getMutex());
+                            auto& writeQueue = write->getVideoQueue();
+                            writeQueue.addFrame(IO::VideoFrame(0, image));
+                            writeQueue.setFinished(true);
+                        }
+                        while (write->isRunning())
+                        {}
+                    }
+
+                    IO::ReadOptions options;
+                    options.roi = BBox2i(16, 8, 16, 8);
+                    auto read = io->read(fileInfo, options);
+                    DJV_ASSERT(read->hasROI());
+                    std::shared_ptr<Image::Image> roiImage;
+                    while (!roiImage)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(read->getMutex());
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                roiImage = readQueue.popFrame().image;
+                            }
+                        }
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                    DJV_ASSERT(imageInfo.size == roiImage->getSize());
+                    DJV_ASSERT(imageInfo.type == roiImage->getType());
+                    for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                    {
+                        const float* p = reinterpret_cast<const float*>(roiImage->getData(y));
+                        for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += 3)
+                        {
+                            if (options.roi.contains(glm::ivec2(x, y)))
+                            {
+                                DJV_ASSERT(static_cast<float>(x) == p[0]);
+                                DJV_ASSERT(static_cast<float>(y) == p[1]);
+                                DJV_ASSERT(1.F == p[2]);
+                            }
+                            else
+                            {
+                                DJV_ASSERT(0.F == p[0]);
+                                DJV_ASSERT(0.F == p[1]);
+                                DJV_ASSERT(0.F == p[2]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
         void IOTest::_system()
         {
             if (auto context = getContext().lock())
@@ -25,6 +25,9 @@ namespace djv
             void _audioQueue();
             void _cache();
             void _io();
+            void _sequenceWrite();
+            void _proxy();
+            void _roi();
             void _system();
             void _operators();
         };
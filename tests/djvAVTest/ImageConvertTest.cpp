@@ -8,6 +8,7 @@
 
 #include <djvCore/Context.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/ThreadPool.h>
 
 using namespace djv::Core;
 using namespace djv::AV;
@@ -21,6 +22,12 @@ namespace djv
         {}
         
         void ImageConvertTest::run()
+        {
+            _openGL();
+            _cpu();
+        }
+
+        void ImageConvertTest::_openGL()
         {
             if (auto context = getContext().lock())
             {
@@ -47,6 +54,126 @@ namespace djv
                 //DJV_ASSERT(Image::U8Range.max == u8);
             }
         }
+
+        void ImageConvertTest::_cpu()
+        {
+            for (auto backend : Image::getConvertBackendEnums())
+            {
+                std::stringstream ss;
+                ss << "backend: " << backend;
+                _print(ss.str());
+            }
+
+            auto threadPool = ThreadPool::create(4);
+            for (const auto& i : std::vector<std::shared_ptr<ThreadPool> >({ nullptr, threadPool }))
+            {
+                auto convert = Image::Convert::create(nullptr, Image::ConvertBackend::CPU, i);
+                DJV_ASSERT(Image::ConvertBackend::CPU == convert->getBackend());
+
+                {
+                    const Image::Info info(3, 200, Image::Type::L_U8);
+                    auto data = Image::Data::create(info);
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        for (uint16_t x = 0; x < info.size.w; ++x)
+                        {
+                            data->getData(x, y)[0] = static_cast<Image::U8_T>(x + y);
+                        }
+                    }
+                    const Image::Info info2(3, 200, Image::Type::RGBA_U8);
+                    auto data2 = Image::Data::create(info2);
+                    convert->process(*data, info2, *data2);
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        for (uint16_t x = 0; x < info.size.w; ++x)
+                        {
+                            const Image::U8_T* p = data2->getData(x, y);
+                            DJV_ASSERT(static_cast<Image::U8_T>(x + y) == p[0]);
+                            DJV_ASSERT(p[0] == p[1] && p[0] == p[2]);
+                            DJV_ASSERT(Image::U8Range.max == p[3]);
+                        }
+                    }
+                }
+
+                {
+                    const Image::Info info(37, 5, Image::Type::RGB_U8);
+                    auto data = Image::Data::create(info);
+                    for (size_t j = 0; j < info.getDataByteCount(); ++j)
+                    {
+                        data->getData()[j] = static_cast<Image::U8_T>(j);
+                    }
+                    const Image::Info info2(37, 5, Image::Type::RGB_F32);
+                    auto data2 = Image::Data::create(info2);
+                    convert->process(*data, info2, *data2);
+                    const Image::F32_T* p = reinterpret_cast<const Image::F32_T*>(data2->getData());
+                    for (size_t j = 0; j < info.getDataByteCount(); ++j)
+                    {
+                        Image::F32_T f32 = 0.F;
+                        Image::convert_U8_F32(data->getData()[j], f32);
+                        DJV_ASSERT(f32 == p[j]);
+                    }
+
+                    auto data3 = Image::Data::create(info);
+                    convert->process(*data2, info, *data3);
+                    DJV_ASSERT(*data == *data3);
+                }
+
+                {
+                    Image::Info info(2, 2, Image::Type::L_U16);
+                    info.layout.mirror = Image::Mirror(true, true);
+                    info.layout.endian = Memory::opposite(Memory::getEndian());
+                    auto data = Image::Data::create(info);
+                    Image::U16_T* p = reinterpret_cast<Image::U16_T*>(data->getData());
+                    p[0] = 0x0001;
+                    p[1] = 0x0002;
+                    p[2] = 0x0003;
+                    p[3] = 0x0004;
+                    const Image::Info info2(2, 2, Image::Type::L_U16);
+                    auto data2 = Image::Data::create(info2);
+                    convert->process(*data, info2, *data2);
+                    const Image::U16_T* p2 = reinterpret_cast<const Image::U16_T*>(data2->getData());
+                    DJV_ASSERT(0x0400 == p2[0]);
+                    DJV_ASSERT(0x0300 == p2[1]);
+                    DJV_ASSERT(0x0200 == p2[2]);
+                    DJV_ASSERT(0x0100 == p2[3]);
+                }
+
+                {
+                    const Image::Info info(4, 4, Image::Type::L_U8);
+                    auto data = Image::Data::create(info);
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        for (uint16_t x = 0; x < info.size.w; ++x)
+                        {
+                            data->getData(x, y)[0] = static_cast<Image::U8_T>(y * 4 + x);
+                        }
+                    }
+                    const Image::Info info2(2, 2, Image::Type::L_U8);
+                    auto data2 = Image::Data::create(info2);
+                    convert->process(*data, info2, *data2);
+                    DJV_ASSERT(0 == data2->getData(0, 0)[0]);
+                    DJV_ASSERT(2 == data2->getData(1, 0)[0]);
+                    DJV_ASSERT(8 == data2->getData(0, 1)[0]);
+                    DJV_ASSERT(10 == data2->getData(1, 1)[0]);
+                }
+
+                for (auto inType : Image::getTypeEnums())
+                {
+                    for (auto outType : Image::getTypeEnums())
+                    {
+                        if (inType != Image::Type::None && outType != Image::Type::None)
+                        {
+                            const Image::Info info(16, 130, inType);
+                            auto data = Image::Data::create(info);
+                            data->zero();
+                            const Image::Info info2(16, 130, outType);
+                            auto data2 = Image::Data::create(info2);
+                            convert->process(*data, info2, *data2);
+                        }
+                    }
+                }
+            }
+        }
                 
     } // namespace AVTest
 } // namespace djv
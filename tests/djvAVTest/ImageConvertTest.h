@@ -14,6 +14,10 @@ namespace djv
             ImageConvertTest(const std::shared_ptr<Core::Context>&);
             
             void run() override;
+
+        private:
+            void _openGL();
+            void _cpu();
         };
         
     } // namespace AVTest
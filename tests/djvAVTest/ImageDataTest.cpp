@@ -6,7 +6,11 @@
 
 #include <djvAV/ImageData.h>
 
+#include <djvCore/FileIO.h>
 #include <djvCore/Memory.h>
+#include <djvCore/Path.h>
+
+#include <thread>
 
 using namespace djv::Core;
 using namespace djv::AV;
@@ -215,7 +219,75 @@ namespace djv
 
                 auto data2 = Image::Data::create(info);
                 DJV_ASSERT(data->getUID() != data2->getUID());
+
+                const Core::UID uid = data->getUID();
+                data->resetUID();
+                DJV_ASSERT(uid != data->getUID());
+                DJV_ASSERT(data2->getUID() != data->getUID());
+            }
+
+#if defined(DJV_MMAP)
+            {
+                const Image::Info info(2, 2, Image::Type::L_U8);
+                const std::string fileName = "ImageDataTest.raw";
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(fileName, FileSystem::FileIO::Mode::Write);
+                    io->writeU32(0);
+                    const uint8_t pixels[] = { 1, 2, 3, 4 };
+                    io->write(pixels, 4);
+                }
+                {
+                    auto io = FileSystem::FileIO::create();
+                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    io->seek(4);
+                    auto data = Image::Data::create(info, io);
+                    DJV_ASSERT(data->isMapped());
+                    DJV_ASSERT(info.getDataByteCount() == data->getDataByteCount());
+                    const uint8_t* p = static_cast<const Image::Data&>(*data).getData();
+                    DJV_ASSERT(1 == p[0] && 4 == p[3]);
+                    data->mmapDontNeed();
+                    DJV_ASSERT(4 == p[3]);
+
+                    // Detaching copies the data but the mapped pointer stays valid.
+                    data->getData()[0] = 5;
+                    DJV_ASSERT(!data->isMapped());
+                    DJV_ASSERT(1 == p[0]);
+                    DJV_ASSERT(5 == static_cast<const Image::Data&>(*data).getData()[0]);
+
+                    // Detaching from several threads at once makes one copy.
+                    io->setPos(4);
+                    auto data3 = Image::Data::create(info, io);
+                    std::vector<uint8_t*> pointers(4, nullptr);
+                    std::vector<std::thread> threads;
+                    for (size_t i = 0; i < pointers.size(); ++i)
+                    {
+                        threads.push_back(std::thread(
+                            [data3, &pointers, i]
+                            {
+                                pointers[i] = data3->getData();
+                            }));
+                    }
+                    for (auto& i : threads)
+                    {
+                        i.join();
+                    }
+                    for (const auto& i : pointers)
+                    {
+                        DJV_ASSERT(i == pointers[0]);
+                    }
+                    DJV_ASSERT(pointers[0] == static_cast<const Image::Data&>(*data3).getData());
+                    DJV_ASSERT(1 == pointers[0][0]);
+
+                    // Files that are too short are copied instead of mapped.
+                    io->setPos(6);
+                    auto data2 = Image::Data::create(info, io);
+                    DJV_ASSERT(!data2->isMapped());
+                    DJV_ASSERT(3 == data2->getData()[0]);
+                }
+                FileSystem::Path::rm(FileSystem::Path(fileName));
             }
+#endif // DJV_MMAP
         }
         
         void ImageDataTest::_util()
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ImageScopesTest.h>
+
+#include <djvAV/ImageScopes.h>
+
+#include <djvCore/ThreadPool.h>
+
+#include <numeric>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageScopesTest::ImageScopesTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageScopesTest", context)
+        {}
+
+        void ImageScopesTest::run()
+        {
+            _options();
+            _scopes();
+            _float();
+            _threads();
+        }
+
+        void ImageScopesTest::_options()
+        {
+            {
+                Image::ScopesOptions options;
+                DJV_ASSERT(options == Image::ScopesOptions());
+                options.histogramScale = Image::HistogramScale::Log;
+                DJV_ASSERT(options != Image::ScopesOptions());
+            }
+
+            {
+                DJV_ASSERT(1 == Image::getScopesSampleStride(Image::Size(100, 100), 0));
+                DJV_ASSERT(1 == Image::getScopesSampleStride(Image::Size(100, 100), 10000));
+                DJV_ASSERT(2 == Image::getScopesSampleStride(Image::Size(200, 200), 10000));
+                DJV_ASSERT(3 == Image::getScopesSampleStride(Image::Size(201, 200), 10000));
+            }
+
+            for (auto i : Image::getHistogramScaleEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                std::stringstream ss2;
+                ss2 << "histogram scale string: " << _getText(ss.str());
+                _print(ss2.str());
+            }
+        }
+
+        namespace
+        {
+            uint32_t getSum(const std::vector<uint32_t>& value)
+            {
+                return std::accumulate(value.begin(), value.end(), static_cast<uint32_t>(0));
+            }
+
+        } // namespace
+
+        void ImageScopesTest::_scopes()
+        {
+            {
+                // Use a width that is not a multiple of four so that both the
+                // vectorized and scalar code is tested.
+                auto data = Image::Data::create(Image::Info(67, 33, Image::Type::RGBA_U8));
+                for (uint16_t y = 0; y < data->getHeight(); ++y)
+                {
+                    auto p = data->getData(y);
+                    for (uint16_t x = 0; x < data->getWidth(); ++x, p += 4)
+                    {
+                        p[0] = 255;
+                        p[1] = 0;
+                        p[2] = 0;
+                        p[3] = 255;
+                    }
+                }
+                auto scopes = Image::computeScopes(*data);
+                const uint32_t pixelCount = 67 * 33;
+                DJV_ASSERT(1 == scopes->sampleStride);
+                DJV_ASSERT(pixelCount == scopes->sampleCount);
+                DJV_ASSERT(4 == scopes->histogramChannelCount);
+                const size_t bins = scopes->options.histogramBins;
+                DJV_ASSERT(pixelCount == scopes->histogram[bins - 1]);
+                DJV_ASSERT(pixelCount == scopes->histogram[bins]);
+                DJV_ASSERT(pixelCount == scopes->histogram[bins * 2]);
+                DJV_ASSERT(pixelCount == scopes->histogram[bins * 3 + bins - 1]);
+                DJV_ASSERT(pixelCount == scopes->histogramMax);
+                DJV_ASSERT(pixelCount == getSum(scopes->waveform));
+                DJV_ASSERT(pixelCount == getSum(scopes->vectorscope));
+                DJV_ASSERT(pixelCount == scopes->vectorscopeMax);
+
+                // Red has a luma of .2126 and a Cr above the center.
+                const size_t waveformSize = scopes->options.waveformSize;
+                const size_t level = static_cast<size_t>(.2126F * waveformSize);
+                DJV_ASSERT(scopes->waveform[level] > 0);
+                DJV_ASSERT(scopes->waveform[(66 * waveformSize / 67) * waveformSize + level] > 0);
+                const size_t vectorscopeSize = scopes->options.vectorscopeSize;
+                uint32_t upper = 0;
+                for (size_t i = vectorscopeSize / 2 * vectorscopeSize; i < scopes->vectorscope.size(); ++i)
+                {
+                    upper += scopes->vectorscope[i];
+                }
+                DJV_ASSERT(pixelCount == upper);
+            }
+
+            {
+                auto data = Image::Data::create(Image::Info(64, 64, Image::Type::L_U16));
+                data->zero();
+                auto scopes = Image::computeScopes(*data);
+                DJV_ASSERT(1 == scopes->histogramChannelCount);
+                DJV_ASSERT(64 * 64 == scopes->histogram[0]);
+            }
+
+            {
+                // Decimate the image.
+                auto data = Image::Data::create(Image::Info(100, 100, Image::Type::RGB_U8));
+                data->zero();
+                Image::ScopesOptions options;
+                options.sampleMax = 100;
+                auto scopes = Image::computeScopes(*data, options);
+                DJV_ASSERT(10 == scopes->sampleStride);
+                DJV_ASSERT(100 == scopes->sampleCount);
+                DJV_ASSERT(100 == getSum(scopes->waveform));
+            }
+
+            {
+                auto scopes = Image::computeScopes(*Image::Data::create(Image::Info()));
+                DJV_ASSERT(0 == scopes->sampleCount);
+                DJV_ASSERT(0 == scopes->histogramMax);
+            }
+        }
+
+        void ImageScopesTest::_float()
+        {
+            auto data = Image::Data::create(Image::Info(16, 16, Image::Type::RGB_F32));
+            for (uint16_t y = 0; y < data->getHeight(); ++y)
+            {
+                auto p = reinterpret_cast<float*>(data->getData(y));
+                for (uint16_t x = 0; x < data->getWidth(); ++x, p += 3)
+                {
+                    p[0] = 1.F;
+                    p[1] = 4.F;
+                    p[2] = -1.F;
+                }
+            }
+            const uint32_t pixelCount = 16 * 16;
+
+            Image::ScopesOptions options;
+            auto scopes = Image::computeScopes(*data, options);
+            const size_t bins = options.histogramBins;
+            DJV_ASSERT(pixelCount == scopes->histogram[bins - 1]);
+            DJV_ASSERT(pixelCount == scopes->histogram[bins + bins - 1]);
+            DJV_ASSERT(pixelCount == scopes->histogram[bins * 2]);
+
+            options.histogramScale = Image::HistogramScale::Log;
+            scopes = Image::computeScopes(*data, options);
+            const float stops = options.histogramLogRange.max - options.histogramLogRange.min;
+            const size_t bin = static_cast<size_t>(-options.histogramLogRange.min / stops * bins);
+            const size_t bin2 = static_cast<size_t>((2.F - options.histogramLogRange.min) / stops * bins);
+            DJV_ASSERT(pixelCount == scopes->histogram[bin]);
+            DJV_ASSERT(pixelCount == scopes->histogram[bins + bin2]);
+            DJV_ASSERT(pixelCount == scopes->histogram[bins * 2]);
+        }
+
+        void ImageScopesTest::_threads()
+        {
+            auto data = Image::Data::create(Image::Info(301, 257, Image::Type::RGBA_U16));
+            for (uint16_t y = 0; y < data->getHeight(); ++y)
+            {
+                auto p = reinterpret_cast<Image::U16_T*>(data->getData(y));
+                for (uint16_t x = 0; x < data->getWidth(); ++x, p += 4)
+                {
+                    p[0] = x * 200;
+                    p[1] = y * 200;
+                    p[2] = (x + y) * 100;
+                    p[3] = 65535;
+                }
+            }
+            Image::ScopesOptions options;
+            options.sampleMax = 0;
+            auto scopes = Image::computeScopes(*data, options);
+            auto scopes2 = Image::computeScopes(*data, options, ThreadPool::create(4));
+            DJV_ASSERT(scopes->histogram == scopes2->histogram);
+            DJV_ASSERT(scopes->waveform == scopes2->waveform);
+            DJV_ASSERT(scopes->vectorscope == scopes2->vectorscope);
+            DJV_ASSERT(301 * 257 == getSum(scopes2->waveform));
+            auto scopes3 = Image::computeScopes(*data, options, ThreadPool::create(4), ThreadPool::Priority::Low);
+            DJV_ASSERT(scopes->histogram == scopes3->histogram);
+        }
+
+    } // namespace AVTest
+} // namespace djv
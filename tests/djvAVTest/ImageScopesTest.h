@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class ImageScopesTest : public Test::ITest
+        {
+        public:
+            ImageScopesTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _options();
+            void _scopes();
+            void _float();
+            void _threads();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
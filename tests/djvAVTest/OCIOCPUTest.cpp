@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/OCIOCPUTest.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/OCIOCPU.h>
+#include <djvAV/OCIOSystem.h>
+#include <djvAV/OpenGLOffscreenBuffer.h>
+#include <djvAV/Render2D.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/ThreadPool.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        OCIOCPUTest::OCIOCPUTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::OCIOCPUTest", context)
+        {}
+
+        void OCIOCPUTest::run()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto ocioSystem = context->getSystemT<OCIO::System>();
+                DJV_ASSERT(ocioSystem->addConfig("nuke-default") >= 0);
+                _processor();
+                _render();
+            }
+        }
+
+        namespace
+        {
+            const OCIO::Convert convert("linear", "sRGB");
+
+            //! Create an image with values that only change horizontally, so
+            //! that it can be compared with the OpenGL results regardless of
+            //! the vertical orientation. The values go above one to test the
+            //! allocation of the input color space.
+            std::shared_ptr<Image::Image> createImage(const Image::Size& size)
+            {
+                auto out = Image::Image::create(Image::Info(size, Image::Type::RGB_F32));
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    auto p = reinterpret_cast<float*>(out->getData(y));
+                    for (uint16_t x = 0; x < size.w; ++x, p += 3)
+                    {
+                        const float v = x / static_cast<float>(size.w - 1);
+                        p[0] = v * 4.F;
+                        p[1] = 1.F - v;
+                        p[2] = (x % 8) / 8.F;
+                    }
+                }
+                return out;
+            }
+
+            float getMaxDiff(const Image::Data& a, const Image::Data& b)
+            {
+                float out = 0.F;
+                const size_t channelCount = Image::getChannelCount(a.getType());
+                for (uint16_t y = 0; y < a.getHeight(); ++y)
+                {
+                    auto aP = reinterpret_cast<const float*>(a.getData(y));
+                    auto bP = reinterpret_cast<const float*>(b.getData(y));
+                    for (size_t i = 0; i < a.getWidth() * channelCount; ++i)
+                    {
+                        out = std::max(out, std::abs(aP[i] - bP[i]));
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        void OCIOCPUTest::_processor()
+        {
+            auto image = createImage(Image::Size(256, 200));
+            const auto& info = image->getInfo();
+            auto threadPool = ThreadPool::create(4);
+
+            auto processor = OCIO::CPUProcessor::create(convert, OCIO::CPUMethod::Processor);
+            DJV_ASSERT(convert == processor->getConvert());
+            DJV_ASSERT(OCIO::CPUMethod::Processor == processor->getMethod());
+            auto processorImage = Image::Image::create(info);
+            processor->apply(*image, *processorImage);
+
+            auto lut = OCIO::CPUProcessor::create(convert, OCIO::CPUMethod::LUT, OCIO::lutSizeDefault, threadPool);
+            DJV_ASSERT(OCIO::lutSizeDefault == lut->getLUTSize());
+            auto lutImage = Image::Image::create(info);
+            lut->apply(*image, *lutImage);
+            const float diff = getMaxDiff(*processorImage, *lutImage);
+            {
+                std::stringstream ss;
+                ss << "processor/LUT max difference: " << diff;
+                _print(ss.str());
+            }
+            DJV_ASSERT(diff < .02F);
+
+            {
+                // The results should not depend on the thread pool.
+                auto lut2 = OCIO::CPUProcessor::create(convert, OCIO::CPUMethod::LUT);
+                auto lutImage2 = Image::Image::create(info);
+                lut2->apply(*image, *lutImage2);
+                DJV_ASSERT(0.F == getMaxDiff(*lutImage, *lutImage2));
+            }
+
+            {
+                // Convert values in place, the fourth channel should be
+                // passed through.
+                const float* imageP = reinterpret_cast<const float*>(image->getData(0));
+                const float* lutP = reinterpret_cast<const float*>(lutImage->getData(0));
+                float values[] = { imageP[0], imageP[1], imageP[2], .5F };
+                lut->apply(values, 1, 4);
+                DJV_ASSERT(values[0] == lutP[0]);
+                DJV_ASSERT(values[1] == lutP[1]);
+                DJV_ASSERT(values[2] == lutP[2]);
+                DJV_ASSERT(.5F == values[3]);
+            }
+
+            {
+                // Convert to a different output type.
+                auto lutImage2 = Image::Image::create(Image::Info(info.size, Image::Type::RGBA_U8));
+                lut->apply(*image, *lutImage2);
+                const float* lutP = reinterpret_cast<const float*>(lutImage->getData(0));
+                const Image::U8_T* lutP2 = reinterpret_cast<const Image::U8_T*>(lutImage2->getData(0));
+                DJV_ASSERT(std::abs(lutP[1] - lutP2[1] / 255.F) < 1.F / 255.F + .001F);
+                DJV_ASSERT(255 == lutP2[3]);
+            }
+
+            {
+                std::stringstream ss;
+                ss << OCIO::CPUMethod::LUT;
+                std::stringstream ss2;
+                ss2 << "method string: " << _getText(ss.str());
+                _print(ss2.str());
+            }
+        }
+
+        void OCIOCPUTest::_render()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto image = createImage(Image::Size(256, 4));
+                const auto& info = image->getInfo();
+                auto lut = OCIO::CPUProcessor::create(convert);
+                auto lutImage = Image::Image::create(info);
+                lut->apply(*image, *lutImage);
+
+                // Draw the image with the color space conversion, waiting for
+                // the lookup table to be prepared in the background.
+                auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(info.size, Image::Type::RGBA_F32);
+                offscreenBuffer->bind();
+                auto render = context->getSystemT<AV::Render2D::Render>();
+                Render2D::ImageOptions options;
+                options.colorSpace = convert;
+                options.cache = Render2D::ImageCache::Dynamic;
+                for (size_t i = 0; i < 1000; ++i)
+                {
+                    render->beginFrame(info.size);
+                    render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                    render->endFrame();
+                    if (!render->hasPendingColorSpaces())
+                    {
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                render->beginFrame(info.size);
+                render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                render->endFrame();
+                auto renderImage = Image::Image::create(Image::Info(info.size, Image::Type::RGBA_F32));
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glReadPixels(0, 0, info.size.w, info.size.h, GL_RGBA, GL_FLOAT, renderImage->getData());
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+                float diff = 0.F;
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    auto lutP = reinterpret_cast<const float*>(lutImage->getData(y));
+                    auto renderP = reinterpret_cast<const float*>(renderImage->getData(y));
+                    for (uint16_t x = 0; x < info.size.w; ++x, lutP += 3, renderP += 4)
+                    {
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            diff = std::max(diff, std::abs(lutP[c] - renderP[c]));
+                        }
+                    }
+                }
+                {
+                    std::stringstream ss;
+                    ss << "OpenGL/LUT max difference: " << diff;
+                    _print(ss.str());
+                }
+                DJV_ASSERT(diff < .01F);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
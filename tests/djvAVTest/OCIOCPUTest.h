@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class OCIOCPUTest : public Test::ITest
+        {
+        public:
+            OCIOCPUTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _processor();
+            void _render();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -5,6 +5,12 @@
 #include <djvAVTest/OCIOTest.h>
 
 #include <djvAV/OCIO.h>
+#include <djvAV/OCIOLUT.h>
+
+#include <djvCore/FileInfo.h>
+#include <djvCore/Path.h>
+
+#include <cstdio>
 
 using namespace djv::Core;
 using namespace djv::AV;
@@ -22,6 +28,7 @@ namespace djv
             _convert();
             _view();
             _display();
+            _lut();
             _operators();
         }
 
@@ -64,12 +71,92 @@ namespace djv
             }
         }
         
+        void OCIOTest::_lut()
+        {
+            {
+                const OCIO::Convert convert("input", "output");
+                const std::string key = OCIO::getLUTKey("config", convert, 2);
+                DJV_ASSERT(key == OCIO::getLUTKey("config", convert, 2));
+                DJV_ASSERT(key != OCIO::getLUTKey("config", convert, 4));
+                DJV_ASSERT(key != OCIO::getLUTKey("config2", convert, 2));
+                DJV_ASSERT(OCIO::getLUTFileName(key) == OCIO::getLUTFileName(key));
+            }
+
+            {
+                OCIO::LUT lut;
+                lut.configID = "config";
+                lut.convert = OCIO::Convert("input", "output");
+                lut.size = 2;
+                lut.shaderSource = "shaderSource";
+                lut.data.resize(3 * 2 * 2 * 2);
+                for (size_t i = 0; i < lut.data.size(); ++i)
+                {
+                    lut.data[i] = i / static_cast<float>(lut.data.size());
+                }
+                const std::string key = OCIO::getLUTKey(lut.configID, lut.convert, lut.size);
+                const std::string fileName = FileSystem::Path(
+                    FileSystem::Path::getTemp(),
+                    OCIO::getLUTFileName(key)).get();
+                OCIO::writeLUT(fileName, key, lut);
+
+                auto lut2 = OCIO::readLUT(fileName, key);
+                DJV_ASSERT(lut2);
+                DJV_ASSERT(lut.configID == lut2->configID);
+                DJV_ASSERT(lut.convert == lut2->convert);
+                DJV_ASSERT(lut.size == lut2->size);
+                DJV_ASSERT(lut.shaderSource == lut2->shaderSource);
+                DJV_ASSERT(lut.data == lut2->data);
+
+                DJV_ASSERT(!OCIO::readLUT(fileName, OCIO::getLUTKey("config2", lut.convert, lut.size)));
+                std::remove(fileName.c_str());
+                DJV_ASSERT(!OCIO::readLUT(fileName, key));
+            }
+
+            {
+                const FileSystem::Path path(FileSystem::Path::getTemp(), "OCIOTest_lutCache");
+                if (!FileSystem::FileInfo(path).doesExist())
+                {
+                    FileSystem::Path::mkdir(path);
+                }
+                OCIO::LUT lut;
+                lut.configID = "config";
+                lut.size = 2;
+                lut.data.resize(3 * 2 * 2 * 2);
+                std::vector<std::string> fileNames;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    lut.convert = OCIO::Convert("input", std::to_string(i));
+                    const std::string key = OCIO::getLUTKey(lut.configID, lut.convert, lut.size);
+                    fileNames.push_back(FileSystem::Path(path, OCIO::getLUTFileName(key)).get());
+                    OCIO::writeLUT(fileNames.back(), key, lut);
+                }
+                auto getFileCount = [fileNames]
+                {
+                    size_t out = 0;
+                    for (const auto& i : fileNames)
+                    {
+                        out += FileSystem::FileInfo(i).doesExist() ? 1 : 0;
+                    }
+                    return out;
+                };
+                const uint64_t fileSize = FileSystem::FileInfo(fileNames[0]).getSize();
+                OCIO::pruneLUTCache(path.get(), 3 * fileSize);
+                DJV_ASSERT(3 == getFileCount());
+                OCIO::pruneLUTCache(path.get(), 2 * fileSize);
+                DJV_ASSERT(2 == getFileCount());
+                OCIO::pruneLUTCache(path.get(), 0);
+                DJV_ASSERT(0 == getFileCount());
+                FileSystem::Path::rmdir(path);
+            }
+        }
+
         void OCIOTest::_operators()
         {
             {
                 const OCIO::Convert convert("input", "output");
                 DJV_ASSERT(convert == convert);
                 DJV_ASSERT(OCIO::Convert() < convert);
+                DJV_ASSERT(std::hash<OCIO::Convert>()(convert) == std::hash<OCIO::Convert>()(convert));
             }
             
             {
@@ -19,6 +19,7 @@ namespace djv
             void _convert();
             void _view();
             void _display();
+            void _lut();
             void _operators();
         };
         
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/OpenEXRTest.h>
+
+#include <djvAV/IO.h>
+#if defined(OPENEXR_FOUND)
+#include <djvAV/OpenEXR.h>
+#endif // OPENEXR_FOUND
+
+#include <djvCore/Context.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Timer.h>
+
+#include <cmath>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        OpenEXRTest::OpenEXRTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::OpenEXRTest", context)
+        {}
+        
+        void OpenEXRTest::run()
+        {
+#if defined(OPENEXR_FOUND)
+            if (auto context = getContext().lock())
+            {
+                // Write an image with each compression type as scanlines and
+                // tiles, read it back, and compare the pixels. The lossy
+                // compression types are compared with a tolerance.
+                const Image::Info imageInfo(67, 45, Image::Type::RGBA_F16);
+                auto image = Image::Image::create(imageInfo);
+                for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                {
+                    Image::F16_T* p = reinterpret_cast<Image::F16_T*>(image->getData(y));
+                    for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += 4)
+                    {
+                        p[0] = x / static_cast<float>(imageInfo.size.w);
+                        p[1] = y / static_cast<float>(imageInfo.size.h);
+                        p[2] = .5F;
+                        p[3] = 1.F;
+                    }
+                }
+
+                auto io = context->getSystemT<IO::System>();
+                const auto optionsJSON = io->getOptions(IO::OpenEXR::pluginName);
+                for (const auto compression : IO::OpenEXR::getCompressionEnums())
+                {
+                    for (const bool tiled : { false, true })
+                    {
+                        IO::OpenEXR::Options options;
+                        fromJSON(optionsJSON, options);
+                        options.compression = compression;
+                        options.tiled = tiled;
+                        options.tileSize = 32;
+                        io->setOptions(IO::OpenEXR::pluginName, toJSON(options));
+
+                        std::stringstream ss;
+                        ss << "OpenEXRTest_" << compression << "_" << (tiled ? "tiled" : "scanline") << ".exr";
+                        _print(ss.str());
+                        const FileSystem::FileInfo fileInfo(ss.str());
+                        {
+                            IO::Info info;
+                            info.video.push_back(imageInfo);
+                            auto write = io->write(fileInfo, info);
+                            {
+                                std::lock_guard<std::mutex> lock(write->getMutex());
+                                auto& writeQueue = write->getVideoQueue();
+                                writeQueue.addFrame(IO::VideoFrame(0, image));
+                                writeQueue.setFinished(true);
+                            }
+                            while (write->isRunning())
+                            {}
+                        }
+                        DJV_ASSERT(fileInfo.doesExist());
+
+                        auto read = io->read(fileInfo);
+                        DJV_ASSERT(!read->hasProxy());
+                        DJV_ASSERT(0 == read->getProxy(IO::proxyMax));
+                        std::shared_ptr<Image::Image> readImage;
+                        while (!readImage)
+                        {
+                            {
+                                std::lock_guard<std::mutex> lock(read->getMutex());
+                                auto& readQueue = read->getVideoQueue();
+                                if (!readQueue.isEmpty())
+                                {
+                                    readImage = readQueue.popFrame().image;
+                                }
+                            }
+                            std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                        }
+                        DJV_ASSERT(imageInfo.size == readImage->getSize());
+                        DJV_ASSERT(imageInfo.type == readImage->getType());
+
+                        float tolerance = 0.F;
+                        switch (compression)
+                        {
+                        case IO::OpenEXR::Compression::B44:
+                        case IO::OpenEXR::Compression::B44A:
+                        case IO::OpenEXR::Compression::DWAA:
+                        case IO::OpenEXR::Compression::DWAB: tolerance = .1F; break;
+                        default: break;
+                        }
+                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        {
+                            const Image::F16_T* a = reinterpret_cast<const Image::F16_T*>(image->getData(y));
+                            const Image::F16_T* b = reinterpret_cast<const Image::F16_T*>(readImage->getData(y));
+                            for (uint16_t x = 0; x < imageInfo.size.w * 4; ++x)
+                            {
+                                DJV_ASSERT(std::abs(static_cast<float>(a[x]) - static_cast<float>(b[x])) <= tolerance);
+                            }
+                        }
+                    }
+                }
+                io->setOptions(IO::OpenEXR::pluginName, optionsJSON);
+            }
+#endif // OPENEXR_FOUND
+        }
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class OpenEXRTest : public Test::ITest
+        {
+        public:
+            OpenEXRTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        };
+        
+    } // namespace AVTest
+} // namespace djv
@@ -8,11 +8,14 @@
 #include <djvAV/FontSystem.h>
 #include <djvAV/OCIO.h>
 #include <djvAV/OpenGLOffscreenBuffer.h>
+#include <djvAV/OpenGLTextureStream.h>
 #include <djvAV/Render2D.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/Timer.h>
 
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -28,6 +31,8 @@ namespace djv
         {
             _operators();
             _system();
+            _textureCache();
+            _textureStream();
         }
         
         void Render2DTest::_system()
@@ -112,6 +117,144 @@ namespace djv
             }
         }
 
+        void Render2DTest::_textureCache()
+        {
+            if (auto context = getContext().lock())
+            {
+                const Image::Size size(1280, 720);
+                auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(size, AV::Image::Type::RGBA_U8);
+                offscreenBuffer->bind();
+                auto render = context->getSystemT<AV::Render2D::Render>();
+                auto image = Image::Image::create(Image::Info(64, 64, AV::Image::Type::RGBA_U8));
+                image->zero();
+                Render2D::ImageOptions options;
+                options.cache = Render2D::ImageCache::Dynamic;
+
+                const size_t hits = render->getDynamicTextureHits();
+                const size_t misses = render->getDynamicTextureMisses();
+                const uint64_t uploadByteCount = render->getDynamicTextureUploadByteCount();
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    render->beginFrame(size);
+                    render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                    render->endFrame();
+                }
+                DJV_ASSERT(render->getDynamicTextureMisses() == misses + 1);
+                DJV_ASSERT(render->getDynamicTextureHits() == hits + 1);
+                DJV_ASSERT(render->getDynamicTextureUploadByteCount() == uploadByteCount + image->getDataByteCount());
+                DJV_ASSERT(render->getDynamicTextureByteCount() >= image->getDataByteCount());
+
+                const size_t textureCacheSize = render->getTextureCacheSize();
+                render->setTextureCacheSize(0);
+                render->beginFrame(size);
+                render->endFrame();
+                DJV_ASSERT(0 == render->getDynamicTextureCount());
+                DJV_ASSERT(0 == render->getDynamicTextureByteCount());
+                render->setTextureCacheSize(textureCacheSize);
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+                {
+                    std::stringstream ss;
+                    ss << "dynamic texture hits: " << render->getDynamicTextureHits();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "dynamic texture misses: " << render->getDynamicTextureMisses();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "dynamic texture upload byte count: " << render->getDynamicTextureUploadByteCount();
+                    _print(ss.str());
+                }
+            }
+        }
+
+        void Render2DTest::_textureStream()
+        {
+#if !defined(DJV_OPENGL_ES2)
+            if (auto context = getContext().lock())
+            {
+                const Image::Size size(64, 64);
+                auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(size, AV::Image::Type::RGBA_U8);
+                offscreenBuffer->bind();
+
+                const Image::Info info(67, 45, AV::Image::Type::RGBA_U8);
+                std::vector<std::shared_ptr<Image::Image> > images;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    auto image = Image::Image::create(info);
+                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    {
+                        uint8_t* p = image->getData(y);
+                        for (uint16_t x = 0; x < info.size.w; ++x, p += 4)
+                        {
+                            p[0] = static_cast<uint8_t>(x);
+                            p[1] = static_cast<uint8_t>(y);
+                            p[2] = static_cast<uint8_t>(i);
+                            p[3] = 255;
+                        }
+                    }
+                    images.push_back(image);
+                }
+                auto readPixels = [info](const std::shared_ptr<OpenGL::Texture>& texture)
+                {
+                    auto out = Image::Image::create(info);
+                    texture->bind();
+                    glPixelStorei(GL_PACK_ALIGNMENT, info.layout.alignment);
+                    glGetTexImage(GL_TEXTURE_2D, 0, info.getGLFormat(), info.getGLType(), out->getData());
+                    return out;
+                };
+
+                OpenGL::TextureStream textureStream(2);
+                DJV_ASSERT(2 == textureStream.getBufferCount());
+                DJV_ASSERT(0 == textureStream.getBusyCount());
+
+                // Stage an image and wait for the upload to complete.
+                {
+                    auto texture = OpenGL::Texture::create(info);
+                    DJV_ASSERT(textureStream.stage(images[0], texture));
+                    DJV_ASSERT(textureStream.isStaged(images[0]->getUID()));
+                    std::shared_ptr<OpenGL::Texture> uploaded;
+                    while (!uploaded)
+                    {
+                        for (const auto& i : textureStream.update())
+                        {
+                            DJV_ASSERT(images[0]->getUID() == i.first);
+                            uploaded = i.second;
+                        }
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                    DJV_ASSERT(texture == uploaded);
+                    DJV_ASSERT(!textureStream.isStaged(images[0]->getUID()));
+                    DJV_ASSERT(*readPixels(uploaded) == *images[0]);
+                }
+
+                // Stage an image and finish the upload immediately.
+                {
+                    auto texture = OpenGL::Texture::create(info);
+                    DJV_ASSERT(textureStream.stage(images[1], texture));
+                    auto finished = textureStream.finish(images[1]->getUID());
+                    DJV_ASSERT(texture == finished);
+                    DJV_ASSERT(*readPixels(finished) == *images[1]);
+                    DJV_ASSERT(!textureStream.finish(images[1]->getUID()));
+                }
+
+                // Cancel the uploads.
+                {
+                    DJV_ASSERT(textureStream.stage(images[2], OpenGL::Texture::create(info)));
+                    textureStream.update();
+                    textureStream.clear();
+                    DJV_ASSERT(0 == textureStream.getBusyCount());
+                    DJV_ASSERT(!textureStream.isStaged(images[2]->getUID()));
+                }
+
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            }
+#endif // DJV_OPENGL_ES2
+        }
+
         void Render2DTest::_operators()
         {
             {
@@ -17,6 +17,8 @@ namespace djv
             
         private:
             void _system();
+            void _textureCache();
+            void _textureStream();
             void _operators();
         };
         
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ThumbnailCacheTest.h>
+
+#include <djvAV/Image.h>
+#include <djvAV/ThumbnailCache.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ThumbnailCacheTest::ThumbnailCacheTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ThumbnailCacheTest", context)
+        {}
+        
+        void ThumbnailCacheTest::run()
+        {
+            const FileSystem::Path path("ThumbnailCacheTest");
+            const FileSystem::Path fileName("ThumbnailCacheTest.txt");
+            FileSystem::FileIO::writeLines(fileName.get(), { "a" });
+            const FileSystem::FileInfo fileInfo(fileName);
+            const Image::Size size(2, 3);
+            const Image::Type type = Image::Type::RGBA_U8;
+            auto image = Image::Image::create(Image::Info(size, type));
+            for (size_t i = 0; i < image->getDataByteCount(); ++i)
+            {
+                image->getData()[i] = static_cast<uint8_t>(i);
+            }
+            image->setPluginName("PPM");
+
+            {
+                auto cache = ThumbnailCache::create(path, Memory::megabyte);
+                cache->clear();
+                DJV_ASSERT(path == cache->getPath());
+                DJV_ASSERT(Memory::megabyte == cache->getMaxByteCount());
+                DJV_ASSERT(!cache->get(fileInfo, size, type));
+
+                cache->add(fileInfo, size, type, image);
+                DJV_ASSERT(1 == cache->getCount());
+                DJV_ASSERT(cache->getByteCount() > image->getDataByteCount());
+                auto cached = cache->get(fileInfo, size, type);
+                DJV_ASSERT(cached);
+                DJV_ASSERT(image->getInfo() == cached->getInfo());
+                DJV_ASSERT(0 == memcmp(image->getData(), cached->getData(), image->getDataByteCount()));
+                DJV_ASSERT("PPM" == cached->getPluginName());
+
+                // Thumbnails are keyed by the size, type, and options.
+                DJV_ASSERT(!cache->get(fileInfo, Image::Size(3, 2), type));
+                DJV_ASSERT(!cache->get(fileInfo, size, Image::Type::RGB_U8));
+                DJV_ASSERT(!cache->get(fileInfo, size, type, 1));
+            }
+
+            {
+                // The index is written as thumbnails are added, so it is not
+                // lost if the cache is not destroyed.
+                auto cache = ThumbnailCache::create(path, Memory::megabyte);
+                cache->clear();
+                cache->add(fileInfo, size, type, image);
+                auto cache2 = ThumbnailCache::create(path, Memory::megabyte);
+                DJV_ASSERT(1 == cache2->getCount());
+                DJV_ASSERT(cache2->get(fileInfo, size, type));
+            }
+
+            {
+                // The index is written when the cache is destroyed.
+                auto cache = ThumbnailCache::create(path, Memory::megabyte);
+                DJV_ASSERT(1 == cache->getCount());
+                DJV_ASSERT(cache->get(fileInfo, size, type));
+
+                // Modifying the file invalidates the thumbnail.
+                FileSystem::FileIO::writeLines(fileName.get(), { "a", "b" });
+                DJV_ASSERT(!cache->get(FileSystem::FileInfo(fileName), size, type));
+            }
+
+            {
+                // The least recently used thumbnails are removed.
+                auto cache = ThumbnailCache::create(path, Memory::megabyte);
+                cache->clear();
+                DJV_ASSERT(0 == cache->getCount());
+                DJV_ASSERT(0 == cache->getByteCount());
+                cache->add(fileInfo, size, type, image);
+                const size_t byteCount = cache->getByteCount();
+                cache->setMaxByteCount(byteCount * 2);
+                cache->add(fileInfo, size, type, image, 1);
+                DJV_ASSERT(cache->get(fileInfo, size, type));
+                cache->add(fileInfo, size, type, image, 2);
+                DJV_ASSERT(2 == cache->getCount());
+                DJV_ASSERT(cache->get(fileInfo, size, type));
+                DJV_ASSERT(!cache->get(fileInfo, size, type, 1));
+                DJV_ASSERT(cache->get(fileInfo, size, type, 2));
+
+                cache->setMaxByteCount(0);
+                DJV_ASSERT(0 == cache->getCount());
+                DJV_ASSERT(0 == cache->getByteCount());
+            }
+
+            {
+                // Temporary files and thumbnails that are not in the index are
+                // removed when the cache is created.
+                {
+                    auto cache = ThumbnailCache::create(path, Memory::megabyte);
+                    cache->clear();
+                    cache->add(fileInfo, size, type, image);
+                }
+                const FileSystem::Path orphanPath(path, "0123456789abcdef.thumb");
+                const FileSystem::Path tmpPath(path, "0123456789abcdef.thumb.0.tmp");
+                FileSystem::FileIO::writeLines(orphanPath.get(), { "a" });
+                FileSystem::FileIO::writeLines(tmpPath.get(), { "a" });
+                auto cache = ThumbnailCache::create(path, Memory::megabyte);
+                DJV_ASSERT(!FileSystem::FileInfo(orphanPath).doesExist());
+                DJV_ASSERT(!FileSystem::FileInfo(tmpPath).doesExist());
+                DJV_ASSERT(1 == cache->getCount());
+                DJV_ASSERT(cache->get(fileInfo, size, type));
+                cache->clear();
+            }
+
+            FileSystem::Path::rm(FileSystem::Path(path, "index.txt"));
+            FileSystem::Path::rmdir(path);
+            FileSystem::Path::rm(fileName);
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
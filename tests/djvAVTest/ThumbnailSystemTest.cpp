@@ -31,8 +31,15 @@ namespace djv
                     resourceSystem->getPath(FileSystem::ResourcePath::Icons),
                     "96DPI/djvIconFile.png"));
                 auto system = context->getSystemT<ThumbnailSystem>();
+                {
+                    std::stringstream ss;
+                    ss << "thread count: " << system->getThreadCount();
+                    _print(ss.str());
+                }
+                DJV_ASSERT(system->getThreadCount() > 0);
                 auto infoFuture = system->getInfo(fileInfo);
                 auto imageFuture = system->getImage(fileInfo, Image::Size(32, 32));
+                auto imagePriorityFuture = system->getImage(fileInfo, Image::Size(16, 16), Image::Type::RGBA_U8, 1);
                 
                 auto infoCancelFuture = system->getInfo(fileInfo);
                 auto imageCancelFuture = system->getImage(fileInfo, Image::Size(32, 32));
@@ -41,9 +48,11 @@ namespace djv
                 
                 IO::Info info;
                 std::shared_ptr<Image::Image> image;
+                std::shared_ptr<Image::Image> imagePriority;
                 while (
                     infoFuture.future.valid() ||
-                    imageFuture.future.valid())
+                    imageFuture.future.valid() ||
+                    imagePriorityFuture.future.valid())
                 {
                     _tickFor(Time::getTime(Time::TimerValue::Fast));
                     if (infoFuture.future.valid() &&
@@ -56,6 +65,11 @@ namespace djv
                     {
                         image = imageFuture.future.get();
                     }
+                    if (imagePriorityFuture.future.valid() &&
+                        imagePriorityFuture.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        imagePriority = imagePriorityFuture.future.get();
+                    }
                 }
                 
                 if (info.video.size())
@@ -70,6 +84,10 @@ namespace djv
                     ss << "image: " << image->getSize();
                     _print(ss.str());
                 }
+                if (imagePriority)
+                {
+                    DJV_ASSERT(Image::Type::RGBA_U8 == imagePriority->getType());
+                }
                 
                 {
                     std::stringstream ss;
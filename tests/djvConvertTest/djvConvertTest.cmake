@@ -0,0 +1,19 @@
+# Convert an image with no display available to check that djv_convert does
+# not require OpenGL.
+unset(ENV{DISPLAY})
+unset(ENV{WAYLAND_DISPLAY})
+
+set(input ${WORKING_DIRECTORY}/djvConvertTestInput.ppm)
+set(output ${WORKING_DIRECTORY}/djvConvertTestOutput.ppm)
+file(REMOVE ${output})
+file(WRITE ${input} "P3\n2 2\n255\n255 0 0 0 255 0\n0 0 255 255 255 255\n")
+
+execute_process(
+    COMMAND ${DJV_CONVERT} ${input} ${output} -resize "4 4"
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "djv_convert failed: ${result}")
+endif()
+if(NOT EXISTS ${output})
+    message(FATAL_ERROR "djv_convert did not write the output: ${output}")
+endif()
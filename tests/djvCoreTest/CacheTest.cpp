@@ -17,6 +17,12 @@ namespace djv
         {}
         
         void CacheTest::run()
+        {
+            _cache();
+            _cost();
+        }
+
+        void CacheTest::_cache()
         {
             {
                 Memory::Cache<int, std::string> cache;
@@ -35,14 +41,58 @@ namespace djv
                 cache.add(1, "a");
                 cache.add(2, "b");
                 cache.add(3, "c");
+                DJV_ASSERT(!cache.contains(1));
                 std::string value;
                 cache.get(2, value);
                 DJV_ASSERT(value == "b");
-                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
-                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "b", "c" }));
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 3, 2 }));
+                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "c", "b" }));
+                cache.add(4, "d");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 4 }));
+            }
+
+            {
+                Memory::Cache<int, std::string> cache;
+                cache.add(1, "a");
+                cache.add(2, "b");
+                cache.add(1, "c");
+                DJV_ASSERT(2 == cache.getSize());
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 1 }));
+                std::string value;
+                DJV_ASSERT(cache.get(1, value));
+                DJV_ASSERT("c" == value);
+                cache.remove(1);
+                DJV_ASSERT(!cache.contains(1));
+                DJV_ASSERT(1 == cache.getSize());
+                cache.clear();
+                DJV_ASSERT(0 == cache.getSize());
+                DJV_ASSERT(cache.getKeys().empty());
             }
         }
-        
+
+        void CacheTest::_cost()
+        {
+            Memory::Cache<int, std::string> cache;
+            cache.setMax(100);
+            cache.add(1, "a", 50);
+            cache.add(2, "b", 25);
+            DJV_ASSERT(75 == cache.getCost());
+            DJV_ASSERT(75.F == cache.getPercentageUsed());
+            cache.add(3, "c", 50);
+            DJV_ASSERT(!cache.contains(1));
+            DJV_ASSERT(75 == cache.getCost());
+            cache.add(2, "b", 10);
+            DJV_ASSERT(60 == cache.getCost());
+            cache.setMax(40);
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2 }));
+            DJV_ASSERT(10 == cache.getCost());
+            cache.add(4, "d", 100);
+            DJV_ASSERT(0 == cache.getSize());
+            DJV_ASSERT(0 == cache.getCost());
+            cache.add(5, "e", 10);
+            cache.remove(5);
+            DJV_ASSERT(0 == cache.getCost());
+        }
+
     } // namespace CoreTest
 } // namespace djv
-
@@ -16,6 +16,10 @@ namespace djv
             CacheTest(const std::shared_ptr<Core::Context>&);
             
             void run() override;
+
+        private:
+            void _cache();
+            void _cost();
         };
         
     } // namespace CoreTest
@@ -27,6 +27,7 @@ namespace djv
             _error();
             _endian();
             _temp();
+            _mmap();
         }
 
         void FileIOTest::_io()
@@ -238,7 +239,29 @@ namespace djv
                 io->writeU8(i);
             }
         }
-        
+
+        void FileIOTest::_mmap()
+        {
+            // Memory mapped files are closed after they are mapped, but they
+            // are still open for reading.
+            FileSystem::FileIO::writeLines(_fileName, { _text });
+            auto io = FileSystem::FileIO::create();
+            io->open(_fileName, FileSystem::FileIO::Mode::Read);
+            DJV_ASSERT(io->isOpen());
+            DJV_ASSERT(0 == io->getPos());
+            DJV_ASSERT(!io->isEOF());
+#if defined(DJV_MMAP)
+            DJV_ASSERT(io->mmapP());
+#endif // DJV_MMAP
+            std::string buf(_text.size(), 0);
+            io->read(&buf[0], buf.size());
+            DJV_ASSERT(_text == buf);
+            DJV_ASSERT(_text.size() == io->getPos());
+            DJV_ASSERT(io->isOpen());
+            io->close();
+            DJV_ASSERT(!io->isOpen());
+        }
+
     } // namespace CoreTest
 } // namespace djv
 
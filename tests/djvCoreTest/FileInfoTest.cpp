@@ -233,6 +233,19 @@ namespace djv
                     FileSystem::FileInfo::directoryList(FileSystem::Path("."), i);
                 }
             }
+
+            {
+                // The size and time are only available when stat is requested.
+                FileSystem::FileIO::writeLines(_fileName, { "stat" });
+                FileSystem::DirectoryListOptions options;
+                options.filter = "^" + _fileName + "$";
+                options.stat = true;
+                const auto list = FileSystem::FileInfo::directoryList(FileSystem::Path("."), options);
+                DJV_ASSERT(1 == list.size());
+                DJV_ASSERT(list[0].getSize() > 0);
+                DJV_ASSERT(list[0].getTime() > 0);
+                DJV_ASSERT(list[0].getPermissions() != 0);
+            }
             
             {
                 const FileSystem::Path path = FileSystem::Path(".");
@@ -261,6 +274,79 @@ namespace djv
                 const FileSystem::FileInfo fileInfo = FileSystem::FileInfo::getFileSequence(path, {});
                 DJV_ASSERT(fileInfo.getPath() == path);
             }
+
+            {
+                std::vector<FileSystem::FileInfo> fileInfos;
+                for (const auto& i : {
+                    "render.0003.exr",
+                    "render.0001.exr",
+                    "comp.10.exr",
+                    "render.0002.exr",
+                    "render.0010.exr",
+                    "comp.9.exr",
+                    "render.0002.EXR",
+                    "render.0004.tif",
+                    "readme.txt" })
+                {
+                    fileInfos.push_back(FileSystem::FileInfo(FileSystem::Path(i), false));
+                }
+                FileSystem::DirectoryListOptions options;
+                options.fileSequences = true;
+                options.fileSequenceExtensions = { ".exr" };
+                const auto out = FileSystem::FileInfo::groupFileSequences(fileInfos, options);
+                std::vector<std::string> fileNames;
+                for (const auto& i : out)
+                {
+                    fileNames.push_back(i.getFileName(Frame::invalid, false));
+                }
+                DJV_ASSERT(std::vector<std::string>({
+                    "render.0001-0003,0010.exr",
+                    "comp.9-10.exr",
+                    "render.0002.EXR",
+                    "render.0004.tif",
+                    "readme.txt" }) == fileNames);
+                DJV_ASSERT(FileSystem::FileType::Sequence == out[0].getType());
+                DJV_ASSERT(FileSystem::FileType::File == out[3].getType());
+
+                options.fileSequences = false;
+                DJV_ASSERT(FileSystem::FileInfo::groupFileSequences(fileInfos, options).size() == fileInfos.size());
+            }
+
+            {
+                const FileSystem::DirectoryListMatcher matcher;
+                DJV_ASSERT(matcher.match("render.exr"));
+            }
+
+            {
+                FileSystem::DirectoryListOptions options;
+                options.fileExtensions = { ".exr", ".TIF", ".tar.gz" };
+                const FileSystem::DirectoryListMatcher matcher(options);
+                DJV_ASSERT(matcher.matchExtension("render.0001.exr"));
+                DJV_ASSERT(matcher.matchExtension("render.0001.EXR"));
+                DJV_ASSERT(matcher.matchExtension("render.tif"));
+                DJV_ASSERT(matcher.matchExtension("archive.tar.gz"));
+                DJV_ASSERT(!matcher.matchExtension("render.exr.txt"));
+                DJV_ASSERT(!matcher.matchExtension("exr"));
+                DJV_ASSERT(matcher.matchFilter("readme.txt"));
+            }
+
+            {
+                FileSystem::DirectoryListOptions options;
+                options.filter = "Render";
+                const FileSystem::DirectoryListMatcher matcher(options);
+                DJV_ASSERT(matcher.matchFilter("render.exr"));
+                DJV_ASSERT(matcher.matchFilter("comp_render.exr"));
+                DJV_ASSERT(!matcher.matchFilter("comp.exr"));
+            }
+
+            {
+                FileSystem::DirectoryListOptions options;
+                options.filter = "*.exr";
+                const FileSystem::DirectoryListMatcher matcher(options);
+                DJV_ASSERT(matcher.matchFilter("render.exr"));
+                DJV_ASSERT(!matcher.matchFilter("render.exr.txt"));
+                DJV_ASSERT(!matcher.matchFilter("renderexr"));
+            }
         }
 
         void FileInfoTest::_operators()
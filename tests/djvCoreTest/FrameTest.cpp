@@ -76,6 +76,51 @@ namespace djv
                 sequence.merge(Frame::Range(12, 100));
                 DJV_ASSERT(sequence.ranges[0] == Frame::Range(1, 10));
             }
+
+            {
+                Frame::Sequence sequence({ Frame::Range(1, 10), Frame::Range(20, 30), Frame::Range(33), Frame::Range(35) });
+                DJV_ASSERT(23 == sequence.getSize());
+                DJV_ASSERT(22 == sequence.getLastIndex());
+                DJV_ASSERT(1 == sequence.getFrame(0));
+                DJV_ASSERT(10 == sequence.getFrame(9));
+                DJV_ASSERT(20 == sequence.getFrame(10));
+                DJV_ASSERT(33 == sequence.getFrame(21));
+                DJV_ASSERT(35 == sequence.getFrame(22));
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(23));
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(-1));
+                DJV_ASSERT(10 == sequence.getIndex(20));
+                DJV_ASSERT(22 == sequence.getIndex(35));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(15));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(0));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(36));
+                DJV_ASSERT(sequence.contains(33));
+                DJV_ASSERT(!sequence.contains(34));
+
+                // The index is updated when the ranges change.
+                sequence.ranges.push_back(Frame::Range(37, 40));
+                DJV_ASSERT(27 == sequence.getSize());
+                DJV_ASSERT(40 == sequence.getFrame(26));
+                sequence.ranges.back().max = 41;
+                DJV_ASSERT(28 == sequence.getSize());
+                DJV_ASSERT(27 == sequence.getIndex(41));
+                sequence.merge(Frame::Range(11, 15));
+                DJV_ASSERT(33 == sequence.getSize());
+                DJV_ASSERT(15 == sequence.getFrame(14));
+
+                const Frame::Sequence sequence2 = sequence;
+                DJV_ASSERT(sequence2 == sequence);
+                DJV_ASSERT(sequence2.getSize() == sequence.getSize());
+            }
+
+            {
+                // Unsorted sequences keep the original behavior.
+                const Frame::Sequence sequence({ Frame::Range(20, 30), Frame::Range(1, 10) });
+                DJV_ASSERT(21 == sequence.getSize());
+                DJV_ASSERT(20 == sequence.getFrame(0));
+                DJV_ASSERT(1 == sequence.getFrame(11));
+                DJV_ASSERT(11 == sequence.getIndex(1));
+                DJV_ASSERT(sequence.contains(5));
+            }
         }
         
         void FrameTest::_util()
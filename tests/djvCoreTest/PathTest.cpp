@@ -5,6 +5,8 @@
 #include <djvCoreTest/PathTest.h>
 
 #include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
 #include <djvCore/Path.h>
 
 using namespace djv::Core;
@@ -217,6 +219,23 @@ namespace djv
                 FileSystem::Path::rmdir(path);
             }
 
+            {
+                const FileSystem::Path path("foo.txt");
+                FileSystem::FileIO::writeLines(path.get(), { "foo" });
+                DJV_ASSERT(FileSystem::FileInfo(path).doesExist());
+                FileSystem::Path::rm(path);
+                DJV_ASSERT(!FileSystem::FileInfo(path).doesExist());
+                try
+                {
+                    FileSystem::Path::rm(path);
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception & e)
+                {
+                    _print(Error::format(e));
+                }
+            }
+
             {            
                 const FileSystem::Path path("foo");
                 try
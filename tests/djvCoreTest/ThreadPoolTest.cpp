@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/ThreadPoolTest.h>
+
+#include <djvCore/ThreadPool.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        ThreadPoolTest::ThreadPoolTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::CoreTest::ThreadPoolTest", context)
+        {}
+        
+        void ThreadPoolTest::run()
+        {
+            {
+                auto threadPool = ThreadPool::create(4);
+                DJV_ASSERT(4 == threadPool->getThreadCount());
+                DJV_ASSERT(4 == threadPool->getMaxActive());
+                std::vector<std::future<int> > futures;
+                for (int i = 0; i < 100; ++i)
+                {
+                    futures.push_back(threadPool->push(
+                        [i]
+                        {
+                            return i * 2;
+                        },
+                        static_cast<ThreadPool::Priority>(i % static_cast<int>(ThreadPool::Priority::Count))));
+                }
+                int sum = 0;
+                for (auto& i : futures)
+                {
+                    sum += i.get();
+                }
+                DJV_ASSERT(9900 == sum);
+
+                std::atomic<size_t> lowCalls(0);
+                threadPool->parallelFor(
+                    100,
+                    [&lowCalls](size_t)
+                    {
+                        ++lowCalls;
+                    },
+                    ThreadPool::Priority::Low);
+                DJV_ASSERT(100 == lowCalls);
+            }
+
+            {
+                auto threadPool = ThreadPool::create(4);
+                threadPool->setMaxActive(1);
+                DJV_ASSERT(1 == threadPool->getMaxActive());
+                std::atomic<int> active(0);
+                std::atomic<int> activeMax(0);
+                std::vector<std::future<void> > futures;
+                for (int i = 0; i < 20; ++i)
+                {
+                    futures.push_back(threadPool->push(
+                        [&active, &activeMax]
+                        {
+                            const int value = ++active;
+                            if (value > activeMax)
+                            {
+                                activeMax = value;
+                            }
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            --active;
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+                std::stringstream ss;
+                ss << "max active: " << activeMax;
+                _print(ss.str());
+                DJV_ASSERT(1 == activeMax);
+            }
+
+            {
+                auto threadPool = ThreadPool::create(2);
+                ThreadPool* threadPoolPtr = threadPool.get();
+                auto future = threadPool->push(
+                    [threadPoolPtr]
+                    {
+                        return threadPoolPtr->push(
+                            []
+                            {
+                                return 1;
+                            }).get() + 1;
+                    },
+                    ThreadPool::Priority::High);
+                DJV_ASSERT(2 == future.get());
+            }
+
+            {
+                auto threadPool = ThreadPool::create(4);
+                std::vector<int> values(100, 0);
+                threadPool->parallelFor(
+                    values.size(),
+                    [&values](size_t i)
+                    {
+                        values[i] = static_cast<int>(i) * 2;
+                    });
+                int sum = 0;
+                for (const auto i : values)
+                {
+                    sum += i;
+                }
+                DJV_ASSERT(9900 == sum);
+
+                size_t calls = 0;
+                threadPool->parallelFor(
+                    0,
+                    [&calls](size_t)
+                    {
+                        ++calls;
+                    });
+                DJV_ASSERT(0 == calls);
+            }
+
+            {
+                auto threadPool = ThreadPool::create(4);
+                for (const size_t index : { 0, 50, 99 })
+                {
+                    std::atomic<size_t> running(0);
+                    try
+                    {
+                        threadPool->parallelFor(
+                            100,
+                            [index, &running](size_t i)
+                            {
+                                ++running;
+                                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                                --running;
+                                if (index == i)
+                                {
+                                    throw std::runtime_error("error");
+                                }
+                            });
+                        DJV_ASSERT(false);
+                    }
+                    catch (const std::runtime_error&)
+                    {}
+                    DJV_ASSERT(0 == running);
+                }
+            }
+
+            {
+                auto threadPool = ThreadPool::create(1);
+                auto future = threadPool->push(
+                    []
+                    {
+                        throw std::runtime_error("error");
+                    });
+                try
+                {
+                    future.get();
+                    DJV_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
+
@@ -31,6 +31,7 @@
 #include <djvCoreTest/StringFormatTest.h>
 #include <djvCoreTest/StringTest.h>
 #include <djvCoreTest/TextSystemTest.h>
+#include <djvCoreTest/ThreadPoolTest.h>
 #include <djvCoreTest/TimeTest.h>
 #include <djvCoreTest/ValueObserverTest.h>
 #include <djvCoreTest/VectorTest.h>
@@ -41,14 +42,19 @@
 #include <djvAVTest/ColorTest.h>
 #include <djvAVTest/EnumTest.h>
 #include <djvAVTest/FontSystemTest.h>
+#include <djvAVTest/FrameCacheTest.h>
 #include <djvAVTest/IOTest.h>
 #include <djvAVTest/ImageConvertTest.h>
 #include <djvAVTest/ImageDataTest.h>
+#include <djvAVTest/ImageScopesTest.h>
 #include <djvAVTest/ImageTest.h>
+#include <djvAVTest/OCIOCPUTest.h>
 #include <djvAVTest/OCIOSystemTest.h>
 #include <djvAVTest/OCIOTest.h>
+#include <djvAVTest/OpenEXRTest.h>
 #include <djvAVTest/PixelTest.h>
 #include <djvAVTest/Render2DTest.h>
+#include <djvAVTest/ThumbnailCacheTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TagsTest.h>
 
@@ -103,6 +109,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::StringFormatTest(context));
         tests.emplace_back(new CoreTest::StringTest(context));
         tests.emplace_back(new CoreTest::TextSystemTest(context));
+        tests.emplace_back(new CoreTest::ThreadPoolTest(context));
         tests.emplace_back(new CoreTest::TimeTest(context));
         tests.emplace_back(new CoreTest::ValueObserverTest(context));
         tests.emplace_back(new CoreTest::VectorTest(context));
@@ -113,14 +120,19 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AVTest::ColorTest(context));
         tests.emplace_back(new AVTest::EnumTest(context));
         tests.emplace_back(new AVTest::FontSystemTest(context));
+        tests.emplace_back(new AVTest::FrameCacheTest(context));
         tests.emplace_back(new AVTest::IOTest(context));
         tests.emplace_back(new AVTest::ImageConvertTest(context));
         tests.emplace_back(new AVTest::ImageDataTest(context));
+        tests.emplace_back(new AVTest::ImageScopesTest(context));
         tests.emplace_back(new AVTest::ImageTest(context));
+        tests.emplace_back(new AVTest::OCIOCPUTest(context));
         tests.emplace_back(new AVTest::OCIOSystemTest(context));
         tests.emplace_back(new AVTest::OCIOTest(context));
+        tests.emplace_back(new AVTest::OpenEXRTest(context));
         tests.emplace_back(new AVTest::PixelTest(context));
         tests.emplace_back(new AVTest::Render2DTest(context));
+        tests.emplace_back(new AVTest::ThumbnailCacheTest(context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(context));
         tests.emplace_back(new AVTest::TagsTest(context));
 